@@ -167,6 +167,23 @@ MULTISTATE_VALUE_DESCR MSV_Descr[] =
 /* Functiondefinitions */
 /*---------------------*/
 
+// Pruefung, ob alle Instanzen vor xxx_EOT gueltig sind und der Delimiter
+// an der Stelle xxx_EOT steht. Die Objektmodule zaehlen ihre Objekte nur
+// noch einmal bei der Initialisierung und verlassen sich darauf.
+template <typename DESCR>
+static bool validDescrInstances(const DESCR *descr,
+                                uint32_t DESCR::*instance,
+                                unsigned eot)
+{
+    for (unsigned i = 0; i < eot; i++)
+    {
+        if (descr[i].*instance > BACNET_MAX_INSTANCE)
+        { return false; }
+    }
+
+    return (descr[eot].*instance > BACNET_MAX_INSTANCE);
+}
+
 // Pruefung der verwendeten Descriptions auf Vollstaendigkeit
 void validateDescrObjects()
 {
@@ -176,31 +193,38 @@ void validateDescrObjects()
          msv = true;
     
     // BACnet Binary Input Descriptions
-    if (LENGTH(BI_Descr) != bidescr_DELIMITER)
+    if ((LENGTH(BI_Descr) != bidescr_DELIMITER) ||
+        !validDescrInstances(BI_Descr, &BINARY_INPUT_DESCR::Object_Instance, bidescr_EOT))
     { validDescr = false; bi = false; }
             
     // BACnet Binary Output Descriptions
-    if (LENGTH(BO_Descr) != bodescr_DELIMITER)
+    if ((LENGTH(BO_Descr) != bodescr_DELIMITER) ||
+        !validDescrInstances(BO_Descr, &BINARY_OUTPUT_DESCR::Object_Instance, bodescr_EOT))
     { validDescr = false; bo = false; }
         
     // BACnet Binary Value Descriptions
-    if (LENGTH(BV_Descr) != bvdescr_DELIMITER)
+    if ((LENGTH(BV_Descr) != bvdescr_DELIMITER) ||
+        !validDescrInstances(BV_Descr, &BINARY_VALUE_DESCR::Object_Instance, bvdescr_EOT))
     { validDescr = false; bv = false; }
             
     // BACnet Analog Input Descriptions
-    if (LENGTH(AI_Descr) != aidescr_DELIMITER)
+    if ((LENGTH(AI_Descr) != aidescr_DELIMITER) ||
+        !validDescrInstances(AI_Descr, &ANALOG_INPUT_DESCR::object_instance, aidescr_EOT))
     { validDescr = false; ai = false; }
         
     // BACnet Analog Output Descriptions
-    if (LENGTH(AO_Descr) != aodescr_DELIMITER)
+    if ((LENGTH(AO_Descr) != aodescr_DELIMITER) ||
+        !validDescrInstances(AO_Descr, &ANALOG_OUTPUT_DESCR::Object_Instance, aodescr_EOT))
     { validDescr = false; ao = false; }
             
     // BACnet Analog Value Descriptions
-    if (LENGTH(AV_Descr) != avdescr_DELIMITER)
+    if ((LENGTH(AV_Descr) != avdescr_DELIMITER) ||
+        !validDescrInstances(AV_Descr, &ANALOG_VALUE_DESCR::Object_Instance, avdescr_EOT))
     { validDescr = false; av = false; }
             
     // BACnet MultiState Value Descriptions
-    if (LENGTH(MSV_Descr) != msvdescr_DELIMITER)
+    if ((LENGTH(MSV_Descr) != msvdescr_DELIMITER) ||
+        !validDescrInstances(MSV_Descr, &MULTISTATE_VALUE_DESCR::Object_Instance, msvdescr_EOT))
     { validDescr = false; msv = false; }
     
     
@@ -208,15 +232,15 @@ void validateDescrObjects()
     {
         printf("--INVALID Descriptor Legth(s)---\r\n");
         
-        if(!bi)  { printf("  BI_Descr[] - Invalid length\r\n"); }
-        if(!bo)  { printf("  BO_Descr[] - Invalid length\r\n"); }
-        if(!bv)  { printf("  BV_Descr[] - Invalid length\r\n"); }
+        if(!bi)  { printf("  BI_Descr[] - Invalid length or instance\r\n"); }
+        if(!bo)  { printf("  BO_Descr[] - Invalid length or instance\r\n"); }
+        if(!bv)  { printf("  BV_Descr[] - Invalid length or instance\r\n"); }
         
-        if(!ai)  { printf("  AI_Descr[] - Invalid length\r\n"); }
-        if(!ao)  { printf("  AO_Descr[] - Invalid length\r\n"); }        
-        if(!av)  { printf("  AV_Descr[] - Invalid length\r\n"); }
+        if(!ai)  { printf("  AI_Descr[] - Invalid length or instance\r\n"); }
+        if(!ao)  { printf("  AO_Descr[] - Invalid length or instance\r\n"); }        
+        if(!av)  { printf("  AV_Descr[] - Invalid length or instance\r\n"); }
         
-        if(!msv) { printf("  MSV_Descr[] - Invalid length\r\n"); }
+        if(!msv) { printf("  MSV_Descr[] - Invalid length or instance\r\n"); }
         
         error("--INVALID BACnet-Object-Descriptor Legth(s)---");
     }
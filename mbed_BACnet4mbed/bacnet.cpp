@@ -37,6 +37,8 @@
 #include "txbuf.h"
 #include "dcc.h"
 #include "iam.h"
+#include "tsm.h"
+#include "covclient.h"
 
 #include "bacnet.h"
 #include "bip.h"
@@ -51,6 +53,7 @@
 /* Global Variabels */
 /*------------------*/
 static Ticker covTick;
+static Timer msTimer;
 static Thread bacnetCbThread(osPriorityNormal, 2000, NULL, "BACnetCB_Thread");
 EventQueue bacQueue(EVENTS_QUEUE_SIZE);
 
@@ -81,14 +84,23 @@ void bacnet_init(char *ip, Thread *bacnetThread = NULL)
 														 handler_read_property_multiple);
 	apdu_set_confirmed_handler(SERVICE_CONFIRMED_WRITE_PROPERTY,
 														 handler_write_property);
+	/* provision objects at runtime */
+	apdu_set_confirmed_handler(SERVICE_CONFIRMED_CREATE_OBJECT,
+														 handler_create_object);
+	apdu_set_confirmed_handler(SERVICE_CONFIRMED_DELETE_OBJECT,
+														 handler_delete_object);
 
 	/* handle communication so we can shutup when asked */
 	apdu_set_confirmed_handler(SERVICE_CONFIRMED_DEVICE_COMMUNICATION_CONTROL,
 														 handler_device_communication_control);
 
 	apdu_set_confirmed_handler(SERVICE_CONFIRMED_SUBSCRIBE_COV, handler_cov_subscribe);
+	apdu_set_confirmed_handler(SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY, handler_cov_subscribe_property);
 
 	handler_cov_init();
+	handler_cov_restore();
+	/* follow remote points, see cov_client_point_add() */
+	cov_client_init();
 
 	Send_I_Am(&Handler_Transmit_Buffer[0]);
 
@@ -153,6 +165,11 @@ void bacnet_task(void)
 	uint16_t pdu_len;
 	BACNET_ADDRESS src; /* source address */
 	uint8_t PDUBuffer[MAX_MPDU];
+	us_timestamp_t elapsed_us;
+	us_timestamp_t consumed_us = 0;
+	uint16_t milliseconds;
+
+	msTimer.start();
 
 	while (1)
 	{
@@ -176,6 +193,23 @@ void bacnet_task(void)
 		}
 
 		handler_cov_task();
+		cov_client_task();
+
+		/* only whole milliseconds are passed on, the remainder is carried
+		   over to the next pass so that the timers do not run slow */
+		elapsed_us = msTimer.read_high_resolution_us() - consumed_us;
+		if (elapsed_us >= 1000)
+		{
+			milliseconds = (elapsed_us / 1000 > UINT16_MAX) ? UINT16_MAX : (uint16_t)(elapsed_us / 1000);
+			consumed_us += milliseconds * 1000ULL;
+#if (MAX_TSM_TRANSACTIONS)
+			/* retransmit confirmed requests using the timeout of each peer */
+			tsm_timer_milliseconds(milliseconds);
+#endif
+			apdu_response_cache_timer_milliseconds(milliseconds);
+			handler_cov_timer_milliseconds(milliseconds);
+			cov_client_timer_milliseconds(milliseconds);
+		}
 
 #if MBED_CONF_RTOS_PRESENT
 #if MBED_VERSION >= MBED_ENCODE_VERSION(5, 10, 0)
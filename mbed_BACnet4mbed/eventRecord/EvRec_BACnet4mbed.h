@@ -73,6 +73,7 @@ typedef enum
 	BACNET_H_COV_SENDING_SACK						= 0xAA0D + EventLevelOp,		// Record2
 	BACNET_H_COV_RESPONSE_SENT					= 0xAA0E + EventLevelOp,		// Record2 / bytes_sent
 	BACNET_H_COV_SENDING_FAILED					= 0xAA0F + EventLevelError,	// Record2 / errno
+	BACNET_H_COV_NOTIF_TOO_LARGE				= 0xAA10 + EventLevelError,	// Record2 / apdu_len / max_apdu of the subscriber
     
 	// BACnet Handler Unconfirmed COV       
 	BACNET_H_UCOV_RCVD_NOTIF						= 0xAB01 + EventLevelOp,		// RecordData / src [BACNET_ADDRESS]
@@ -193,6 +194,7 @@ typedef enum
 	// BACnet Init
 	BACNET_INIT_ADDR_CONVERSION_OK			= 0xB600 + EventLevelOp,		// RecordData / ifname_string
 	BACNET_INIT_ADDR_CONVERSION_FAIL		= 0xB601 + EventLevelError,	// RecordData / ifname_string
+	BACNET_INIT_OBJ_INDEX_FAILED				= 0xB602 + EventLevelError,	// Record2 / object_type / count
 	
 	// BACnet Send PDU
 	BACNET_SENDING_PDU									= 0xB700 + EventLevelOp,		// Record2
@@ -0,0 +1,828 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "config_bacnet.h"
+#include "txbuf.h"
+#include "bacdef.h"
+#include "bacdcode.h"
+#include "bacapp.h"
+#include "bacstr.h"
+#include "apdu.h"
+#include "npdu.h"
+#include "abort.h"
+#include "tsm.h"
+#include "dcc.h"
+#include "datalink.h"
+#include "cov.h"
+#include "rp.h"
+#include "whois.h"
+#include "peercap.h"
+#include "mbed_critical.h"
+#include "covclient.h"
+
+/** @file covclient.c  Follows the values of remote points by COV. */
+
+/* The client subscribes to the remote points with SubscribeCOV and
+   renews the subscription when half of its lifetime is gone, which also
+   makes the device send the current value again in case a notification
+   was lost. A device that refuses the subscription is polled with
+   ReadProperty instead, and asked again after a lifetime. The address
+   of a device comes from its I-Am, see peercap.h, a Who-Is is sent for
+   devices that are not known yet. */
+#ifndef COV_CLIENT_LIFETIME
+#define COV_CLIENT_LIFETIME 300
+#endif
+#ifndef COV_CLIENT_POLL_INTERVAL
+#define COV_CLIENT_POLL_INTERVAL 10
+#endif
+#ifndef COV_CLIENT_RETRY_INTERVAL
+#define COV_CLIENT_RETRY_INTERVAL 10
+#endif
+/* the values of a notification, present value and status flags for
+   the standard objects */
+#define COV_CLIENT_PROPERTIES 4
+
+typedef enum BACnet_COV_Client_State {
+    COV_CLIENT_IDLE = 0,
+    /* subscribes, or renews, when the timer runs out */
+    COV_CLIENT_SUBSCRIBE,
+    /* reads the present value when the timer runs out */
+    COV_CLIENT_POLL,
+    /* cancels the subscription, then the point is free */
+    COV_CLIENT_CANCEL
+} BACNET_COV_CLIENT_STATE;
+
+/* The subscriber process identifier of a point is its index + 1, so a
+   notification finds its point without a search. */
+typedef struct BACnet_COV_Client_Point {
+    uint32_t device_id;
+    BACNET_OBJECT_ID object;
+    /* BACNET_COV_CLIENT_STATE */
+    uint8_t state;
+    /* the request in flight, 0 if there is none */
+    uint8_t invoke_id;
+    /* the request in flight was answered by an Ack, Error, Reject or
+       Abort */
+    bool answered;
+    /* the request in flight was acknowledged */
+    bool acked;
+    /* the device accepted the subscription */
+    bool subscribed;
+    /* cov_client_point_remove() was called */
+    volatile bool remove;
+    /* milliseconds until the next request */
+    uint32_t timer;
+    /* milliseconds until a polled point asks for a subscription again */
+    uint32_t resubscribe;
+} BACNET_COV_CLIENT_POINT;
+
+/* The values are written by the task in a critical section and read by
+   the application without one, see cov_client_value(). */
+typedef struct BACnet_COV_Client_Mirror {
+    /* incremented before and after the value is written */
+    volatile uint32_t sequence;
+    volatile uint8_t tag;
+    volatile uint32_t type;
+    volatile uint8_t status_flags;
+    volatile bool polled;
+    volatile uint32_t timestamp;
+} BACNET_COV_CLIENT_MIRROR;
+
+static BACNET_COV_CLIENT_POINT COV_Client_Points[MAX_COV_CLIENT_POINTS];
+static BACNET_COV_CLIENT_MIRROR COV_Client_Mirror[MAX_COV_CLIENT_POINTS];
+/* milliseconds counted by the timer */
+static volatile uint32_t COV_Client_Uptime;
+
+/* forgets the value of a point, the caller owns the critical section */
+static void cov_client_value_clear(
+    unsigned index)
+{
+    COV_Client_Mirror[index].sequence++;
+    COV_Client_Mirror[index].tag = MAX_BACNET_APPLICATION_TAG;
+    COV_Client_Mirror[index].type = 0;
+    COV_Client_Mirror[index].status_flags = 0;
+    COV_Client_Mirror[index].polled = false;
+    COV_Client_Mirror[index].timestamp = 0;
+    COV_Client_Mirror[index].sequence++;
+}
+
+/**
+ * Stores the received value of a point.
+ *
+ * @param  index - offset into the point list
+ * @param  value - the present value
+ * @param  status_flags - the status flags, NULL keeps the stored ones
+ * @param  polled - true if the value was read
+ */
+static void cov_client_value_store(
+    unsigned index,
+    BACNET_APPLICATION_DATA_VALUE * value,
+    BACNET_BIT_STRING * status_flags,
+    bool polled)
+{
+    BACNET_COV_CLIENT_VALUE client_value;
+    uint8_t flags = 0;
+    uint8_t bit = 0;
+
+    memset(&client_value, 0, sizeof(client_value));
+    switch (value->tag) {
+#if defined (BACAPP_BOOLEAN)
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            client_value.type.Boolean = value->type.Boolean;
+            break;
+#endif
+#if defined (BACAPP_UNSIGNED)
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            client_value.type.Unsigned_Int = value->type.Unsigned_Int;
+            break;
+#endif
+#if defined (BACAPP_SIGNED)
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            client_value.type.Signed_Int = value->type.Signed_Int;
+            break;
+#endif
+#if defined (BACAPP_REAL)
+        case BACNET_APPLICATION_TAG_REAL:
+            client_value.type.Real = value->type.Real;
+            break;
+#endif
+#if defined (BACAPP_ENUMERATED)
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            client_value.type.Enumerated = value->type.Enumerated;
+            break;
+#endif
+        default:
+            /* not a value of a point */
+            return;
+    }
+    if (status_flags) {
+        for (bit = STATUS_FLAG_IN_ALARM; bit <= STATUS_FLAG_OUT_OF_SERVICE;
+            bit++) {
+            if (bitstring_bit(status_flags, bit)) {
+                flags |= (uint8_t) (1 << bit);
+            }
+        }
+    } else {
+        flags = COV_Client_Mirror[index].status_flags;
+    }
+    core_util_critical_section_enter();
+    COV_Client_Mirror[index].sequence++;
+    COV_Client_Mirror[index].tag = value->tag;
+    COV_Client_Mirror[index].type = client_value.type.Unsigned_Int;
+    COV_Client_Mirror[index].status_flags = flags;
+    COV_Client_Mirror[index].polled = polled;
+    COV_Client_Mirror[index].timestamp = COV_Client_Uptime;
+    COV_Client_Mirror[index].sequence++;
+    core_util_critical_section_exit();
+}
+
+/* takes the values of a notification for its point */
+static void cov_client_notified(
+    BACNET_COV_DATA * cov_data)
+{
+    BACNET_PROPERTY_VALUE *value = NULL;
+    BACNET_PROPERTY_VALUE *present_value = NULL;
+    BACNET_BIT_STRING *status_flags = NULL;
+    unsigned index = cov_data->subscriberProcessIdentifier - 1;
+
+    if (index >= MAX_COV_CLIENT_POINTS) {
+        return;
+    }
+    if ((COV_Client_Points[index].state == COV_CLIENT_IDLE) ||
+        (COV_Client_Points[index].device_id !=
+            cov_data->initiatingDeviceIdentifier) ||
+        (COV_Client_Points[index].object.type !=
+            cov_data->monitoredObjectIdentifier.type) ||
+        (COV_Client_Points[index].object.instance !=
+            cov_data->monitoredObjectIdentifier.instance)) {
+        /* not ours, or a point that was removed */
+        return;
+    }
+    for (value = cov_data->listOfValues; value; value = value->next) {
+        if (value->propertyIdentifier == PROP_PRESENT_VALUE) {
+            present_value = value;
+        }
+#if defined (BACAPP_BIT_STRING)
+        else if ((value->propertyIdentifier == PROP_STATUS_FLAGS) &&
+            (value->value.tag == BACNET_APPLICATION_TAG_BIT_STRING)) {
+            status_flags = &value->value.type.Bit_String;
+        }
+#endif
+    }
+    if (present_value) {
+        cov_client_value_store(index, &present_value->value, status_flags,
+            false);
+    }
+}
+
+/* decodes a notification, returns its length or a negative value */
+static int cov_client_notification_decode(
+    uint8_t * service_request,
+    uint16_t service_len)
+{
+    BACNET_COV_DATA cov_data;
+    BACNET_PROPERTY_VALUE property_value[COV_CLIENT_PROPERTIES];
+    unsigned index = 0;
+    int len = 0;
+
+    for (index = 0; index < COV_CLIENT_PROPERTIES; index++) {
+        property_value[index].next = (index + 1 < COV_CLIENT_PROPERTIES) ?
+            &property_value[index + 1] : NULL;
+    }
+    cov_data.listOfValues = &property_value[0];
+    len =
+        cov_notify_decode_service_request(service_request, service_len,
+        &cov_data);
+    if (len > 0) {
+        cov_client_notified(&cov_data);
+    }
+
+    return len;
+}
+
+/* Handler for an Unconfirmed COV Notification */
+static void cov_client_unconfirmed_notification(
+    uint8_t * service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS * src)
+{
+    (void) src;
+    (void) cov_client_notification_decode(service_request, service_len);
+}
+
+/* Handler for a Confirmed COV Notification */
+static void cov_client_confirmed_notification(
+    uint8_t * service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS * src,
+    BACNET_CONFIRMED_SERVICE_DATA * service_data)
+{
+    BACNET_NPDU_DATA npdu_data;
+    BACNET_ADDRESS my_address;
+    int len = 0;
+    int pdu_len = 0;
+
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    pdu_len =
+        npdu_encode_pdu(&Handler_Transmit_Buffer[0], src, &my_address,
+        &npdu_data);
+    if (service_data->segmented_message) {
+        len =
+            abort_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, ABORT_REASON_SEGMENTATION_NOT_SUPPORTED,
+            true);
+    } else if (cov_client_notification_decode(service_request,
+            service_len) <= 0) {
+        len =
+            abort_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, ABORT_REASON_OTHER, true);
+    } else {
+        len =
+            encode_simple_ack(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, SERVICE_CONFIRMED_COV_NOTIFICATION);
+    }
+    pdu_len += len;
+    (void) datalink_send_pdu(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
+    /* keep the reply in case the request is retransmitted */
+    apdu_response_cache_store(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
+}
+
+#if (MAX_TSM_TRANSACTIONS)
+/* The point waiting for the answer to a request. Once answered, the
+   invoke id may be taken again by another request before the task sees
+   the answer, so an answered point no longer matches. */
+static int cov_client_invoke_find(
+    uint8_t invoke_id)
+{
+    unsigned index = 0;
+
+    for (index = 0; index < MAX_COV_CLIENT_POINTS; index++) {
+        if ((COV_Client_Points[index].state != COV_CLIENT_IDLE) &&
+            (COV_Client_Points[index].invoke_id == invoke_id) &&
+            !COV_Client_Points[index].answered) {
+            return (int) index;
+        }
+    }
+
+    return -1;
+}
+
+/* Handler for the SimpleACK of a SubscribeCOV */
+static void cov_client_subscribe_ack(
+    BACNET_ADDRESS * src,
+    uint8_t invoke_id)
+{
+    int index = cov_client_invoke_find(invoke_id);
+
+    (void) src;
+    if (index >= 0) {
+        COV_Client_Points[index].acked = true;
+        COV_Client_Points[index].answered = true;
+    }
+}
+
+/* Handler for the ReadProperty ACK of a polled point */
+static void cov_client_read_property_ack(
+    uint8_t * service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS * src,
+    BACNET_CONFIRMED_SERVICE_ACK_DATA * service_data)
+{
+    BACNET_READ_PROPERTY_DATA data;
+    BACNET_APPLICATION_DATA_VALUE value;
+    int index = cov_client_invoke_find(service_data->invoke_id);
+
+    (void) src;
+    if (index < 0) {
+        return;
+    }
+    COV_Client_Points[index].answered = true;
+    if (rp_ack_decode_service_request(service_request, service_len,
+            &data) <= 0) {
+        return;
+    }
+    if ((data.object_type != COV_Client_Points[index].object.type) ||
+        (data.object_instance != COV_Client_Points[index].object.instance) ||
+        (data.object_property != PROP_PRESENT_VALUE)) {
+        return;
+    }
+    if (bacapp_decode_application_data(data.application_data,
+            (unsigned) data.application_data_len, &value) > 0) {
+        cov_client_value_store((unsigned) index, &value, NULL, true);
+        COV_Client_Points[index].acked = true;
+    }
+}
+
+/* Handler for an Error to a SubscribeCOV or ReadProperty */
+static void cov_client_error(
+    BACNET_ADDRESS * src,
+    uint8_t invoke_id,
+    BACNET_ERROR_CLASS error_class,
+    BACNET_ERROR_CODE error_code)
+{
+    int index = cov_client_invoke_find(invoke_id);
+
+    (void) src;
+    (void) error_class;
+    (void) error_code;
+    if (index >= 0) {
+        COV_Client_Points[index].answered = true;
+    }
+}
+
+/* Handler for a Reject */
+static void cov_client_reject(
+    BACNET_ADDRESS * src,
+    uint8_t invoke_id,
+    uint8_t reject_reason)
+{
+    int index = cov_client_invoke_find(invoke_id);
+
+    (void) src;
+    (void) reject_reason;
+    if (index >= 0) {
+        COV_Client_Points[index].answered = true;
+    }
+}
+
+/* Handler for an Abort */
+static void cov_client_abort(
+    BACNET_ADDRESS * src,
+    uint8_t invoke_id,
+    uint8_t abort_reason,
+    bool server)
+{
+    int index = cov_client_invoke_find(invoke_id);
+
+    (void) src;
+    (void) abort_reason;
+    (void) server;
+    if (index >= 0) {
+        COV_Client_Points[index].answered = true;
+    }
+}
+
+/* frees a point, it may be added again */
+static void cov_client_free(
+    unsigned index)
+{
+    core_util_critical_section_enter();
+    cov_client_value_clear(index);
+    COV_Client_Points[index].subscribed = false;
+    COV_Client_Points[index].remove = false;
+    COV_Client_Points[index].state = COV_CLIENT_IDLE;
+    core_util_critical_section_exit();
+}
+
+/* asks for the address of a device */
+static void cov_client_who_is(
+    uint32_t device_id)
+{
+    BACNET_ADDRESS dest;
+    BACNET_ADDRESS my_address;
+    BACNET_NPDU_DATA npdu_data;
+    unsigned index = 0;
+    int pdu_len = 0;
+
+    datalink_get_broadcast_address(&dest);
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    pdu_len =
+        npdu_encode_pdu(&Handler_Transmit_Buffer[0], &dest, &my_address,
+        &npdu_data);
+    pdu_len +=
+        whois_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+        (int32_t) device_id, (int32_t) device_id);
+    (void) datalink_send_pdu(&dest, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
+    /* one Who-Is serves all points of the device */
+    for (index = 0; index < MAX_COV_CLIENT_POINTS; index++) {
+        if ((COV_Client_Points[index].state != COV_CLIENT_IDLE) &&
+            (COV_Client_Points[index].device_id == device_id)) {
+            COV_Client_Points[index].timer =
+                COV_CLIENT_RETRY_INTERVAL * 1000UL;
+        }
+    }
+}
+
+/**
+ * Sends the request of a point: SubscribeCOV, its cancellation, or
+ * ReadProperty of the present value.
+ *
+ * @param  index - offset into the point list
+ *
+ * @return invoke id of the request, 0 if it was not sent
+ */
+static uint8_t cov_client_request(
+    unsigned index)
+{
+    BACNET_COV_CLIENT_POINT *point = &COV_Client_Points[index];
+    BACNET_PEER_CAPABILITY capability;
+    BACNET_SUBSCRIBE_COV_DATA cov_data;
+    BACNET_READ_PROPERTY_DATA rpdata;
+    BACNET_ADDRESS my_address;
+    BACNET_NPDU_DATA npdu_data;
+    uint8_t invoke_id = 0;
+    int pdu_len = 0;
+
+    if (!peercap_bind_request(point->device_id, &capability)) {
+        cov_client_who_is(point->device_id);
+        return 0;
+    }
+    /* may we have another request in flight to this device? */
+    if (!tsm_window_available(&capability.address)) {
+        return 0;
+    }
+    invoke_id = tsm_next_free_invokeID();
+    if (!invoke_id) {
+        return 0;
+    }
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, true, MESSAGE_PRIORITY_NORMAL);
+    pdu_len =
+        npdu_encode_pdu(&Handler_Transmit_Buffer[0], &capability.address,
+        &my_address, &npdu_data);
+    if (point->state == COV_CLIENT_POLL) {
+        rpdata.object_type = (BACNET_OBJECT_TYPE) point->object.type;
+        rpdata.object_instance = point->object.instance;
+        rpdata.object_property = PROP_PRESENT_VALUE;
+        rpdata.array_index = BACNET_ARRAY_ALL;
+        pdu_len +=
+            rp_encode_apdu(&Handler_Transmit_Buffer[pdu_len], invoke_id,
+            &rpdata);
+    } else {
+        memset(&cov_data, 0, sizeof(cov_data));
+        cov_data.subscriberProcessIdentifier = index + 1;
+        cov_data.monitoredObjectIdentifier = point->object;
+        cov_data.cancellationRequest = (point->state == COV_CLIENT_CANCEL);
+        cov_data.issueConfirmedNotifications = false;
+        cov_data.lifetime = COV_CLIENT_LIFETIME;
+        pdu_len +=
+            cov_subscribe_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+            invoke_id, &cov_data);
+    }
+    tsm_set_confirmed_unsegmented_transaction(invoke_id,
+        &capability.address, &npdu_data, &Handler_Transmit_Buffer[0],
+        (uint16_t) pdu_len);
+    (void) datalink_send_pdu(&capability.address, &npdu_data,
+        &Handler_Transmit_Buffer[0], pdu_len);
+
+    return invoke_id;
+}
+
+/* moves a point on when its request was answered */
+static void cov_client_answered(
+    unsigned index)
+{
+    BACNET_COV_CLIENT_POINT *point = &COV_Client_Points[index];
+
+    switch (point->state) {
+        case COV_CLIENT_SUBSCRIBE:
+            if (point->acked) {
+                point->subscribed = true;
+                point->timer = COV_CLIENT_LIFETIME * 500UL;
+            } else {
+                /* refused, read the value instead */
+                point->subscribed = false;
+                point->state = COV_CLIENT_POLL;
+                point->timer = 0;
+                point->resubscribe = COV_CLIENT_LIFETIME * 1000UL;
+            }
+            break;
+        case COV_CLIENT_POLL:
+            point->timer = COV_CLIENT_POLL_INTERVAL * 1000UL;
+            if (!point->resubscribe) {
+                point->state = COV_CLIENT_SUBSCRIBE;
+            }
+            break;
+        case COV_CLIENT_CANCEL:
+        default:
+            cov_client_free(index);
+            break;
+    }
+}
+
+/* checks the request of a point in flight */
+static void cov_client_check(
+    unsigned index)
+{
+    BACNET_COV_CLIENT_POINT *point = &COV_Client_Points[index];
+
+    if (!point->invoke_id) {
+        return;
+    }
+    if (point->answered) {
+        /* acked is set if it was not an Error, Reject or Abort */
+        point->invoke_id = 0;
+        point->answered = false;
+        cov_client_answered(index);
+    } else if (tsm_invoke_id_failed(point->invoke_id)) {
+        tsm_free_invoke_id(point->invoke_id);
+        point->invoke_id = 0;
+        if (point->state == COV_CLIENT_CANCEL) {
+            /* the subscription runs out by itself */
+            cov_client_free(index);
+        } else {
+            /* the device may be offline, or have a new address: its
+               I-Am moves the binding in the peer table */
+            cov_client_who_is(point->device_id);
+        }
+    }
+}
+#endif
+
+/** Sends the requests of the points that are due.
+ * Called from the BACnet task, like handler_cov_task().
+ */
+void cov_client_task(
+    void)
+{
+#if (MAX_TSM_TRANSACTIONS)
+    static unsigned next = 0;
+    BACNET_COV_CLIENT_POINT *point = NULL;
+    unsigned first = next;
+    unsigned index = 0;
+    unsigned i = 0;
+
+    for (i = 0; i < MAX_COV_CLIENT_POINTS; i++) {
+        index = (first + i) % MAX_COV_CLIENT_POINTS;
+        point = &COV_Client_Points[index];
+        if (point->state == COV_CLIENT_IDLE) {
+            continue;
+        }
+        cov_client_check(index);
+        if ((point->state == COV_CLIENT_IDLE) || point->invoke_id) {
+            continue;
+        }
+        if (point->remove && (point->state != COV_CLIENT_CANCEL)) {
+            if (!point->subscribed) {
+                cov_client_free(index);
+                continue;
+            }
+            point->state = COV_CLIENT_CANCEL;
+            point->timer = 0;
+        }
+        if (point->timer || !dcc_communication_enabled()) {
+            continue;
+        }
+        point->answered = false;
+        point->acked = false;
+        point->invoke_id = cov_client_request(index);
+        if (point->invoke_id) {
+            next = (index + 1) % MAX_COV_CLIENT_POINTS;
+        }
+    }
+#endif
+}
+
+/** Counts down the timers of the points.
+ * Called from the BACnet task with the time since the last call.
+ *
+ * @param  milliseconds - the time that passed
+ */
+void cov_client_timer_milliseconds(
+    uint16_t milliseconds)
+{
+    unsigned index = 0;
+
+    COV_Client_Uptime += milliseconds;
+    for (index = 0; index < MAX_COV_CLIENT_POINTS; index++) {
+        if (COV_Client_Points[index].state == COV_CLIENT_IDLE) {
+            continue;
+        }
+        COV_Client_Points[index].timer =
+            (COV_Client_Points[index].timer > milliseconds) ?
+            COV_Client_Points[index].timer - milliseconds : 0;
+        COV_Client_Points[index].resubscribe =
+            (COV_Client_Points[index].resubscribe > milliseconds) ?
+            COV_Client_Points[index].resubscribe - milliseconds : 0;
+    }
+}
+
+/** Adds a remote point to follow.
+ * The point is subscribed by the task, its value can be read with
+ * cov_client_value() once the first notification arrived.
+ *
+ * @param  device_id - instance of the remote device
+ * @param  object_type - type of the remote object
+ * @param  object_instance - instance of the remote object
+ *
+ * @return the point, the one that follows the object already if there
+ *         is one, or -1 if all points are used
+ */
+int cov_client_point_add(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    BACNET_COV_CLIENT_POINT *point = NULL;
+    int free_index = -1;
+    int found_index = -1;
+    unsigned index = 0;
+
+    if ((device_id > BACNET_MAX_INSTANCE) ||
+        (object_instance > BACNET_MAX_INSTANCE)) {
+        return -1;
+    }
+    core_util_critical_section_enter();
+    for (index = 0; index < MAX_COV_CLIENT_POINTS; index++) {
+        point = &COV_Client_Points[index];
+        if (point->state == COV_CLIENT_IDLE) {
+            if (free_index < 0) {
+                free_index = (int) index;
+            }
+        } else if (!point->remove && (point->device_id == device_id) &&
+            (point->object.type == object_type) &&
+            (point->object.instance == object_instance)) {
+            found_index = (int) index;
+            break;
+        }
+    }
+    if ((found_index < 0) && (free_index >= 0)) {
+        found_index = free_index;
+        point = &COV_Client_Points[found_index];
+        point->device_id = device_id;
+        point->object.type = (uint16_t) object_type;
+        point->object.instance = object_instance;
+        point->invoke_id = 0;
+        point->answered = false;
+        point->acked = false;
+        point->subscribed = false;
+        point->remove = false;
+        point->timer = 0;
+        point->resubscribe = 0;
+        cov_client_value_clear((unsigned) found_index);
+        point->state = COV_CLIENT_SUBSCRIBE;
+    }
+    core_util_critical_section_exit();
+
+    return found_index;
+}
+
+/** Stops following a remote point.
+ * The task cancels its subscription, then the point is free.
+ *
+ * @param  point - the point from cov_client_point_add()
+ *
+ * @return true if the point was in use
+ */
+bool cov_client_point_remove(
+    unsigned point)
+{
+    if ((point >= MAX_COV_CLIENT_POINTS) ||
+        (COV_Client_Points[point].state == COV_CLIENT_IDLE)) {
+        return false;
+    }
+    COV_Client_Points[point].remove = true;
+
+    return true;
+}
+
+/** Gets the latest value of a remote point.
+ * Safe to call from any thread without a lock: the copy is taken again
+ * if the task stored a new value while it was taken.
+ *
+ * @param  point - the point from cov_client_point_add()
+ * @param  value - filled with the value
+ *
+ * @return true if a value was received
+ */
+bool cov_client_value(
+    unsigned point,
+    BACNET_COV_CLIENT_VALUE * value)
+{
+    BACNET_COV_CLIENT_MIRROR *mirror = NULL;
+    uint32_t sequence = 0;
+
+    if ((point >= MAX_COV_CLIENT_POINTS) || !value) {
+        return false;
+    }
+    mirror = &COV_Client_Mirror[point];
+    do {
+        sequence = mirror->sequence;
+        value->tag = mirror->tag;
+        value->type.Unsigned_Int = mirror->type;
+        value->status_flags = mirror->status_flags;
+        value->polled = mirror->polled;
+        value->timestamp = mirror->timestamp;
+    } while ((sequence & 1) || (sequence != mirror->sequence));
+
+    return value->tag < MAX_BACNET_APPLICATION_TAG;
+}
+
+/** Gets the time base of the value timestamps.
+ *
+ * @return milliseconds since cov_client_init()
+ */
+uint32_t cov_client_uptime(
+    void)
+{
+    return COV_Client_Uptime;
+}
+
+/** Clears the points and sets up the handlers of the COV client.
+ * The client takes the COV notifications, the acknowledges and errors of
+ * SubscribeCOV and those of ReadProperty, and the Reject and Abort
+ * handlers.
+ */
+void cov_client_init(
+    void)
+{
+    unsigned index = 0;
+
+    core_util_critical_section_enter();
+    for (index = 0; index < MAX_COV_CLIENT_POINTS; index++) {
+        COV_Client_Points[index].state = COV_CLIENT_IDLE;
+        COV_Client_Points[index].invoke_id = 0;
+        COV_Client_Points[index].answered = false;
+        COV_Client_Points[index].remove = false;
+        cov_client_value_clear(index);
+    }
+    COV_Client_Uptime = 0;
+    core_util_critical_section_exit();
+    apdu_set_unconfirmed_handler(SERVICE_UNCONFIRMED_COV_NOTIFICATION,
+        cov_client_unconfirmed_notification);
+    apdu_set_confirmed_handler(SERVICE_CONFIRMED_COV_NOTIFICATION,
+        cov_client_confirmed_notification);
+#if (MAX_TSM_TRANSACTIONS)
+    apdu_set_confirmed_simple_ack_handler(SERVICE_CONFIRMED_SUBSCRIBE_COV,
+        cov_client_subscribe_ack);
+    apdu_set_confirmed_ack_handler(SERVICE_CONFIRMED_READ_PROPERTY,
+        cov_client_read_property_ack);
+    apdu_set_error_handler(SERVICE_CONFIRMED_SUBSCRIBE_COV,
+        cov_client_error);
+    apdu_set_error_handler(SERVICE_CONFIRMED_READ_PROPERTY,
+        cov_client_error);
+    apdu_set_reject_handler(cov_client_reject);
+    apdu_set_abort_handler(cov_client_abort);
+#endif
+}
@@ -25,8 +25,10 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <time.h>
 #include "config_bacnet.h"
 #include "txbuf.h"
 #include "bacdef.h"
@@ -37,9 +39,14 @@
 #include "npdu.h"
 #include "abort.h"
 #include "reject.h"
+#include "bacreal.h"
 #include "cov.h"
+#include "objname.h"
+#include "covstore.h"
+#include "peercap.h"
 #include "tsm.h"
 #include "dcc.h"
+#include "mbed_critical.h"
 
 #include "EvRec_BACnet4mbed.h"
 
@@ -58,44 +65,204 @@
 typedef struct BACnet_COV_Address{
     bool valid:1;
     BACNET_ADDRESS dest;
+    /* the subscriptions sending to the address */
+    uint16_t references;
+    /* the next address of the same list, COV_NONE at the end */
+    uint16_t next;
+    /* confirmed notifications waiting for an acknowledge */
+    uint8_t outstanding;
+    /* confirmed notifications sent and failed to confirm */
+    uint32_t confirmed_sent;
+    uint32_t confirmed_failed;
+    /* the subscription notified last, see handler_cov_task() */
+    uint16_t cursor;
+    /* subscriptions with a notification waiting, and the most seen */
+    uint16_t backlog;
+    uint16_t backlog_peak;
+    /* notifications sent */
+    uint32_t notified;
 } BACNET_COV_ADDRESS;
 
-/* note: This COV service only monitors the properties
-   of an object that have been specified in the standard.  */
+/* note: SubscribeCOV monitors the properties of an object that have
+   been specified in the standard, reported by the object itself.
+   SubscribeCOVProperty monitors one property, compared with the value
+   last notified by cov_property_check(). */
 typedef struct BACnet_COV_Subscription_Flags {
     bool valid:1;
     bool issueConfirmedNotifications:1; /* optional */
     bool send_requested:1;
+    /* the monitored property is compared by value, see above */
+    bool by_value:1;
+    bool covIncrementPresent:1;
 } BACNET_COV_SUBSCRIPTION_FLAGS;
 
 typedef struct BACnet_COV_Subscription {
     BACNET_COV_SUBSCRIPTION_FLAGS flag;
-    uint8_t dest_index;
+    /* the address of the subscriber, COV_NONE if there is none */
+    uint16_t dest_index;
     uint8_t invokeID;   /* for confirmed COV */
     uint32_t subscriberProcessIdentifier;
     uint32_t lifetime;  /* optional */
     BACNET_OBJECT_ID monitoredObjectIdentifier;
+    /* PROP_ALL for SubscribeCOV */
+    BACNET_PROPERTY_ID monitoredProperty;
+    uint32_t propertyArrayIndex;
+    float covIncrement; /* optional */
+    /* the monitored property when last notified, if by_value */
+    float lastValue;
+    uint32_t valueHash;
+    uint32_t flagsHash;
+    /* milliseconds until the next notification may be sent */
+    uint16_t holdoff;
+    /* the next subscription of the same list, COV_NONE at the end */
+    uint16_t next;
 } BACNET_COV_SUBSCRIPTION;
 
 #ifndef MAX_COV_SUBCRIPTIONS
 #define MAX_COV_SUBCRIPTIONS 128
 #endif
+#if (MAX_COV_SUBCRIPTIONS >= UINT16_MAX)
+#error "MAX_COV_SUBCRIPTIONS must be less than 65535"
+#endif
 static BACNET_COV_SUBSCRIPTION COV_Subscriptions[MAX_COV_SUBCRIPTIONS];
+/* The valid subscriptions are linked in lists by the hash of their
+   monitored object, so the subscribers of an object, and the entry a
+   renewal or cancellation refers to, are found by walking one short
+   list instead of all subscriptions. The unused entries are linked in
+   the free list. */
+#define COV_NONE UINT16_MAX
+static uint16_t COV_Object_Lists[MAX_COV_SUBCRIPTIONS];
+static uint16_t COV_Free_List;
+static unsigned COV_Subscription_Count;
+/* set by the timer when a lifetime runs out */
+static volatile bool COV_Expired;
+/* The lifetime of a subscription ran out, the task removes it. Set by
+   the timer, so kept out of the flags: the task writing a flag of the
+   bit field would write back an expired bit it had read before. */
+static volatile uint8_t COV_Subscription_Expired[MAX_COV_SUBCRIPTIONS];
+/* The addresses of the subscribers are linked in lists by their hash
+   like the subscriptions, and freed when the last subscription that
+   holds a reference to them is removed. */
 #ifndef MAX_COV_ADDRESSES
-#define MAX_COV_ADDRESSES 16
+#define MAX_COV_ADDRESSES MAX_COV_SUBCRIPTIONS
+#endif
+#if (MAX_COV_ADDRESSES >= UINT16_MAX)
+#error "MAX_COV_ADDRESSES must be less than 65535"
 #endif
 static BACNET_COV_ADDRESS COV_Addresses[MAX_COV_ADDRESSES];
+static uint16_t COV_Address_Lists[MAX_COV_ADDRESSES];
+static uint16_t COV_Address_Free_List;
+/* The task sends one notification per subscriber in turn, at most
+   COV_SEND_BUDGET per call, so a subscriber of many changed objects
+   does not hold back the others. */
+#ifndef COV_SEND_BUDGET
+#define COV_SEND_BUDGET 4
+#endif
+#if (COV_SEND_BUDGET < 1)
+#error "COV_SEND_BUDGET must be at least 1"
+#endif
+/* the subscription of each subscriber to notify next */
+static uint16_t COV_Address_Next[MAX_COV_ADDRESSES];
+/* the subscriber whose turn is next */
+static unsigned COV_Address_Turn;
+/* max number of confirmed notifications in flight per subscriber */
+#ifndef MAX_COV_CONFIRMED_WINDOW
+#define MAX_COV_CONFIRMED_WINDOW 2
+#endif
+
+/* Rate limit: after a notification, a subscription sends the next one
+   no earlier than the min interval of its object later. Changes in between only keep
+   the request pending, so the value current when the interval ends is
+   sent, and the last change of a burst is never lost. */
+#ifndef COV_MIN_INTERVAL_MS
+#define COV_MIN_INTERVAL_MS 1000
+#endif
+#if (COV_MIN_INTERVAL_MS > UINT16_MAX)
+#error "COV_MIN_INTERVAL_MS must not exceed 65535"
+#endif
+#ifndef MAX_COV_RATE_LIMITS
+#define MAX_COV_RATE_LIMITS 4
+#endif
+/* objects with a min interval of their own */
+typedef struct BACnet_COV_Rate_Limit {
+    BACNET_OBJECT_ID object;
+    uint16_t minInterval;
+    bool valid;
+} BACNET_COV_RATE_LIMIT;
+static BACNET_COV_RATE_LIMIT COV_Rate_Limits[MAX_COV_RATE_LIMITS];
+/* a subscription waits for its min interval to pass */
+static bool COV_Holdoff;
+/* changes merged into a notification that was still pending */
+static uint32_t COV_Suppressed;
+
+/* The subscriptions are stored, see covstore.h, and restored at boot,
+   so the subscribers keep getting notifications after a restart. A
+   change of the subscriptions is stored at once, the changes within
+   the next COV_STORE_INTERVAL seconds, renewals mostly, are stored
+   together when it ends. A store that fails is tried again after the
+   interval as well.
+   The lifetimes run on while the device is running and while it is
+   off, so the time of the RTC is stored with them, and the time passed
+   until the restore is taken from the lifetimes. Without an RTC that
+   keeps running, the lifetimes left when stored are restored. */
+#ifndef COV_STORE_INTERVAL
+#define COV_STORE_INTERVAL 60
+#endif
+#define COV_STORE_MAGIC 0x43535632UL
+typedef struct BACnet_COV_Store_Header {
+    uint32_t magic;
+    uint16_t record_size;
+    uint16_t count;
+    /* time() when stored */
+    uint32_t stored_time;
+} BACNET_COV_STORE_HEADER;
+typedef struct BACnet_COV_Store_Record {
+    BACNET_ADDRESS dest;
+    uint32_t subscriberProcessIdentifier;
+    /* the lifetime left when stored */
+    uint32_t lifetime;
+    BACNET_OBJECT_ID monitoredObjectIdentifier;
+    uint32_t monitoredProperty;
+    uint32_t propertyArrayIndex;
+    float covIncrement;
+    bool issueConfirmedNotifications;
+    bool covIncrementPresent;
+} BACNET_COV_STORE_RECORD;
+/* the subscriptions differ from the stored ones */
+static bool COV_Store_Dirty;
+/* seconds until the next store, counted by the timer */
+static volatile uint32_t COV_Store_Holdoff;
+
+/* Objects whose value changed, queued by handler_cov_object_changed()
+   and taken by handler_cov_task(). Values are set by the application
+   thread, so the queue is only touched in a critical section. If it
+   overflows, the task checks every subscribed object once instead. */
+#ifndef MAX_COV_CHANGED_OBJECTS
+#define MAX_COV_CHANGED_OBJECTS 16
+#endif
+typedef struct BACnet_COV_Changed {
+    BACNET_OBJECT_ID object;
+    /* false if the object was written, but did not report a change */
+    bool value_changed;
+} BACNET_COV_CHANGED;
+static BACNET_COV_CHANGED COV_Changed[MAX_COV_CHANGED_OBJECTS];
+static unsigned COV_Changed_First;
+static unsigned COV_Changed_Count;
+static bool COV_Changed_Overflow;
+/* a subscription may have a notification to send or to confirm */
+static bool COV_Pending;
+/* a monitored property read by value */
+static uint8_t COV_Value_Buffer[MAX_APDU];
 
 /**
 * Gets the address from the list of COV addresses
 *
 * @param  index - offset into COV address list where address is stored
-* @param  dest - address to be filled when found
 *
-* @return true if valid address, false if not valid or not found
+* @return the address, or NULL if not valid or not found
 */
 static BACNET_ADDRESS *cov_address_get(
-    int index)
+    unsigned index)
 {
     BACNET_ADDRESS *cov_dest = NULL;
 
@@ -108,92 +275,427 @@ static BACNET_ADDRESS *cov_address_get(
     return cov_dest;
 }
 
+/* the list of the addresses with the hash of an address */
+static uint16_t *cov_address_list(
+    BACNET_ADDRESS *dest)
+{
+    uint32_t hash = 0;
+
+    /* hash what bacnet_address_same() compares, the MAC address is
+       the one of the router for a remote address */
+    if (dest->net == 0) {
+        hash = object_name_hash((char *) dest->mac,
+            (dest->mac_len > MAX_MAC_LEN) ? MAX_MAC_LEN : dest->mac_len);
+    } else {
+        hash = object_name_hash((char *) dest->adr,
+            (dest->len > MAX_MAC_LEN) ? MAX_MAC_LEN : dest->len);
+        hash ^= dest->net * 2654435761UL;
+    }
+
+    return &COV_Address_Lists[hash % MAX_COV_ADDRESSES];
+}
+
 /**
- * Removes the address from the list of COV addresses, if it is not
- * used by other COV subscriptions
+ * Releases the reference of a COV subscription to the address of its
+ * subscriber, and removes the address when no subscription uses it
+ *
+ * @param  index - offset into COV subscription list
  */
-static void cov_address_remove_unused(void)
+static void cov_address_release(
+    unsigned index)
 {
-    unsigned index = 0;
-    unsigned cov_index = 0;
-    bool found = false;
+    unsigned dest_index = COV_Subscriptions[index].dest_index;
+    uint16_t *link = NULL;
 
-    for (cov_index = 0; cov_index < MAX_COV_ADDRESSES; cov_index++) {
-        if (COV_Addresses[cov_index].valid) {
-            found = false;
-            for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
-                if ((COV_Subscriptions[index].flag.valid) &&
-                    (COV_Subscriptions[index].dest_index == cov_index)) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-              COV_Addresses[cov_index].valid = false;
-							EVRECORD2(BACNET_H_COV_RM_UNUSED_SUBSC,
-                           COV_Subscriptions[index].monitoredObjectIdentifier.instance,
-                           COV_Subscriptions[index].monitoredObjectIdentifier.type);
-            }
-        }
+    COV_Subscriptions[index].dest_index = COV_NONE;
+    if (!cov_address_get(dest_index)) {
+        return;
     }
+    if (COV_Addresses[dest_index].references > 1) {
+        COV_Addresses[dest_index].references--;
+        return;
+    }
+    link = cov_address_list(&COV_Addresses[dest_index].dest);
+    while ((*link != COV_NONE) && (*link != dest_index)) {
+        link = &COV_Addresses[*link].next;
+    }
+    if (*link == dest_index) {
+        *link = COV_Addresses[dest_index].next;
+    }
+    COV_Addresses[dest_index].valid = false;
+    COV_Addresses[dest_index].references = 0;
+    COV_Addresses[dest_index].next = COV_Address_Free_List;
+    COV_Address_Free_List = (uint16_t) dest_index;
+    EVRECORD2(BACNET_H_COV_RM_UNUSED_SUBSC,
+        COV_Subscriptions[index].monitoredObjectIdentifier.instance,
+        COV_Subscriptions[index].monitoredObjectIdentifier.type);
 }
 
 /**
-* Adds the address to the list of COV addresses
+* Adds a reference to the address in the list of COV addresses
 *
 * @param  dest - address to be added if there is room in the list
 *
-* @return index number 0..N, or -1 if unable to add
+* @return index number 0..N, or COV_NONE if unable to add
 */
-static int cov_address_add(
+static uint16_t cov_address_add(
     BACNET_ADDRESS *dest)
 {
-    int index = -1;
-    unsigned i = 0;
-    bool found = false;
-    bool valid = false;
-    BACNET_ADDRESS *cov_dest = NULL;
+    uint16_t *list = NULL;
+    uint16_t index = COV_NONE;
 
     if (dest) {
-			
-			EVRECORD2(BACNET_H_COV_ADD_COV_ADDR, 0, 0);
-			
-        for (i = 0; i < MAX_COV_ADDRESSES; i++) {
-            valid = COV_Addresses[i].valid;
-            if (valid) {
-                cov_dest = &COV_Addresses[i].dest;
-                found = bacnet_address_same(dest, cov_dest);
-                if (found) {
-                    index = i;
-                    break;
-                }
+        EVRECORD2(BACNET_H_COV_ADD_COV_ADDR, 0, 0);
+
+        list = cov_address_list(dest);
+        for (index = *list; index != COV_NONE;
+            index = COV_Addresses[index].next) {
+            if (bacnet_address_same(dest, &COV_Addresses[index].dest)) {
+                COV_Addresses[index].references++;
+                break;
             }
         }
-        if (!found) {
-            /* find a free place to add a new address */
-            for (i = 0; i < MAX_COV_ADDRESSES; i++) {
-                valid = COV_Addresses[i].valid;
-							
-                if (!valid) {
-                    index = i;
-                    cov_dest = &COV_Addresses[i].dest;
-                    bacnet_address_copy(cov_dest, dest);
-                    COV_Addresses[i].valid = true;
-									
-									EVRECORD2(BACNET_H_COV_ADD_COV_SUCCESS, i, 0);
-									
-                    break;
-                }
-            }
+        if ((index == COV_NONE) && (COV_Address_Free_List != COV_NONE)) {
+            /* take a free entry for a new address */
+            index = COV_Address_Free_List;
+            COV_Address_Free_List = COV_Addresses[index].next;
+            bacnet_address_copy(&COV_Addresses[index].dest, dest);
+            COV_Addresses[index].valid = true;
+            COV_Addresses[index].references = 1;
+            COV_Addresses[index].outstanding = 0;
+            COV_Addresses[index].confirmed_sent = 0;
+            COV_Addresses[index].confirmed_failed = 0;
+            COV_Addresses[index].cursor = MAX_COV_SUBCRIPTIONS - 1;
+            COV_Addresses[index].backlog = 0;
+            COV_Addresses[index].backlog_peak = 0;
+            COV_Addresses[index].notified = 0;
+            COV_Addresses[index].next = *list;
+            *list = index;
+
+            EVRECORD2(BACNET_H_COV_ADD_COV_SUCCESS, index, 0);
         }
     }
 
-		if(index == -1)
-			EVRECORD2(BACNET_H_COV_ADD_COV_FAIL, 0, 0);
-		
+    if (index == COV_NONE)
+        EVRECORD2(BACNET_H_COV_ADD_COV_FAIL, 0, 0);
+
     return index;
 }
 
+/**
+ * Releases the confirmed notification of a subscription that is still
+ * waiting for an acknowledge, and frees its slot in the window of the
+ * subscriber.
+ *
+ * @param  index - offset into COV subscription list
+ * @param  failed - true if the notification failed to confirm
+ */
+static void cov_confirmed_release(
+    unsigned index,
+    bool failed)
+{
+    unsigned dest_index = COV_Subscriptions[index].dest_index;
+
+    if (COV_Subscriptions[index].invokeID == 0) {
+        return;
+    }
+    tsm_free_invoke_id(COV_Subscriptions[index].invokeID);
+    COV_Subscriptions[index].invokeID = 0;
+    if ((dest_index < MAX_COV_ADDRESSES) && COV_Addresses[dest_index].valid) {
+        if (COV_Addresses[dest_index].outstanding) {
+            COV_Addresses[dest_index].outstanding--;
+        }
+        if (failed) {
+            COV_Addresses[dest_index].confirmed_failed++;
+        }
+    }
+}
+
+/* the list of the subscriptions of an object */
+static uint16_t *cov_object_list(
+    uint32_t object_type,
+    uint32_t object_instance)
+{
+    /* the instance takes 22 bits, so this is the object identifier,
+       spread by a multiplicative hash */
+    uint32_t hash = ((object_type << 22) ^ object_instance) * 2654435761UL;
+
+    return &COV_Object_Lists[(hash >> 16) % MAX_COV_SUBCRIPTIONS];
+}
+
+/* true if a subscription in a list monitors the object */
+static bool cov_object_same(
+    unsigned index,
+    uint32_t object_type,
+    uint32_t object_instance)
+{
+    return (COV_Subscriptions[index].monitoredObjectIdentifier.type ==
+        object_type) &&
+        (COV_Subscriptions[index].monitoredObjectIdentifier.instance ==
+        object_instance);
+}
+
+/**
+ * Takes an entry of the free list for a new subscription and links it
+ * in the list of its object.
+ *
+ * @param  object_type - type of the monitored object
+ * @param  object_instance - instance of the monitored object
+ *
+ * @return index of the subscription, or -1 if all are used
+ */
+static int cov_subscription_add(
+    uint32_t object_type,
+    uint32_t object_instance)
+{
+    uint16_t *list = NULL;
+    unsigned index = COV_Free_List;
+
+    if (index == COV_NONE) {
+        return -1;
+    }
+    COV_Free_List = COV_Subscriptions[index].next;
+    COV_Subscriptions[index].flag.valid = true;
+    COV_Subscription_Expired[index] = 0;
+    COV_Subscriptions[index].monitoredObjectIdentifier.type =
+        (uint16_t) object_type;
+    COV_Subscriptions[index].monitoredObjectIdentifier.instance =
+        object_instance;
+    list = cov_object_list(object_type, object_instance);
+    COV_Subscriptions[index].next = *list;
+    *list = (uint16_t) index;
+    COV_Subscription_Count++;
+
+    return (int) index;
+}
+
+/**
+ * Removes a subscription from the list of its object, its entry goes
+ * back to the free list, and releases the address of the subscriber.
+ *
+ * @param  index - offset into COV subscription list
+ */
+static void cov_subscription_remove(
+    unsigned index)
+{
+    uint16_t *link = NULL;
+
+    cov_confirmed_release(index, false);
+    link =
+        cov_object_list(COV_Subscriptions[index].monitoredObjectIdentifier.
+        type, COV_Subscriptions[index].monitoredObjectIdentifier.instance);
+    while ((*link != COV_NONE) && (*link != index)) {
+        link = &COV_Subscriptions[*link].next;
+    }
+    if (*link == index) {
+        *link = COV_Subscriptions[index].next;
+    }
+    COV_Subscriptions[index].flag.valid = false;
+    COV_Subscription_Expired[index] = 0;
+    COV_Subscriptions[index].flag.send_requested = false;
+    cov_address_release(index);
+    COV_Subscriptions[index].next = COV_Free_List;
+    COV_Free_List = (uint16_t) index;
+    COV_Subscription_Count--;
+}
+
+/**
+ * Reads a property of an object into COV_Value_Buffer.
+ *
+ * @param  object - the object
+ * @param  property - the property
+ * @param  array_index - the array index, or BACNET_ARRAY_ALL
+ * @param  rpdata - filled, with the error if the property can't be read
+ *
+ * @return length of the encoded value, or a negative BACNET_STATUS
+ */
+static int cov_property_read(
+    BACNET_OBJECT_ID * object,
+    BACNET_PROPERTY_ID property,
+    uint32_t array_index,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    rpdata->object_type = (BACNET_OBJECT_TYPE) object->type;
+    rpdata->object_instance = object->instance;
+    rpdata->object_property = property;
+    rpdata->array_index = array_index;
+    rpdata->application_data = &COV_Value_Buffer[0];
+    rpdata->application_data_len = sizeof(COV_Value_Buffer);
+
+    return Device_Read_Property(rpdata);
+}
+
+/* the number an encoded value stands for, false if it is no number */
+static bool cov_value_number(
+    uint8_t * apdu,
+    float *number)
+{
+    uint8_t tag_number = 0;
+    uint32_t len_value = 0;
+    int len = 0;
+    uint32_t unsigned_value = 0;
+    int32_t signed_value = 0;
+    double double_value = 0.0;
+
+    if (IS_CONTEXT_SPECIFIC(apdu[0])) {
+        return false;
+    }
+    len = decode_tag_number_and_value(&apdu[0], &tag_number, &len_value);
+    switch (tag_number) {
+        case BACNET_APPLICATION_TAG_REAL:
+            decode_real(&apdu[len], number);
+            return true;
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            decode_double(&apdu[len], &double_value);
+            *number = (float) double_value;
+            return true;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            decode_unsigned(&apdu[len], len_value, &unsigned_value);
+            *number = (float) unsigned_value;
+            return true;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            decode_signed(&apdu[len], len_value, &signed_value);
+            *number = (float) signed_value;
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
+/**
+ * Compares the monitored property of a SubscribeCOVProperty
+ * subscription and its Status_Flags with the values last notified.
+ * A number must have changed by the COV increment of the subscription,
+ * if there is one, anything else by any amount. The values become the
+ * values last notified if they changed.
+ *
+ * @param  index - offset into COV subscription list
+ * @param  update - take the values as last notified in any case
+ *
+ * @return true if the property or the Status_Flags changed
+ */
+static bool cov_property_check(
+    unsigned index,
+    bool update)
+{
+    BACNET_COV_SUBSCRIPTION *subscription = &COV_Subscriptions[index];
+    BACNET_READ_PROPERTY_DATA rpdata;
+    uint32_t value_hash = 0;
+    uint32_t flags_hash = 0;
+    float value = 0.0f;
+    float delta = 0.0f;
+    bool number = false;
+    bool changed = update;
+    int len = 0;
+
+    len =
+        cov_property_read(&subscription->monitoredObjectIdentifier,
+        PROP_STATUS_FLAGS, BACNET_ARRAY_ALL, &rpdata);
+    if (len > 0) {
+        flags_hash = object_name_hash((char *) COV_Value_Buffer, len);
+    }
+    len =
+        cov_property_read(&subscription->monitoredObjectIdentifier,
+        subscription->monitoredProperty, subscription->propertyArrayIndex,
+        &rpdata);
+    if (len <= 0) {
+        return false;
+    }
+    value_hash = object_name_hash((char *) COV_Value_Buffer, len);
+    if (subscription->flag.covIncrementPresent) {
+        number = cov_value_number(&COV_Value_Buffer[0], &value);
+    }
+    if (flags_hash != subscription->flagsHash) {
+        changed = true;
+    } else if (number) {
+        delta = value - subscription->lastValue;
+        if ((delta >= subscription->covIncrement) ||
+            (-delta >= subscription->covIncrement)) {
+            changed = true;
+        }
+    } else if (value_hash != subscription->valueHash) {
+        changed = true;
+    }
+    if (changed) {
+        subscription->lastValue = value;
+        subscription->valueHash = value_hash;
+        subscription->flagsHash = flags_hash;
+    }
+
+    return changed;
+}
+
+/**
+ * Gets the confirmed notification statistics of a COV subscriber
+ *
+ * @param  index - offset into COV address list, 0..MAX_COV_ADDRESSES-1
+ * @param  dest - address of the subscriber, filled when valid
+ * @param  outstanding - notifications waiting for an acknowledge
+ * @param  sent - confirmed notifications sent
+ * @param  failed - confirmed notifications that failed to confirm
+ *
+ * @return true if the subscriber is valid
+ */
+bool handler_cov_subscriber_statistics(
+    unsigned index,
+    BACNET_ADDRESS * dest,
+    unsigned * outstanding,
+    uint32_t * sent,
+    uint32_t * failed)
+{
+    if ((index >= MAX_COV_ADDRESSES) || !COV_Addresses[index].valid) {
+        return false;
+    }
+    if (dest) {
+        bacnet_address_copy(dest, &COV_Addresses[index].dest);
+    }
+    if (outstanding) {
+        *outstanding = COV_Addresses[index].outstanding;
+    }
+    if (sent) {
+        *sent = COV_Addresses[index].confirmed_sent;
+    }
+    if (failed) {
+        *failed = COV_Addresses[index].confirmed_failed;
+    }
+
+    return true;
+}
+
+/**
+ * Gets the notification backlog of a COV subscriber
+ *
+ * @param  index - offset into COV address list, 0..MAX_COV_ADDRESSES-1
+ * @param  backlog - subscriptions with a notification waiting to be sent
+ * @param  backlog_peak - the largest backlog seen
+ * @param  notified - notifications sent
+ *
+ * @return true if the subscriber is valid
+ */
+bool handler_cov_subscriber_backlog(
+    unsigned index,
+    unsigned * backlog,
+    unsigned * backlog_peak,
+    uint32_t * notified)
+{
+    if ((index >= MAX_COV_ADDRESSES) || !COV_Addresses[index].valid) {
+        return false;
+    }
+    if (backlog) {
+        *backlog = COV_Addresses[index].backlog;
+    }
+    if (backlog_peak) {
+        *backlog_peak = COV_Addresses[index].backlog_peak;
+    }
+    if (notified) {
+        *notified = COV_Addresses[index].notified;
+    }
+
+    return true;
+}
+
 /*
 BACnetCOVSubscription ::= SEQUENCE {
 Recipient [0] BACnetRecipientProcess,
@@ -287,9 +789,24 @@ static int cov_encode_subscription(
         cov_subscription->monitoredObjectIdentifier.instance);
     apdu_len += len;
     /* propertyIdentifier [1] */
-    /* FIXME: we are monitoring 2 properties! How to encode? */
-    len = encode_context_enumerated(&apdu[apdu_len], 1, PROP_PRESENT_VALUE);
+    if (cov_subscription->monitoredProperty == PROP_ALL) {
+        /* FIXME: we are monitoring 2 properties! How to encode? */
+        len =
+            encode_context_enumerated(&apdu[apdu_len], 1,
+            PROP_PRESENT_VALUE);
+    } else {
+        len =
+            encode_context_enumerated(&apdu[apdu_len], 1,
+            cov_subscription->monitoredProperty);
+    }
     apdu_len += len;
+    /* propertyArrayIndex [2] Unsigned OPTIONAL */
+    if (cov_subscription->propertyArrayIndex != BACNET_ARRAY_ALL) {
+        len =
+            encode_context_unsigned(&apdu[apdu_len], 2,
+            cov_subscription->propertyArrayIndex);
+        apdu_len += len;
+    }
     /* MonitoredPropertyReference [1] - closing */
     len = encode_closing_tag(&apdu[apdu_len], 1);
     apdu_len += len;
@@ -303,21 +820,20 @@ static int cov_encode_subscription(
         encode_context_unsigned(&apdu[apdu_len], 3,
         cov_subscription->lifetime);
     apdu_len += len;
+    /* COVIncrement [4] REAL OPTIONAL */
+    if (cov_subscription->flag.covIncrementPresent) {
+        len =
+            encode_context_real(&apdu[apdu_len], 4,
+            cov_subscription->covIncrement);
+        apdu_len += len;
+    }
 
     return apdu_len;
 }
 
 unsigned num_active_cov_subscriptions(void)
 {
-	unsigned index;
-	unsigned count = 0;
-	for(index=0; index<MAX_COV_SUBCRIPTIONS; index++)
-	{
-		if(COV_Subscriptions[index].flag.valid)
-			count++;
-	}
-	
-	return count;
+	return COV_Subscription_Count;
 }
 
 /** Handle a request to list all the COV subscriptions.
@@ -367,7 +883,7 @@ void handler_cov_init(
 
     for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
         COV_Subscriptions[index].flag.valid = false;
-        COV_Subscriptions[index].dest_index = (uint8_t)(-1);
+        COV_Subscriptions[index].dest_index = COV_NONE;
         COV_Subscriptions[index].subscriberProcessIdentifier = 0;
         COV_Subscriptions[index].monitoredObjectIdentifier.type =
             OBJECT_ANALOG_INPUT;
@@ -376,9 +892,68 @@ void handler_cov_init(
         COV_Subscriptions[index].invokeID = 0;
         COV_Subscriptions[index].lifetime = 0;
         COV_Subscriptions[index].flag.send_requested = false;
+        COV_Subscription_Expired[index] = 0;
+        COV_Subscriptions[index].flag.by_value = false;
+        COV_Subscriptions[index].flag.covIncrementPresent = false;
+        COV_Subscriptions[index].monitoredProperty = PROP_ALL;
+        COV_Subscriptions[index].propertyArrayIndex = BACNET_ARRAY_ALL;
+        COV_Subscriptions[index].holdoff = 0;
+        COV_Subscriptions[index].next = (uint16_t) (index + 1);
+        COV_Object_Lists[index] = COV_NONE;
     }
+    COV_Subscriptions[MAX_COV_SUBCRIPTIONS - 1].next = COV_NONE;
+    COV_Free_List = 0;
+    COV_Subscription_Count = 0;
+    COV_Expired = false;
     for (index = 0; index < MAX_COV_ADDRESSES; index++) {
         COV_Addresses[index].valid = false;
+        COV_Addresses[index].references = 0;
+        COV_Addresses[index].outstanding = 0;
+        COV_Addresses[index].next = (uint16_t) (index + 1);
+        COV_Address_Lists[index] = COV_NONE;
+    }
+    COV_Addresses[MAX_COV_ADDRESSES - 1].next = COV_NONE;
+    COV_Address_Free_List = 0;
+    COV_Address_Turn = 0;
+    core_util_critical_section_enter();
+    COV_Changed_First = 0;
+    COV_Changed_Count = 0;
+    COV_Changed_Overflow = false;
+    core_util_critical_section_exit();
+    COV_Pending = false;
+    COV_Holdoff = false;
+    COV_Suppressed = 0;
+}
+
+/**
+ * Sets the COV increment of a subscription and how its monitored
+ * property is compared. The present value of an object that reports
+ * its own changes, without a COV increment of the subscriber, is left
+ * to the object, like for SubscribeCOV. Any other property is compared
+ * by value, from now on.
+ *
+ * @param  index - offset into COV subscription list
+ * @param  cov_data - the subscription request
+ */
+static void cov_subscription_increment(
+    unsigned index,
+    BACNET_SUBSCRIBE_COV_DATA * cov_data)
+{
+    BACNET_COV_SUBSCRIPTION *subscription = &COV_Subscriptions[index];
+
+    subscription->flag.covIncrementPresent = cov_data->covIncrementPresent;
+    subscription->covIncrement =
+        cov_data->covIncrementPresent ? cov_data->covIncrement : 0.0f;
+    if ((subscription->monitoredProperty == PROP_ALL) ||
+        ((subscription->monitoredProperty == PROP_PRESENT_VALUE) &&
+            (subscription->propertyArrayIndex == BACNET_ARRAY_ALL) &&
+            !subscription->flag.covIncrementPresent &&
+            Device_Value_List_Supported((BACNET_OBJECT_TYPE)
+                subscription->monitoredObjectIdentifier.type))) {
+        subscription->flag.by_value = false;
+    } else {
+        subscription->flag.by_value = true;
+        cov_property_check(index, true);
     }
 }
 
@@ -388,102 +963,103 @@ static bool cov_list_subscribe(
     BACNET_ERROR_CLASS * error_class,
     BACNET_ERROR_CODE * error_code)
 {
-    bool existing_entry = false;
-    int index;
-    int first_invalid_index = -1;
+    uint32_t object_type = cov_data->monitoredObjectIdentifier.type;
+    uint32_t object_instance = cov_data->monitoredObjectIdentifier.instance;
+    unsigned index = COV_NONE;
+    int new_index = -1;
     bool found = true;
     bool address_match = false;
     BACNET_ADDRESS *dest = NULL;
 
-    /* unable to subscribe - resources? */
-    /* unable to cancel subscription - other? */
-
     /* existing? - match Object ID and Process ID and address */
-    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
-        if (COV_Subscriptions[index].flag.valid) {
-            dest = cov_address_get(COV_Subscriptions[index].dest_index);
-            if (dest) {
-                address_match = bacnet_address_same(src, dest);
-            } else {
-                /* skip address matching - we don't have an address */
-                address_match = true;
-            }
-            if ((COV_Subscriptions[index].monitoredObjectIdentifier.type ==
-                    cov_data->monitoredObjectIdentifier.type) &&
-                (COV_Subscriptions[index].monitoredObjectIdentifier.instance ==
-                    cov_data->monitoredObjectIdentifier.instance) &&
-                (COV_Subscriptions[index].subscriberProcessIdentifier ==
-                    cov_data->subscriberProcessIdentifier) && address_match) {
-                existing_entry = true;
-                if (cov_data->cancellationRequest) {
-                    COV_Subscriptions[index].flag.valid = false;
-                    COV_Subscriptions[index].dest_index = (uint8_t)(-1);
-                    cov_address_remove_unused();
-                } else {
-                    COV_Subscriptions[index].dest_index = cov_address_add(src);
-                    COV_Subscriptions[index].flag.issueConfirmedNotifications =
-                        cov_data->issueConfirmedNotifications;
-                    COV_Subscriptions[index].lifetime = cov_data->lifetime;
-                    COV_Subscriptions[index].flag.send_requested = true;
-                }
-                if (COV_Subscriptions[index].invokeID) {
-                    tsm_free_invoke_id(COV_Subscriptions[index].invokeID);
-                    COV_Subscriptions[index].invokeID = 0;
-                }
-                break;
-            }
+    for (index = *cov_object_list(object_type, object_instance);
+        index != COV_NONE; index = COV_Subscriptions[index].next) {
+        if (!cov_object_same(index, object_type, object_instance) ||
+            (COV_Subscriptions[index].subscriberProcessIdentifier !=
+                cov_data->subscriberProcessIdentifier) ||
+            (COV_Subscriptions[index].monitoredProperty !=
+                cov_data->monitoredProperty.propertyIdentifier) ||
+            (COV_Subscriptions[index].propertyArrayIndex !=
+                cov_data->monitoredProperty.propertyArrayIndex)) {
+            continue;
+        }
+        dest = cov_address_get(COV_Subscriptions[index].dest_index);
+        if (dest) {
+            address_match = bacnet_address_same(src, dest);
         } else {
-            if (first_invalid_index < 0) {
-                first_invalid_index = index;
-            }
+            /* skip address matching - we don't have an address */
+            address_match = true;
+        }
+        if (address_match) {
+            break;
         }
     }
-    if (!existing_entry && (first_invalid_index >= 0) &&
-        (!cov_data->cancellationRequest)) {
-        index = first_invalid_index;
-        found = true;
-        COV_Subscriptions[index].flag.valid = true;
-        COV_Subscriptions[index].dest_index = cov_address_add(src);
-        COV_Subscriptions[index].monitoredObjectIdentifier.type =
-            cov_data->monitoredObjectIdentifier.type;
-        COV_Subscriptions[index].monitoredObjectIdentifier.instance =
-            cov_data->monitoredObjectIdentifier.instance;
-        COV_Subscriptions[index].subscriberProcessIdentifier =
-            cov_data->subscriberProcessIdentifier;
-        COV_Subscriptions[index].flag.issueConfirmedNotifications =
-            cov_data->issueConfirmedNotifications;
-        COV_Subscriptions[index].invokeID = 0;
-        COV_Subscriptions[index].lifetime = cov_data->lifetime;
-        COV_Subscriptions[index].flag.send_requested = true;
-    } else if (!existing_entry) {
-        if (first_invalid_index < 0) {
+    if (index != COV_NONE) {
+        if (cov_data->cancellationRequest) {
+            cov_subscription_remove(index);
+        } else {
+            cov_confirmed_release(index, false);
+            if (!dest) {
+                COV_Subscriptions[index].dest_index = cov_address_add(src);
+            }
+            COV_Subscriptions[index].flag.issueConfirmedNotifications =
+                cov_data->issueConfirmedNotifications;
+            COV_Subscriptions[index].lifetime = cov_data->lifetime;
+            COV_Subscription_Expired[index] = 0;
+            cov_subscription_increment(index, cov_data);
+            COV_Subscriptions[index].flag.send_requested = true;
+            COV_Pending = true;
+        }
+    } else if (!cov_data->cancellationRequest) {
+        new_index = cov_subscription_add(object_type, object_instance);
+        if (new_index < 0) {
             /* Out of resources */
             *error_class = ERROR_CLASS_RESOURCES;
             *error_code = ERROR_CODE_NO_SPACE_TO_ADD_LIST_ELEMENT;
             found = false;
         } else {
-            /* cancellationRequest - valid object not subscribed */
-            /* From BACnet Standard 135-2010-13.14.2
-               ...Cancellations that are issued for which no matching COV
-               context can be found shall succeed as if a context had
-               existed, returning 'Result(+)'. */
-            found = true;
+            index = (unsigned) new_index;
+            COV_Subscriptions[index].dest_index = cov_address_add(src);
+            COV_Subscriptions[index].subscriberProcessIdentifier =
+                cov_data->subscriberProcessIdentifier;
+            COV_Subscriptions[index].flag.issueConfirmedNotifications =
+                cov_data->issueConfirmedNotifications;
+            COV_Subscriptions[index].invokeID = 0;
+            COV_Subscriptions[index].lifetime = cov_data->lifetime;
+            COV_Subscriptions[index].monitoredProperty =
+                cov_data->monitoredProperty.propertyIdentifier;
+            COV_Subscriptions[index].propertyArrayIndex =
+                cov_data->monitoredProperty.propertyArrayIndex;
+            cov_subscription_increment(index, cov_data);
+            COV_Subscriptions[index].flag.send_requested = true;
+            COV_Pending = true;
         }
     }
+    /* else cancellationRequest - valid object not subscribed */
+    /* From BACnet Standard 135-2010-13.14.2
+       ...Cancellations that are issued for which no matching COV
+       context can be found shall succeed as if a context had
+       existed, returning 'Result(+)'. */
+    if (found) {
+        COV_Store_Dirty = true;
+    }
 
     return found;
 }
 
 static bool cov_send_request(
     BACNET_COV_SUBSCRIPTION * cov_subscription,
-    BACNET_PROPERTY_VALUE * value_list)
+    uint8_t * values,
+    unsigned values_len)
 {
     int len = 0;
     int pdu_len = 0;
     BACNET_NPDU_DATA npdu_data;
     BACNET_ADDRESS my_address;
     int bytes_sent = 0;
-//    uint8_t invoke_id = 0;
+#if (MAX_TSM_TRANSACTIONS)
+    uint8_t invoke_id = 0;
+#endif
     bool status = false;        /* return value */
     BACNET_COV_DATA cov_data;
     BACNET_ADDRESS *dest = NULL;
@@ -523,29 +1099,56 @@ static bool cov_send_request(
     cov_data.monitoredObjectIdentifier.instance =
         cov_subscription->monitoredObjectIdentifier.instance;
     cov_data.timeRemaining = cov_subscription->lifetime;
-    cov_data.listOfValues = value_list;
-//    if (cov_subscription->flag.issueConfirmedNotifications) {
-//        npdu_data.data_expecting_reply = true;
-//        invoke_id = tsm_next_free_invokeID();
-//        if (invoke_id) {
-//            cov_subscription->invokeID = invoke_id;
-//            len =
-//                ccov_notify_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
-//                invoke_id, &cov_data);
-//        } else {
-//            goto COV_FAILED;
-//        }
-//    } else {
+    /* the list of values is encoded already */
+    cov_data.listOfValues = NULL;
+#if (MAX_TSM_TRANSACTIONS)
+    if (cov_subscription->flag.issueConfirmedNotifications) {
+        npdu_data.data_expecting_reply = true;
+        /* the NPDU was encoded before we knew a reply is expected */
+        pdu_len =
+            npdu_encode_pdu(&Handler_Transmit_Buffer[0], dest,
+            &my_address, &npdu_data);
+        invoke_id = tsm_next_free_invokeID();
+        if (invoke_id) {
+            len =
+                ccov_notify_encode_apdu_values(&Handler_Transmit_Buffer
+                [pdu_len], invoke_id, &cov_data, values, values_len);
+        } else {
+            goto COV_FAILED;
+        }
+    } else
+#endif
+    {
         len =
-            ucov_notify_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
-            &cov_data);
-//    }
+            ucov_notify_encode_apdu_values(&Handler_Transmit_Buffer
+            [pdu_len], &cov_data, values, values_len);
+    }
+    if (len > peercap_max_apdu(dest)) {
+        /* the subscriber does not accept an APDU this long, and we do
+           not segment: drop the notification rather than trying again
+           every pass, the next change goes out if it fits */
+        EVRECORD2(BACNET_H_COV_NOTIF_TOO_LARGE, len, peercap_max_apdu(dest));
+#if (MAX_TSM_TRANSACTIONS)
+        if (invoke_id) {
+            tsm_free_invoke_id(invoke_id);
+        }
+#endif
+        return true;
+    }
     pdu_len += len;
-//    if (cov_subscription->flag.issueConfirmedNotifications) {
-//        tsm_set_confirmed_unsegmented_transaction(invoke_id,
-//            dest, &npdu_data, &Handler_Transmit_Buffer[0],
-//            (uint16_t) pdu_len);
-//    }
+#if (MAX_TSM_TRANSACTIONS)
+    if (invoke_id) {
+        /* the TSM retransmits it until the subscriber acknowledges */
+        tsm_set_confirmed_unsegmented_transaction(invoke_id,
+            dest, &npdu_data, &Handler_Transmit_Buffer[0],
+            (uint16_t) pdu_len);
+        cov_subscription->invokeID = invoke_id;
+        COV_Addresses[cov_subscription->dest_index].outstanding++;
+        COV_Addresses[cov_subscription->dest_index].confirmed_sent++;
+        /* retries are up to the TSM, a lost first try is not a failure */
+        status = true;
+    }
+#endif
     bytes_sent =
         datalink_send_pdu(dest, &npdu_data,
         &Handler_Transmit_Buffer[0], pdu_len);
@@ -557,8 +1160,10 @@ static bool cov_send_request(
 #endif
     }
 
-//  COV_FAILED:
-		
+#if (MAX_TSM_TRANSACTIONS)
+  COV_FAILED:
+#endif
+
     return status;
 }
 
@@ -590,15 +1195,10 @@ static void cov_lifetime_expiration_handler(
             H_DEBUG_VMSG("time remaining=%u seconds ",
                 COV_Subscriptions[index].lifetime);
 #endif
-            COV_Subscriptions[index].flag.valid = false;
-            COV_Subscriptions[index].dest_index = (uint8_t)(-1);
-            cov_address_remove_unused();
-            if (COV_Subscriptions[index].flag.issueConfirmedNotifications) {
-                if (COV_Subscriptions[index].invokeID) {
-                    tsm_free_invoke_id(COV_Subscriptions[index].invokeID);
-                    COV_Subscriptions[index].invokeID = 0;
-                }
-            }
+            /* the timer may interrupt the task while it walks the
+               lists, so the task removes the subscription */
+            COV_Subscription_Expired[index] = 1;
+            COV_Expired = true;
         }
     }
 }
@@ -631,6 +1231,8 @@ void handler_cov_timer_seconds(
     uint32_t lifetime_seconds = 0;
 
     if (elapsed_seconds) {
+        COV_Store_Holdoff = (COV_Store_Holdoff > elapsed_seconds) ?
+            COV_Store_Holdoff - elapsed_seconds : 0;
         /* handle the subscription timeouts */
         for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
             if (COV_Subscriptions[index].flag.valid) {
@@ -645,215 +1247,913 @@ void handler_cov_timer_seconds(
     }
 }
 
-void handler_cov_task(void)
+/* the min interval between the notifications of an object */
+static uint16_t cov_min_interval(
+    uint32_t object_type,
+    uint32_t object_instance)
 {
-    static int index = 0;
-    BACNET_OBJECT_TYPE object_type = MAX_BACNET_OBJECT_TYPE;
-    uint32_t object_instance = 0;
-    bool status = false;
-    bool send = false;
-    BACNET_PROPERTY_VALUE value_list[2];
+    uint16_t min_interval = COV_MIN_INTERVAL_MS;
+    unsigned i = 0;
 
-    /* states for transmitting */
-    static enum
-    {
-        COV_STATE_IDLE = 0,
-        COV_STATE_MARK,
-        COV_STATE_CLEAR,
-        COV_STATE_FREE,
-        COV_STATE_SEND
-    } cov_task_state = COV_STATE_IDLE;
-
-    switch (cov_task_state)
-    {
-      case COV_STATE_IDLE:
-        index = 0;
-        cov_task_state = COV_STATE_MARK;
-        break;
-    
-      case COV_STATE_MARK:
-        /* mark any subscriptions where the value has changed */
-        if (COV_Subscriptions[index].flag.valid)
-        {
-            object_type     = (BACNET_OBJECT_TYPE)COV_Subscriptions[index].monitoredObjectIdentifier.type;
-            object_instance = COV_Subscriptions[index].monitoredObjectIdentifier.instance;
-            status = Device_COV(object_type, object_instance);
-          
-            if (status)
-            {
-              COV_Subscriptions[index].flag.send_requested = true;
-              
-              #if PRINT_ENABLED
-                H_DEBUG_VMSG("COVtask: Marking...");
-              #endif
-            }
+    core_util_critical_section_enter();
+    for (i = 0; i < MAX_COV_RATE_LIMITS; i++) {
+        if (COV_Rate_Limits[i].valid &&
+            (COV_Rate_Limits[i].object.type == object_type) &&
+            (COV_Rate_Limits[i].object.instance == object_instance)) {
+            min_interval = COV_Rate_Limits[i].minInterval;
+            break;
         }
-        
-        index++;
-        
-        if (index >= MAX_COV_SUBCRIPTIONS)
-        {
-            index = 0;
-            cov_task_state = COV_STATE_CLEAR;
-        }
-        break;
-      
-      case COV_STATE_CLEAR:
-        /* clear the COV flag after checking all subscriptions */
-        if ((COV_Subscriptions[index].flag.valid) &&
-            (COV_Subscriptions[index].flag.send_requested))
-        {
-            object_type = (BACNET_OBJECT_TYPE)
-                              COV_Subscriptions[index]
-                                  .monitoredObjectIdentifier.type;
-            object_instance =
-                COV_Subscriptions[index].monitoredObjectIdentifier.instance;
-            Device_COV_Clear(object_type, object_instance);
-        }
-        index++;
-        if (index >= MAX_COV_SUBCRIPTIONS)
-        {
-            index = 0;
-            cov_task_state = COV_STATE_FREE;
-        }
-        break;
-        
-      case COV_STATE_FREE:
-            /* confirmed notification house keeping */
-//            if ((COV_Subscriptions[index].flag.valid) &&
-//                (COV_Subscriptions[index].flag.issueConfirmedNotifications) &&
-//                (COV_Subscriptions[index].invokeID)) {
-//                if (tsm_invoke_id_free(COV_Subscriptions[index].invokeID)) {
-//                    COV_Subscriptions[index].invokeID = 0;
-//                } else
-//                    if (tsm_invoke_id_failed(COV_Subscriptions
-//                        [index].invokeID)) {
-//                    tsm_free_invoke_id(COV_Subscriptions[index].invokeID);
-//                    COV_Subscriptions[index].invokeID = 0;
-//                }
-//            }
-        index++;
-        if (index >= MAX_COV_SUBCRIPTIONS)
-        {
-            index = 0;
-            cov_task_state = COV_STATE_SEND;
-        }
-        break;
-        
-      case COV_STATE_SEND:
-        /* send any COVs that are requested */
-        if ((COV_Subscriptions[index].flag.valid) &&
-            (COV_Subscriptions[index].flag.send_requested))
-        {
-          send = true;
-//                if (COV_Subscriptions[index].flag.issueConfirmedNotifications) {
-//                    if (COV_Subscriptions[index].invokeID != 0) {
-//                        /* already sending */
-//                        send = false;
-//                    }
-//                    if (!tsm_transaction_available()) {
-//                        /* no transactions available - can't send now */
-//                        send = false;
-//                    }
-//                }
-          if (send)
-          {
-              object_type = (BACNET_OBJECT_TYPE)
-                                COV_Subscriptions[index]
-                                    .monitoredObjectIdentifier.type;
-              object_instance =
-                  COV_Subscriptions[index].monitoredObjectIdentifier.instance;
-          
-              EVRECORD2(BACNET_H_COV_NOTIF_SENDING,
-                        COV_Subscriptions[index].monitoredObjectIdentifier.type,
-                        COV_Subscriptions[index].monitoredObjectIdentifier.instance);
-
-            #if PRINT_ENABLED
-              H_DEBUG_VMSG("COVtask: Sending...");
-            #endif
-            
-            /* configure the linked list for the two properties */
-            value_list[0].next = &value_list[1];
-            value_list[1].next = NULL;
-            (void)Device_Encode_Value_List(object_type, object_instance, &value_list[0]);
-            status = cov_send_request(&COV_Subscriptions[index], &value_list[0]);
-            
-            if (status)
-            { COV_Subscriptions[index].flag.send_requested = false; }
-          }
-        }
-        
-        index++;
-        
-        if (index >= MAX_COV_SUBCRIPTIONS)
-        {
-            index = 0;
-            cov_task_state = COV_STATE_IDLE;
-        }
-        break;
-        
-    default:
-        index = 0;
-        cov_task_state = COV_STATE_IDLE;
-        break;
     }
+    core_util_critical_section_exit();
 
-    return;
+    return min_interval;
 }
 
-static bool cov_subscribe(
-    BACNET_ADDRESS * src,
-    BACNET_SUBSCRIBE_COV_DATA * cov_data,
-    BACNET_ERROR_CLASS * error_class,
-    BACNET_ERROR_CODE * error_code)
+/** Sets the min interval between two COV notifications of an object.
+ * @ingroup DSCOV
+ * A noisy object is given a longer interval, an object whose every
+ * change matters a shorter one, or 0 to send each change at once.
+ * Each subscription of the object waits the interval after it sent a
+ * notification; the value sent then is the latest one. Objects without
+ * an interval of their own use COV_MIN_INTERVAL_MS. Can be called from
+ * any thread.
+ *
+ * @param object_type [in] The type of the object.
+ * @param object_instance [in] The instance of the object.
+ * @param milliseconds [in] The min interval.
+ * @return false if MAX_COV_RATE_LIMITS objects have an interval already.
+ */
+bool handler_cov_min_interval_set(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    uint16_t milliseconds)
 {
-    bool status = false;        /* return value */
-    BACNET_OBJECT_TYPE object_type = MAX_BACNET_OBJECT_TYPE;
-    uint32_t object_instance = 0;
+    BACNET_COV_RATE_LIMIT *limit = NULL;
+    unsigned i = 0;
 
-    object_type =
-        (BACNET_OBJECT_TYPE) cov_data->monitoredObjectIdentifier.type;
-    object_instance = cov_data->monitoredObjectIdentifier.instance;
-    status = Device_Valid_Object_Id(object_type, object_instance);
-    if (status) {
-        status = Device_Value_List_Supported(object_type);
-        if (status) {
-            status =
-                cov_list_subscribe(src, cov_data, error_class, error_code);
-        } else {
-            *error_class = ERROR_CLASS_OBJECT;
-            *error_code = ERROR_CODE_OPTIONAL_FUNCTIONALITY_NOT_SUPPORTED;
+    core_util_critical_section_enter();
+    for (i = 0; i < MAX_COV_RATE_LIMITS; i++) {
+        if (COV_Rate_Limits[i].valid) {
+            if ((COV_Rate_Limits[i].object.type == object_type) &&
+                (COV_Rate_Limits[i].object.instance == object_instance)) {
+                limit = &COV_Rate_Limits[i];
+                break;
+            }
+        } else if (!limit) {
+            limit = &COV_Rate_Limits[i];
         }
-    } else {
-        *error_class = ERROR_CLASS_OBJECT;
-        *error_code = ERROR_CODE_UNKNOWN_OBJECT;
     }
+    if (limit) {
+        limit->object.type = object_type;
+        limit->object.instance = object_instance;
+        limit->minInterval = milliseconds;
+        /* the default needs no entry */
+        limit->valid = (milliseconds != COV_MIN_INTERVAL_MS);
+    }
+    core_util_critical_section_exit();
 
-    return status;
+    return (limit != NULL) || (milliseconds == COV_MIN_INTERVAL_MS);
 }
 
-/** Handler for a COV Subscribe Service request.
+/** Counts down the min interval of the subscriptions that sent a
+ * notification recently.
  * @ingroup DSCOV
- * This handler will be invoked by apdu_handler() if it has been enabled
- * by a call to apdu_set_confirmed_handler().
- * This handler builds a response packet, which is
- * - an Abort if
- *   - the message is segmented
- *   - if decoding fails
- * - an ACK, if cov_subscribe() succeeds
- * - an Error if cov_subscribe() fails
+ * Called from the BACnet task, like handler_cov_task().
  *
- * @param service_request [in] The contents of the service request.
- * @param service_len [in] The length of the service_request.
- * @param src [in] BACNET_ADDRESS of the source of the message
- * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
- *                          decoded from the APDU header of this message.
+ * @param milliseconds [in] The time since the last call.
  */
-void handler_cov_subscribe(
+void handler_cov_timer_milliseconds(
+    uint16_t milliseconds)
+{
+    unsigned index = 0;
+
+    if (!COV_Holdoff) {
+        return;
+    }
+    COV_Holdoff = false;
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if (COV_Subscriptions[index].holdoff > milliseconds) {
+            COV_Subscriptions[index].holdoff -= milliseconds;
+            COV_Holdoff = true;
+        } else {
+            COV_Subscriptions[index].holdoff = 0;
+        }
+    }
+}
+
+/** Gets the number of COV notifications that were not sent, because a
+ * newer change of the object was merged into a notification that was
+ * still pending, e.g. during the min interval of the subscription.
+ * @ingroup DSCOV
+ *
+ * @return the count since handler_cov_init()
+ */
+uint32_t handler_cov_suppressed_count(
+    void)
+{
+    return COV_Suppressed;
+}
+
+/* requests a notification of a subscription, the latest value is sent
+   once it can be */
+static void cov_notification_request(
+    unsigned index)
+{
+    if (COV_Subscriptions[index].flag.send_requested) {
+        /* merged into the notification still pending */
+        COV_Suppressed++;
+    }
+    COV_Subscriptions[index].flag.send_requested = true;
+    COV_Pending = true;
+}
+
+/* queues an object, or adds to what is queued for it */
+static void cov_changed_add(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    bool value_changed)
+{
+    unsigned i = 0;
+    BACNET_COV_CHANGED *changed = NULL;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < COV_Changed_Count; i++) {
+        changed =
+            &COV_Changed[(COV_Changed_First + i) % MAX_COV_CHANGED_OBJECTS];
+        if ((changed->object.type == object_type) &&
+            (changed->object.instance == object_instance)) {
+            changed->value_changed |= value_changed;
+            break;
+        }
+    }
+    if (i == COV_Changed_Count) {
+        if (COV_Changed_Count < MAX_COV_CHANGED_OBJECTS) {
+            changed =
+                &COV_Changed[(COV_Changed_First +
+                    COV_Changed_Count) % MAX_COV_CHANGED_OBJECTS];
+            changed->object.type = object_type;
+            changed->object.instance = object_instance;
+            changed->value_changed = value_changed;
+            COV_Changed_Count++;
+        } else {
+            COV_Changed_Overflow = true;
+        }
+    }
+    core_util_critical_section_exit();
+}
+
+/** Queues an object whose value has changed, so its subscribers are
+ * notified by the next handler_cov_task().
+ * @ingroup DSCOV
+ * Called by the objects when a change is to be reported by COV, from
+ * any thread. An object already waiting in the queue is not added again.
+ *
+ * @param object_type [in] The type of the object.
+ * @param object_instance [in] The instance of the object.
+ */
+void handler_cov_object_changed(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    cov_changed_add(object_type, object_instance, true);
+}
+
+/** Queues an object that has been written, so the next
+ * handler_cov_task() compares the properties monitored by
+ * SubscribeCOVProperty with their last notified values.
+ * @ingroup DSCOV
+ *
+ * @param object_type [in] The type of the object.
+ * @param object_instance [in] The instance of the object.
+ */
+void handler_cov_object_written(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    cov_changed_add(object_type, object_instance, false);
+}
+
+/* takes the oldest object of the queue, false if it is empty */
+static bool cov_changed_take(
+    BACNET_COV_CHANGED * changed)
+{
+    bool status = false;
+
+    core_util_critical_section_enter();
+    if (COV_Changed_Count) {
+        *changed = COV_Changed[COV_Changed_First];
+        COV_Changed_First = (COV_Changed_First + 1) % MAX_COV_CHANGED_OBJECTS;
+        COV_Changed_Count--;
+        status = true;
+    }
+    core_util_critical_section_exit();
+
+    return status;
+}
+
+/* Removes the subscriptions of an object, and the object from the
+   queue of changed objects. Called from the BACnet task only. */
+static void cov_object_remove(
+    uint32_t object_type,
+    uint32_t object_instance)
+{
+    BACNET_COV_CHANGED *changed = NULL;
+    unsigned index = 0;
+    unsigned next = 0;
+    unsigned kept = 0;
+    unsigned i = 0;
+
+    for (index = *cov_object_list(object_type, object_instance);
+        index != COV_NONE; index = next) {
+        next = COV_Subscriptions[index].next;
+        if (cov_object_same(index, object_type, object_instance)) {
+            cov_subscription_remove(index);
+            COV_Store_Dirty = true;
+        }
+    }
+    core_util_critical_section_enter();
+    for (i = 0; i < COV_Changed_Count; i++) {
+        changed =
+            &COV_Changed[(COV_Changed_First + i) % MAX_COV_CHANGED_OBJECTS];
+        if ((changed->object.type != object_type) ||
+            (changed->object.instance != object_instance)) {
+            COV_Changed[(COV_Changed_First +
+                    kept) % MAX_COV_CHANGED_OBJECTS] = *changed;
+            kept++;
+        }
+    }
+    COV_Changed_Count = kept;
+    core_util_critical_section_exit();
+}
+
+/** Removes the subscriptions of an object that has been deleted, and
+ * its changes that wait to be notified.
+ * @ingroup DSCOV
+ * Called by Device_Delete_Object(), from the BACnet task.
+ *
+ * @param object_type [in] The type of the object.
+ * @param object_instance [in] The instance of the object.
+ */
+void handler_cov_object_deleted(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    cov_object_remove(object_type, object_instance);
+}
+
+/* requests a notification from each subscription of a changed object
+   that is affected by the change */
+static void cov_changed_mark(
+    BACNET_COV_CHANGED * changed)
+{
+    BACNET_OBJECT_ID *object = &changed->object;
+    unsigned index = 0;
+
+    /* cleared first: a change from now on queues the object again */
+    if (changed->value_changed) {
+        Device_COV_Clear((BACNET_OBJECT_TYPE) object->type,
+            object->instance);
+    }
+    for (index = *cov_object_list(object->type, object->instance);
+        index != COV_NONE; index = COV_Subscriptions[index].next) {
+        if (!cov_object_same(index, object->type, object->instance)) {
+            continue;
+        }
+        if (COV_Subscriptions[index].flag.by_value ?
+            cov_property_check(index, false) : changed->value_changed) {
+            cov_notification_request(index);
+        }
+    }
+}
+
+/* the queue overflowed, so changes are missing from it: asks each
+   subscribed object whether it changed */
+static void cov_changed_sweep(
+    void)
+{
+    unsigned index = 0;
+    BACNET_OBJECT_TYPE object_type = MAX_BACNET_OBJECT_TYPE;
+    uint32_t object_instance = 0;
+    bool changed = false;
+
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if (COV_Subscriptions[index].flag.valid) {
+            object_type = (BACNET_OBJECT_TYPE)
+                COV_Subscriptions[index].monitoredObjectIdentifier.type;
+            object_instance =
+                COV_Subscriptions[index].monitoredObjectIdentifier.instance;
+            if (COV_Subscriptions[index].flag.by_value) {
+                changed = cov_property_check(index, false);
+            } else {
+                changed = Device_COV(object_type, object_instance);
+            }
+            if (changed) {
+                cov_notification_request(index);
+            }
+        }
+    }
+    /* clear the COV flag after checking all subscriptions */
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if ((COV_Subscriptions[index].flag.valid) &&
+            (!COV_Subscriptions[index].flag.by_value) &&
+            (COV_Subscriptions[index].flag.send_requested)) {
+            Device_COV_Clear((BACNET_OBJECT_TYPE)
+                COV_Subscriptions[index].monitoredObjectIdentifier.type,
+                COV_Subscriptions[index].monitoredObjectIdentifier.instance);
+        }
+    }
+}
+
+#if (MAX_TSM_TRANSACTIONS)
+/* confirmed notification house keeping of a subscription */
+static void cov_confirmed_check(
+    unsigned index)
+{
+    unsigned dest_index = 0;
+
+    if (!COV_Subscriptions[index].invokeID) {
+        return;
+    }
+    if (tsm_invoke_id_free(COV_Subscriptions[index].invokeID)) {
+        /* acknowledged - the ack already freed the invoke id */
+        COV_Subscriptions[index].invokeID = 0;
+        dest_index = COV_Subscriptions[index].dest_index;
+        if ((dest_index < MAX_COV_ADDRESSES) &&
+            (COV_Addresses[dest_index].outstanding)) {
+            COV_Addresses[dest_index].outstanding--;
+        }
+    } else if (tsm_invoke_id_failed(COV_Subscriptions[index].invokeID)) {
+        cov_confirmed_release(index, true);
+        /* try again with the current value */
+        COV_Subscriptions[index].flag.send_requested = true;
+    }
+}
+#endif
+
+/* fills the value list of a SubscribeCOVProperty notification: the
+   monitored property and, if the object has them, its status flags */
+static void cov_send_property(
+    BACNET_COV_SUBSCRIPTION * cov_subscription,
+    BACNET_PROPERTY_VALUE * value_list)
+{
+    BACNET_READ_PROPERTY_DATA rpdata;
+    int len = 0;
+
+    value_list[0].propertyIdentifier = cov_subscription->monitoredProperty;
+    value_list[0].propertyArrayIndex = cov_subscription->propertyArrayIndex;
+    value_list[0].priority = BACNET_NO_PRIORITY;
+    value_list[0].value.context_specific = false;
+    value_list[0].value.tag = BACNET_APPLICATION_TAG_NULL;
+    value_list[0].value.next = NULL;
+    len =
+        cov_property_read(&cov_subscription->monitoredObjectIdentifier,
+        cov_subscription->monitoredProperty,
+        cov_subscription->propertyArrayIndex, &rpdata);
+    if (len > 0) {
+        (void) bacapp_decode_application_data(&COV_Value_Buffer[0],
+            (unsigned) len, &value_list[0].value);
+    }
+    if (cov_subscription->monitoredProperty == PROP_STATUS_FLAGS) {
+        value_list[0].next = NULL;
+        return;
+    }
+    value_list[1].propertyIdentifier = PROP_STATUS_FLAGS;
+    value_list[1].propertyArrayIndex = BACNET_ARRAY_ALL;
+    value_list[1].priority = BACNET_NO_PRIORITY;
+    value_list[1].value.next = NULL;
+    len =
+        cov_property_read(&cov_subscription->monitoredObjectIdentifier,
+        PROP_STATUS_FLAGS, BACNET_ARRAY_ALL, &rpdata);
+    if ((len <= 0) ||
+        (bacapp_decode_application_data(&COV_Value_Buffer[0],
+                (unsigned) len, &value_list[1].value) <= 0)) {
+        value_list[0].next = NULL;
+    }
+}
+
+/* true if the requested notification of a subscription can be sent now */
+static bool cov_send_ready(
+    unsigned index)
+{
+#if (MAX_TSM_TRANSACTIONS)
+    unsigned dest_index = COV_Subscriptions[index].dest_index;
+#endif
+
+    if (COV_Subscriptions[index].holdoff) {
+        /* min interval not over yet */
+        return false;
+    }
+#if (MAX_TSM_TRANSACTIONS)
+    if (COV_Subscriptions[index].flag.issueConfirmedNotifications) {
+        if (COV_Subscriptions[index].invokeID != 0) {
+            /* already sending - the latest value goes out later */
+            return false;
+        }
+        if ((dest_index < MAX_COV_ADDRESSES) &&
+            (COV_Addresses[dest_index].outstanding >=
+                MAX_COV_CONFIRMED_WINDOW)) {
+            /* window of the subscriber is full */
+            return false;
+        }
+        if (!tsm_transaction_available()) {
+            /* no transactions available - can't send now */
+            return false;
+        }
+        if (!tsm_window_available(cov_address_get(dest_index))) {
+            /* the subscriber is busy with our other requests */
+            return false;
+        }
+    }
+#endif
+
+    return true;
+}
+
+/* true if two subscriptions are notified with the same list of values */
+static bool cov_same_values(
+    unsigned index,
+    unsigned other)
+{
+    BACNET_COV_SUBSCRIPTION *a = &COV_Subscriptions[index];
+    BACNET_COV_SUBSCRIPTION *b = &COV_Subscriptions[other];
+
+    if (a->flag.by_value != b->flag.by_value) {
+        return false;
+    }
+    if (a->flag.by_value) {
+        return (a->monitoredProperty == b->monitoredProperty) &&
+            (a->propertyArrayIndex == b->propertyArrayIndex);
+    }
+
+    return true;
+}
+
+/* sends the notification of a subscription */
+static bool cov_send_one(
+    unsigned index,
+    uint8_t * values,
+    unsigned values_len)
+{
+    unsigned dest_index = COV_Subscriptions[index].dest_index;
+
+    if (!cov_send_request(&COV_Subscriptions[index], values, values_len)) {
+        return false;
+    }
+    COV_Subscriptions[index].flag.send_requested = false;
+    COV_Subscriptions[index].holdoff =
+        cov_min_interval(COV_Subscriptions[index].monitoredObjectIdentifier.
+        type, COV_Subscriptions[index].monitoredObjectIdentifier.instance);
+    if (COV_Subscriptions[index].holdoff) {
+        COV_Holdoff = true;
+    }
+    COV_Addresses[dest_index].notified++;
+    if (COV_Addresses[dest_index].backlog) {
+        COV_Addresses[dest_index].backlog--;
+    }
+
+    return true;
+}
+
+/* Sends the notification of a subscription, and of every other
+   subscription of the object that waits for the same values: the list
+   of values is encoded once, only the fields of each subscriber are
+   encoded per notification. Returns the notifications sent, at most
+   budget. The subscriptions of an object without values are removed. */
+static unsigned cov_send(
+    unsigned index,
+    unsigned budget)
+{
+    BACNET_OBJECT_TYPE object_type = MAX_BACNET_OBJECT_TYPE;
+    uint32_t object_instance = 0;
+    BACNET_PROPERTY_VALUE value_list[2];
+    unsigned values_len = 0;
+    unsigned other = 0;
+    unsigned count = 0;
+
+    object_type = (BACNET_OBJECT_TYPE)
+        COV_Subscriptions[index].monitoredObjectIdentifier.type;
+    object_instance =
+        COV_Subscriptions[index].monitoredObjectIdentifier.instance;
+
+    EVRECORD2(BACNET_H_COV_NOTIF_SENDING, object_type, object_instance);
+#if PRINT_ENABLED
+    H_DEBUG_VMSG("COVtask: Sending...");
+#endif
+
+    /* configure the linked list for the two properties */
+    value_list[0].next = &value_list[1];
+    value_list[1].next = NULL;
+    if (COV_Subscriptions[index].flag.by_value) {
+        cov_send_property(&COV_Subscriptions[index], &value_list[0]);
+    } else if (!Device_Encode_Value_List(object_type, object_instance,
+            &value_list[0])) {
+        /* the object is gone, there is nothing to notify any more */
+        cov_object_remove(object_type, object_instance);
+        return 0;
+    }
+    /* the values are decoded, so the buffer is free again */
+    values_len =
+        (unsigned) cov_notify_encode_values(&COV_Value_Buffer[0],
+        &value_list[0]);
+    if (cov_send_one(index, &COV_Value_Buffer[0], values_len)) {
+        count++;
+    }
+    for (other = *cov_object_list(object_type, object_instance);
+        (other != COV_NONE) && (count < budget);
+        other = COV_Subscriptions[other].next) {
+        if ((other != index) &&
+            cov_object_same(other, object_type, object_instance) &&
+            COV_Subscriptions[other].flag.send_requested &&
+            !COV_Subscription_Expired[other] &&
+            cov_same_values(index, other) && cov_send_ready(other) &&
+            cov_send_one(other, &COV_Value_Buffer[0], values_len)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/* removes the subscriptions whose lifetime ran out */
+static void cov_expired_remove(
+    void)
+{
+    unsigned index = 0;
+
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if ((COV_Subscriptions[index].flag.valid) &&
+            (COV_Subscription_Expired[index])) {
+            cov_subscription_remove(index);
+            COV_Store_Dirty = true;
+        }
+    }
+}
+
+/* writes the valid subscriptions to the store */
+static void cov_list_store(
+    void)
+{
+    BACNET_COV_STORE_HEADER *header = NULL;
+    BACNET_COV_STORE_RECORD *record = NULL;
+    BACNET_ADDRESS *dest = NULL;
+    uint8_t *buffer = NULL;
+    unsigned count = 0;
+    unsigned index = 0;
+
+    if (COV_Subscription_Count) {
+        buffer =
+            (uint8_t *) malloc(sizeof(BACNET_COV_STORE_HEADER) +
+            (COV_Subscription_Count * sizeof(BACNET_COV_STORE_RECORD)));
+        if (!buffer) {
+            /* try again later */
+            COV_Store_Holdoff = COV_STORE_INTERVAL;
+            return;
+        }
+        record =
+            (BACNET_COV_STORE_RECORD *) & buffer[sizeof
+            (BACNET_COV_STORE_HEADER)];
+        for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+            dest = cov_address_get(COV_Subscriptions[index].dest_index);
+            if (!COV_Subscriptions[index].flag.valid ||
+                COV_Subscription_Expired[index] || !dest ||
+                (count == COV_Subscription_Count)) {
+                continue;
+            }
+            memset(&record[count], 0, sizeof(BACNET_COV_STORE_RECORD));
+            bacnet_address_copy(&record[count].dest, dest);
+            record[count].subscriberProcessIdentifier =
+                COV_Subscriptions[index].subscriberProcessIdentifier;
+            record[count].lifetime = COV_Subscriptions[index].lifetime;
+            record[count].monitoredObjectIdentifier =
+                COV_Subscriptions[index].monitoredObjectIdentifier;
+            record[count].monitoredProperty =
+                COV_Subscriptions[index].monitoredProperty;
+            record[count].propertyArrayIndex =
+                COV_Subscriptions[index].propertyArrayIndex;
+            record[count].covIncrement =
+                COV_Subscriptions[index].covIncrement;
+            record[count].issueConfirmedNotifications =
+                COV_Subscriptions[index].flag.issueConfirmedNotifications;
+            record[count].covIncrementPresent =
+                COV_Subscriptions[index].flag.covIncrementPresent;
+            count++;
+        }
+        header = (BACNET_COV_STORE_HEADER *) buffer;
+        header->magic = COV_STORE_MAGIC;
+        header->record_size = sizeof(BACNET_COV_STORE_RECORD);
+        header->count = (uint16_t) count;
+        header->stored_time = (uint32_t) time(NULL);
+    }
+    if (cov_store_save(buffer, count ? sizeof(BACNET_COV_STORE_HEADER) +
+            (count * sizeof(BACNET_COV_STORE_RECORD)) : 0)) {
+        COV_Store_Dirty = false;
+    }
+    COV_Store_Holdoff = COV_STORE_INTERVAL;
+    free(buffer);
+}
+
+/** Restores the subscriptions stored before a restart.
+ * @ingroup DSCOV
+ * Called once after handler_cov_init(), when the objects exist. The
+ * time passed since the subscriptions were stored is taken from their
+ * lifetimes, see COV_STORE_INTERVAL. A restored subscription sends its
+ * initial notification like a new one, so the subscribers get the
+ * current values at once. Subscriptions of objects that are gone, and
+ * those whose lifetime ran out, are dropped.
+ */
+void handler_cov_restore(
+    void)
+{
+    BACNET_COV_STORE_HEADER header;
+    BACNET_COV_STORE_RECORD *record = NULL;
+    BACNET_SUBSCRIBE_COV_DATA cov_data;
+    BACNET_ERROR_CLASS error_class = ERROR_CLASS_OBJECT;
+    BACNET_ERROR_CODE error_code = ERROR_CODE_UNKNOWN_OBJECT;
+    uint8_t *buffer = NULL;
+    size_t size = 0;
+    uint32_t elapsed = 0;
+    uint32_t now = 0;
+    unsigned i = 0;
+
+    size = cov_store_size();
+    if (size < sizeof(BACNET_COV_STORE_HEADER)) {
+        return;
+    }
+    buffer = (uint8_t *) malloc(size);
+    if (!buffer) {
+        return;
+    }
+    if (cov_store_load(buffer, size)) {
+        memcpy(&header, buffer, sizeof(header));
+        if ((header.magic != COV_STORE_MAGIC) ||
+            (header.record_size != sizeof(BACNET_COV_STORE_RECORD)) ||
+            (size != sizeof(BACNET_COV_STORE_HEADER) +
+                (header.count * sizeof(BACNET_COV_STORE_RECORD)))) {
+            /* stored by another firmware */
+            header.count = 0;
+        }
+        now = (uint32_t) time(NULL);
+        if ((now != (uint32_t) -1) && (now > header.stored_time)) {
+            elapsed = now - header.stored_time;
+        }
+        record =
+            (BACNET_COV_STORE_RECORD *) & buffer[sizeof
+            (BACNET_COV_STORE_HEADER)];
+        for (i = 0; i < header.count; i++) {
+            if (!Device_Valid_Object_Id((BACNET_OBJECT_TYPE)
+                    record[i].monitoredObjectIdentifier.type,
+                    record[i].monitoredObjectIdentifier.instance)) {
+                continue;
+            }
+            if (record[i].lifetime) {
+                if (record[i].lifetime <= elapsed) {
+                    continue;
+                }
+                record[i].lifetime -= elapsed;
+            }
+            memset(&cov_data, 0, sizeof(cov_data));
+            cov_data.subscriberProcessIdentifier =
+                record[i].subscriberProcessIdentifier;
+            cov_data.monitoredObjectIdentifier =
+                record[i].monitoredObjectIdentifier;
+            cov_data.cancellationRequest = false;
+            cov_data.issueConfirmedNotifications =
+                record[i].issueConfirmedNotifications;
+            cov_data.lifetime = record[i].lifetime;
+            cov_data.monitoredProperty.propertyIdentifier =
+                (BACNET_PROPERTY_ID) record[i].monitoredProperty;
+            cov_data.monitoredProperty.propertyArrayIndex =
+                record[i].propertyArrayIndex;
+            cov_data.covIncrementPresent = record[i].covIncrementPresent;
+            cov_data.covIncrement = record[i].covIncrement;
+            (void) cov_list_subscribe(&record[i].dest, &cov_data,
+                &error_class, &error_code);
+        }
+    }
+    free(buffer);
+    /* the store holds these already, the lifetimes are counted from
+       the time it was stored */
+    COV_Store_Dirty = false;
+}
+
+/* how far a subscription is from the one its subscriber got last */
+static unsigned cov_turn_distance(
+    unsigned index,
+    unsigned dest_index)
+{
+    return (index + MAX_COV_SUBCRIPTIONS - 1 -
+        COV_Addresses[dest_index].cursor) % MAX_COV_SUBCRIPTIONS;
+}
+
+/* Finds the subscription of each subscriber that is next in turn, the
+   first ready one after the subscription notified last. Returns false
+   if no subscription is ready. */
+static bool cov_turns_find(
+    void)
+{
+    unsigned dest_index = 0;
+    unsigned index = 0;
+    unsigned next = 0;
+    bool found = false;
+
+    for (dest_index = 0; dest_index < MAX_COV_ADDRESSES; dest_index++) {
+        COV_Address_Next[dest_index] = COV_NONE;
+    }
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        dest_index = COV_Subscriptions[index].dest_index;
+        if (!COV_Subscriptions[index].flag.valid ||
+            !COV_Subscriptions[index].flag.send_requested ||
+            COV_Subscription_Expired[index] ||
+            !cov_address_get(dest_index) || !cov_send_ready(index)) {
+            continue;
+        }
+        next = COV_Address_Next[dest_index];
+        if ((next == COV_NONE) ||
+            (cov_turn_distance(index, dest_index) <
+                cov_turn_distance(next, dest_index))) {
+            COV_Address_Next[dest_index] = (uint16_t) index;
+        }
+        found = true;
+    }
+
+    return found;
+}
+
+/** Handler to send the notifications of changed objects.
+ * @ingroup DSCOV
+ * This handler will be invoked by the main program as often as possible.
+ * The objects queued by handler_cov_object_changed() mark their
+ * subscriptions right away, so a change is sent by the next call, no
+ * matter how many subscriptions there are. Without changes and without
+ * notifications waiting to be sent or confirmed, it returns at once.
+ *
+ * The subscribers take turns, one notification each, up to
+ * COV_SEND_BUDGET notifications per call. The subscriptions of a
+ * subscriber take turns as well, see handler_cov_subscriber_backlog()
+ * for the notifications that wait.
+ *
+ * @note worst case tasking: MS/TP with the ability to send only
+ *        one notification per task cycle, set COV_SEND_BUDGET to 1.
+ */
+void handler_cov_task(void)
+{
+    BACNET_COV_CHANGED changed;
+    unsigned budget = COV_SEND_BUDGET;
+    unsigned turn = 0;
+    unsigned dest_index = 0;
+    unsigned sent = 0;
+    bool overflow = false;
+    unsigned index = 0;
+    unsigned i = 0;
+
+    if (COV_Expired) {
+        COV_Expired = false;
+        cov_expired_remove();
+    }
+    if (COV_Store_Dirty && !COV_Store_Holdoff) {
+        cov_list_store();
+    }
+    while (cov_changed_take(&changed)) {
+        cov_changed_mark(&changed);
+    }
+    core_util_critical_section_enter();
+    overflow = COV_Changed_Overflow;
+    COV_Changed_Overflow = false;
+    core_util_critical_section_exit();
+    if (overflow) {
+        cov_changed_sweep();
+    }
+    if (!COV_Pending) {
+        return;
+    }
+    COV_Pending = false;
+    for (i = 0; i < MAX_COV_ADDRESSES; i++) {
+        COV_Addresses[i].backlog = 0;
+    }
+    for (index = 0; index < MAX_COV_SUBCRIPTIONS; index++) {
+        if (!COV_Subscriptions[index].flag.valid) {
+            continue;
+        }
+#if (MAX_TSM_TRANSACTIONS)
+        cov_confirmed_check(index);
+        if (COV_Subscriptions[index].invokeID) {
+            COV_Pending = true;
+        }
+#endif
+        dest_index = COV_Subscriptions[index].dest_index;
+        if (COV_Subscriptions[index].flag.send_requested &&
+            !COV_Subscription_Expired[index] &&
+            cov_address_get(dest_index)) {
+            COV_Pending = true;
+            COV_Addresses[dest_index].backlog++;
+            if (COV_Addresses[dest_index].backlog >
+                COV_Addresses[dest_index].backlog_peak) {
+                COV_Addresses[dest_index].backlog_peak =
+                    COV_Addresses[dest_index].backlog;
+            }
+        }
+    }
+    /* one notification for each subscriber in turn, and another round
+       while the budget lasts */
+    while (budget && cov_turns_find()) {
+        turn = COV_Address_Turn;
+        for (i = 0; (i < MAX_COV_ADDRESSES) && budget; i++) {
+            dest_index = (turn + i) % MAX_COV_ADDRESSES;
+            index = COV_Address_Next[dest_index];
+            if ((index == COV_NONE) ||
+                !COV_Subscriptions[index].flag.send_requested ||
+                !cov_send_ready(index)) {
+                /* nothing to send, or sent with the values of another */
+                continue;
+            }
+            sent = cov_send(index, budget);
+            if (!COV_Subscriptions[index].flag.valid) {
+                /* removed with its object */
+                continue;
+            }
+            if (!sent) {
+                /* try again with the next call */
+                return;
+            }
+            budget -= sent;
+            COV_Addresses[dest_index].cursor = (uint16_t) index;
+            COV_Address_Turn = (dest_index + 1) % MAX_COV_ADDRESSES;
+        }
+    }
+}
+
+/* a monitored property must read as one primitive value */
+static bool cov_property_valid(
+    BACNET_SUBSCRIBE_COV_DATA * cov_data,
+    BACNET_ERROR_CLASS * error_class,
+    BACNET_ERROR_CODE * error_code)
+{
+    BACNET_READ_PROPERTY_DATA rpdata;
+    int len = 0;
+
+    len =
+        cov_property_read(&cov_data->monitoredObjectIdentifier,
+        cov_data->monitoredProperty.propertyIdentifier,
+        cov_data->monitoredProperty.propertyArrayIndex, &rpdata);
+    if (len < 0) {
+        *error_class = rpdata.error_class;
+        *error_code = rpdata.error_code;
+        return false;
+    }
+    if ((len == 0) || IS_CONTEXT_SPECIFIC(COV_Value_Buffer[0]) ||
+        (bacapp_decode_application_data_len(&COV_Value_Buffer[0],
+                len) != len)) {
+        *error_class = ERROR_CLASS_PROPERTY;
+        *error_code = ERROR_CODE_NOT_COV_PROPERTY;
+        return false;
+    }
+
+    return true;
+}
+
+static bool cov_subscribe(
+    BACNET_ADDRESS * src,
+    BACNET_SUBSCRIBE_COV_DATA * cov_data,
+    BACNET_ERROR_CLASS * error_class,
+    BACNET_ERROR_CODE * error_code)
+{
+    bool status = false;        /* return value */
+    BACNET_OBJECT_TYPE object_type = MAX_BACNET_OBJECT_TYPE;
+    uint32_t object_instance = 0;
+
+    object_type =
+        (BACNET_OBJECT_TYPE) cov_data->monitoredObjectIdentifier.type;
+    object_instance = cov_data->monitoredObjectIdentifier.instance;
+    status = Device_Valid_Object_Id(object_type, object_instance);
+    if (status) {
+        if (cov_data->monitoredProperty.propertyIdentifier == PROP_ALL) {
+            status = Device_Value_List_Supported(object_type);
+            if (!status) {
+                *error_class = ERROR_CLASS_OBJECT;
+                *error_code = ERROR_CODE_OPTIONAL_FUNCTIONALITY_NOT_SUPPORTED;
+            }
+        } else if (!cov_data->cancellationRequest) {
+            status = cov_property_valid(cov_data, error_class, error_code);
+        }
+        if (status) {
+            status =
+                cov_list_subscribe(src, cov_data, error_class, error_code);
+        }
+    } else {
+        *error_class = ERROR_CLASS_OBJECT;
+        *error_code = ERROR_CODE_UNKNOWN_OBJECT;
+    }
+
+    return status;
+}
+
+/* SubscribeCOV and SubscribeCOVProperty differ only in the decoding */
+static void cov_subscribe_handler(
     uint8_t * service_request,
     uint16_t service_len,
     BACNET_ADDRESS * src,
-    BACNET_CONFIRMED_SERVICE_DATA * service_data)
+    BACNET_CONFIRMED_SERVICE_DATA * service_data,
+    BACNET_CONFIRMED_SERVICE service)
 {
     BACNET_SUBSCRIBE_COV_DATA cov_data;
     int len = 0;
@@ -886,9 +2186,20 @@ void handler_cov_subscribe(
         error = true;
         goto COV_ABORT;
     }
-    len =
-        cov_subscribe_decode_service_request(service_request, service_len,
-        &cov_data);
+    if (service == SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY) {
+        cov_data.covIncrementPresent = false;
+        len =
+            cov_subscribe_property_decode_service_request(service_request,
+            service_len, &cov_data);
+    } else {
+        len =
+            cov_subscribe_decode_service_request(service_request,
+            service_len, &cov_data);
+        /* the object as a whole */
+        cov_data.monitoredProperty.propertyIdentifier = PROP_ALL;
+        cov_data.monitoredProperty.propertyArrayIndex = BACNET_ARRAY_ALL;
+        cov_data.covIncrementPresent = false;
+    }
 #if PRINT_ENABLED
     if (len <= 0)
         H_DEBUG_MSG("SubscribeCOV: Unable to decode Request!");
@@ -906,7 +2217,7 @@ void handler_cov_subscribe(
     if (success) {
         apdu_len =
             encode_simple_ack(&Handler_Transmit_Buffer[npdu_len],
-            service_data->invoke_id, SERVICE_CONFIRMED_SUBSCRIBE_COV);
+            service_data->invoke_id, service);
 			
 				EVRECORD2(BACNET_H_COV_SENDING_SACK, 0, 0);
 			
@@ -936,7 +2247,7 @@ void handler_cov_subscribe(
         } else if (len == BACNET_STATUS_ERROR) {
             apdu_len =
                 bacerror_encode_apdu(&Handler_Transmit_Buffer[npdu_len],
-                service_data->invoke_id, SERVICE_CONFIRMED_SUBSCRIBE_COV,
+                service_data->invoke_id, service,
                 cov_data.error_class, cov_data.error_code);
 					
 					EVRECORD2(BACNET_H_COV_SENDING_ERROR, cov_data.error_code, 0);
@@ -961,6 +2272,9 @@ void handler_cov_subscribe(
     bytes_sent =
         datalink_send_pdu(src, &npdu_data, &Handler_Transmit_Buffer[0],
         pdu_len);
+    /* keep the reply in case the request is retransmitted */
+    apdu_response_cache_store(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
 		
 #if PRINT_ENABLED
     if (bytes_sent <= 0)
@@ -977,3 +2291,54 @@ void handler_cov_subscribe(
 		
     return;
 }
+
+/** Handler for a COV Subscribe Service request.
+ * @ingroup DSCOV
+ * This handler will be invoked by apdu_handler() if it has been enabled
+ * by a call to apdu_set_confirmed_handler().
+ * This handler builds a response packet, which is
+ * - an Abort if
+ *   - the message is segmented
+ *   - if decoding fails
+ * - an ACK, if cov_subscribe() succeeds
+ * - an Error if cov_subscribe() fails
+ *
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ *                          decoded from the APDU header of this message.
+ */
+void handler_cov_subscribe(
+    uint8_t * service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS * src,
+    BACNET_CONFIRMED_SERVICE_DATA * service_data)
+{
+    cov_subscribe_handler(service_request, service_len, src, service_data,
+        SERVICE_CONFIRMED_SUBSCRIBE_COV);
+}
+
+/** Handler for a SubscribeCOVProperty Service request.
+ * @ingroup DSCOV
+ * Like handler_cov_subscribe(), for one property of the object. The
+ * property must read as a single primitive value, else the request is
+ * refused with NOT_COV_PROPERTY. A numeric property is notified when it
+ * moved by the COV increment of the request, any other property when
+ * its value or the status flags of the object changed.
+ *
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ *                          decoded from the APDU header of this message.
+ */
+void handler_cov_subscribe_property(
+    uint8_t * service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS * src,
+    BACNET_CONFIRMED_SERVICE_DATA * service_data)
+{
+    cov_subscribe_handler(service_request, service_len, src, service_data,
+        SERVICE_CONFIRMED_SUBSCRIBE_COV_PROPERTY);
+}
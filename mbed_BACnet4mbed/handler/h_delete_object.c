@@ -0,0 +1,143 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "config_bacnet.h"
+#include "txbuf.h"
+#include "bacdef.h"
+#include "bacdcode.h"
+#include "bacerror.h"
+#include "apdu.h"
+#include "npdu.h"
+#include "abort.h"
+#include "delete_object.h"
+/* device object has the handling for all objects */
+#include "device_obj.h"
+#include "handlers.h"
+
+#if PRINT_ENABLED
+    #include "debug_msg.h"
+#endif
+
+/** @file h_delete_object.c  Handles DeleteObject requests. */
+
+/** Handler for a DeleteObject Service request.
+ * @ingroup OMDO
+ * This handler will be invoked by apdu_handler() if it has been enabled
+ * by a call to apdu_set_confirmed_handler().
+ * This handler builds a response packet, which is
+ * - an Abort if
+ *   - the message is segmented
+ *   - if decoding fails
+ * - a simple ACK if Device_Delete_Object() succeeds
+ * - an Error if Device_Delete_Object() fails
+ *
+ * @param service_request [in] The contents of the service request.
+ * @param service_len [in] The length of the service_request.
+ * @param src [in] BACNET_ADDRESS of the source of the message
+ * @param service_data [in] The BACNET_CONFIRMED_SERVICE_DATA information
+ *                          decoded from the APDU header of this message.
+ */
+void handler_delete_object(
+    uint8_t * service_request,
+    uint16_t service_len,
+    BACNET_ADDRESS * src,
+    BACNET_CONFIRMED_SERVICE_DATA * service_data)
+{
+    BACNET_DELETE_OBJECT_DATA data;
+    int len = 0;
+    int pdu_len = 0;
+    BACNET_NPDU_DATA npdu_data;
+    int bytes_sent = 0;
+    BACNET_ADDRESS my_address;
+
+    /* encode the NPDU portion of the packet */
+    datalink_get_my_address(&my_address);
+    npdu_encode_npdu_data(&npdu_data, false, MESSAGE_PRIORITY_NORMAL);
+    pdu_len =
+        npdu_encode_pdu(&Handler_Transmit_Buffer[0], src, &my_address,
+        &npdu_data);
+    if (service_data->segmented_message) {
+        len =
+            abort_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, ABORT_REASON_SEGMENTATION_NOT_SUPPORTED,
+            true);
+#if PRINT_ENABLED
+        H_DEBUG_MSG("DeleteObject: Segmented message.  Sending Abort!");
+#endif
+        goto DO_ABORT;
+    }
+    len =
+        delete_object_decode_service_request(service_request, service_len,
+        &data);
+    /* bad decoding or something we didn't understand - send an abort */
+    if (len <= 0) {
+        len =
+            abort_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, ABORT_REASON_OTHER, true);
+#if PRINT_ENABLED
+        H_DEBUG_MSG("DeleteObject: Bad Encoding. Sending Abort!");
+#endif
+        goto DO_ABORT;
+    }
+    if (Device_Delete_Object(&data)) {
+        len =
+            encode_simple_ack(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, SERVICE_CONFIRMED_DELETE_OBJECT);
+#if PRINT_ENABLED
+        H_DEBUG_MSG("DeleteObject: Sending Simple Ack!");
+#endif
+    } else {
+        len =
+            bacerror_encode_apdu(&Handler_Transmit_Buffer[pdu_len],
+            service_data->invoke_id, SERVICE_CONFIRMED_DELETE_OBJECT,
+            data.error_class, data.error_code);
+#if PRINT_ENABLED
+        H_DEBUG_MSG("DeleteObject: Sending Error!");
+#endif
+    }
+  DO_ABORT:
+    pdu_len += len;
+    bytes_sent =
+        datalink_send_pdu(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
+    /* keep the reply in case the request is retransmitted */
+    apdu_response_cache_store(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
+#if PRINT_ENABLED
+    if (bytes_sent <= 0) {
+        H_DEBUG_MSG("DeleteObject: Failed to send PDU (%s)!",
+            strerror(errno));
+    }
+#else
+    bytes_sent = bytes_sent;
+#endif
+
+    return;
+}
@@ -177,6 +177,9 @@ void handler_reinitialize_device(
     len =
         datalink_send_pdu(src, &npdu_data, &Handler_Transmit_Buffer[0],
         pdu_len);
+    /* keep the reply in case the request is retransmitted */
+    apdu_response_cache_store(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
 #if PRINT_ENABLED
     if (len <= 0) {
         H_DEBUG_MSG( "ReinitDevice: Failed to send PDU (%s)",
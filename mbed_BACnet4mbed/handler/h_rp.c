@@ -145,6 +145,10 @@ void handler_read_property(
     rpdata.application_data = &Handler_Transmit_Buffer[npdu_len + apdu_len];
     rpdata.application_data_len =
         sizeof(Handler_Transmit_Buffer) - (npdu_len + apdu_len);
+    /* leave room for the closing tag within the max APDU of the sender */
+    if ((service_data->max_resp - apdu_len - 1) < rpdata.application_data_len) {
+        rpdata.application_data_len = service_data->max_resp - apdu_len - 1;
+    }
     len = Device_Read_Property(&rpdata);
     if (len >= 0) {
         apdu_len += len;
@@ -229,6 +233,9 @@ void handler_read_property(
     bytes_sent =
         datalink_send_pdu(src, &npdu_data, &Handler_Transmit_Buffer[0],
         pdu_len);
+    /* keep the reply in case the request is retransmitted */
+    apdu_response_cache_store(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
 #if PRINT_ENABLED
     if (bytes_sent <= 0)
 		{ fprintf(stderr, "Failed to send PDU (%s)!\n", strerror(errno)); }
@@ -208,6 +208,7 @@ void handler_read_property_multiple(
     int apdu_len = 0;
     int npdu_len = 0;
     int error = 0;
+    uint16_t max_apdu = MAX_APDU;
 	
 		EVRECORDDATA(BACNET_H_RPM_RCVD_REQUEST, src, sizeof(src));
 
@@ -229,6 +230,10 @@ void handler_read_property_multiple(
 #endif
         goto RPM_FAILURE;
     }
+    /* size the reply to what the sender accepts */
+    if (service_data->max_resp < max_apdu) {
+        max_apdu = (uint16_t) service_data->max_resp;
+    }
     /* decode apdu request & encode apdu reply
        encode complex ack, invoke id, service choice */
     apdu_len =
@@ -263,7 +268,7 @@ void handler_read_property_multiple(
         len = rpm_ack_encode_apdu_object_begin(&Temp_Buf[0], &rpmdata);
         copy_len =
             memcopy(&Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0], apdu_len,
-            len, MAX_APDU);
+            len, max_apdu);
         if (copy_len == 0) {
 #if PRINT_ENABLED
             H_DEBUG_MSG("RPM: Response too big!");
@@ -310,7 +315,7 @@ void handler_read_property_multiple(
                         rpmdata.object_property, rpmdata.array_index);
                     copy_len =
                         memcopy(&Handler_Transmit_Buffer[npdu_len],
-                        &Temp_Buf[0], apdu_len, len, MAX_APDU);
+                        &Temp_Buf[0], apdu_len, len, max_apdu);
                     if (copy_len == 0) {
 #if PRINT_ENABLED
                         H_DEBUG_MSG("RPM: Too full to encode property!");
@@ -329,7 +334,7 @@ void handler_read_property_multiple(
                         ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY);
                     copy_len =
                         memcopy(&Handler_Transmit_Buffer[npdu_len],
-                        &Temp_Buf[0], apdu_len, len, MAX_APDU);
+                        &Temp_Buf[0], apdu_len, len, max_apdu);
                     if (copy_len == 0) {
 #if PRINT_ENABLED
                         H_DEBUG_MSG("RPM: Too full to encode error!");
@@ -353,7 +358,7 @@ void handler_read_property_multiple(
                         /* handle the error code - but use the special property */
                         len =
                             RPM_Encode_Property(&Handler_Transmit_Buffer
-                            [npdu_len], (uint16_t) apdu_len, MAX_APDU,
+                            [npdu_len], (uint16_t) apdu_len, max_apdu,
                             &rpmdata);
                         if (len > 0) {
                             apdu_len += len;
@@ -373,7 +378,7 @@ void handler_read_property_multiple(
                                 special_object_property, index);
                             len =
                                 RPM_Encode_Property(&Handler_Transmit_Buffer
-                                [npdu_len], (uint16_t) apdu_len, MAX_APDU,
+                                [npdu_len], (uint16_t) apdu_len, max_apdu,
                                 &rpmdata);
                             if (len > 0) {
                                 apdu_len += len;
@@ -393,7 +398,7 @@ void handler_read_property_multiple(
                 /* handle an individual property */
                 len =
                     RPM_Encode_Property(&Handler_Transmit_Buffer[npdu_len],
-                    (uint16_t) apdu_len, MAX_APDU, &rpmdata);
+                    (uint16_t) apdu_len, max_apdu, &rpmdata);
                 if (len > 0) {
                     apdu_len += len;
                 } else {
@@ -412,7 +417,7 @@ void handler_read_property_multiple(
                 len = rpm_ack_encode_apdu_object_end(&Temp_Buf[0]);
                 copy_len =
                     memcopy(&Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0],
-                    apdu_len, len, MAX_APDU);
+                    apdu_len, len, max_apdu);
                 if (copy_len == 0) {
 #if PRINT_ENABLED
                     H_DEBUG_MSG("RPM: Too full to encode object end!");
@@ -487,6 +492,9 @@ void handler_read_property_multiple(
     bytes_sent =
         datalink_send_pdu(src, &npdu_data, &Handler_Transmit_Buffer[0],
         pdu_len);
+    /* keep the reply in case the request is retransmitted */
+    apdu_response_cache_store(src, &npdu_data, &Handler_Transmit_Buffer[0],
+        pdu_len);
 #if PRINT_ENABLED
     if (bytes_sent <= 0) {
         H_DEBUG_MSG("RPM: Failed to send PDU (%s)!", strerror(errno));
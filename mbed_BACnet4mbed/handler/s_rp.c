@@ -38,6 +38,7 @@
 #include "datalink.h"
 #include "dcc.h"
 #include "rp.h"
+#include "peercap.h"
 /* some demo stuff needed */
 #include "handlers.h"
 #include "txbuf.h"
@@ -62,7 +63,8 @@
  *   - 0 for the array size
  *   - 1 to n for individual array members
  *   - BACNET_ARRAY_ALL (~0) for the full array to be read.
- * @return invoke id of outgoing message, or 0 if device is not bound or no tsm available
+ * @return invoke id of outgoing message, or 0 if the window of the device
+ *         is full (see tsm_window_available()) or no tsm available
  */
 uint8_t Send_Read_Property_Request_Address(
     BACNET_ADDRESS * dest,
@@ -86,6 +88,14 @@ uint8_t Send_Read_Property_Request_Address(
     if (!dest) {
         return 0;
     }
+    /* the peer may have told us a smaller max APDU since binding */
+    if (peercap_max_apdu(dest) < max_apdu) {
+        max_apdu = peercap_max_apdu(dest);
+    }
+    /* may we have another request in flight to this peer? */
+    if (!tsm_window_available(dest)) {
+        return 0;
+    }
     /* is there a tsm available? */
     invoke_id = tsm_next_free_invokeID();
     if (invoke_id) {
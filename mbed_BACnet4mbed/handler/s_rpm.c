@@ -38,6 +38,7 @@
 #include "datalink.h"
 #include "dcc.h"
 #include "rpm.h"
+#include "peercap.h"
 /* some demo stuff needed */
 #include "handlers.h"
 #include "sbuf.h"
@@ -58,7 +59,11 @@
  * @param device_id [in] ID of the destination device
  * @param read_access_data [in] Ptr to structure with the linked list of
  *        properties to be read.
- * @return invoke id of outgoing message, or 0 if device is not bound or no tsm available
+ * @return invoke id of outgoing message, or 0 if device is not bound, the
+ *         window of the device is full (see tsm_window_available()) or no
+ *         tsm available
+ * @note Requests to one device are pipelined: call this again until it
+ *       returns 0, and send the next request when an ack frees the window.
  */
 uint8_t Send_Read_Property_Multiple_Request(
     uint8_t * pdu,
@@ -82,14 +87,21 @@ uint8_t Send_Read_Property_Multiple_Request(
     /* is the device bound? */
     status = address_get_by_device(device_id, &max_apdu, &dest);
     /* is there a tsm available? */
-    if (status)
-        invoke_id = tsm_next_free_invokeID();
+    if (status) {
+        /* the peer may have told us a smaller max APDU since binding */
+        if (peercap_max_apdu(&dest) < max_apdu)
+            max_apdu = peercap_max_apdu(&dest);
+        if (tsm_window_available(&dest))
+            invoke_id = tsm_next_free_invokeID();
+    }
     if (invoke_id) {
         /* encode the NPDU portion of the packet */
         datalink_get_my_address(&my_address);
         npdu_encode_npdu_data(&npdu_data, true, MESSAGE_PRIORITY_NORMAL);
         pdu_len = npdu_encode_pdu(&pdu[0], &dest, &my_address, &npdu_data);
         /* encode the APDU portion of the packet */
+        if ((max_pdu - pdu_len) > max_apdu)
+            max_pdu = pdu_len + max_apdu;
         len =
             rpm_encode_apdu(&pdu[pdu_len], max_pdu - pdu_len, invoke_id,
             read_access_data);
@@ -28,6 +28,23 @@
 #include <stdint.h>
 #include "bacdef.h"
 #include "bacenum.h"
+#include "npdu.h"
+
+/* Number of replies to confirmed requests that are kept to answer
+   retransmitted requests without executing the service again.
+   Configure to zero to disable the response cache. A reply is kept for
+   apdu_timeout() milliseconds. */
+#ifndef MAX_APDU_RESPONSE_CACHE
+#define MAX_APDU_RESPONSE_CACHE 4
+#endif
+/* largest reply (NPDU and APDU) that is cached, each entry takes about
+   this plus 48 bytes of RAM. The acknowledges of the services that must
+   not run twice (writes, CreateObject, DeleteObject, SubscribeCOV, DCC,
+   ReinitializeDevice) are short; longer replies are not cached and the
+   retransmitted request is executed again. */
+#ifndef APDU_RESPONSE_CACHE_PDU_SIZE
+#define APDU_RESPONSE_CACHE_PDU_SIZE 64
+#endif
 
 typedef struct _confirmed_service_data {
     bool segmented_message;
@@ -189,6 +206,15 @@ extern "C" {
         uint8_t * apdu, /* APDU data */
         uint16_t pdu_len);      /* for confirmed messages */
 
+/* confirmed service handlers pass their reply here after sending it */
+    void apdu_response_cache_store(
+        BACNET_ADDRESS * dest,
+        BACNET_NPDU_DATA * npdu_data,
+        uint8_t * pdu,
+        uint16_t pdu_len);
+    void apdu_response_cache_timer_milliseconds(
+        uint16_t milliseconds);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
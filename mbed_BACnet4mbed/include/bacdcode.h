@@ -236,6 +236,9 @@ extern "C" {
     int encode_application_character_string(
         uint8_t * apdu,
         BACNET_CHARACTER_STRING * char_string);
+    int encode_application_ansi_string(
+        uint8_t * apdu,
+        const char *value);
     int encode_context_character_string(
         uint8_t * apdu,
         uint8_t tag_number,
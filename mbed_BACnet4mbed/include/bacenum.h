@@ -439,6 +439,12 @@ typedef enum {
 		#else
 			PROP_GATEWAY_DHCP = 1340,
 		#endif
+
+		/* the changes to the object list and names of the Device, see
+		   Device_Object_Changed(); the journal has every change after
+		   the revision of PROP_OBJECT_CHANGES_BASE */
+		PROP_OBJECT_CHANGES_BASE = 1341,
+		PROP_OBJECT_CHANGES = 1342,
 		
     /* do the max range inside of enum so that
        compilers will allocate adequate sized datatype for enum
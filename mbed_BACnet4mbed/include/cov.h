@@ -74,6 +74,22 @@ extern "C" {
         uint8_t invoke_id,
         BACNET_COV_DATA * data);
 
+    /* encode the list of values once for all subscribers of an object */
+    int cov_notify_encode_values(
+        uint8_t * apdu,
+        BACNET_PROPERTY_VALUE * value);
+    int ucov_notify_encode_apdu_values(
+        uint8_t * apdu,
+        BACNET_COV_DATA * data,
+        uint8_t * values,
+        unsigned values_len);
+    int ccov_notify_encode_apdu_values(
+        uint8_t * apdu,
+        uint8_t invoke_id,
+        BACNET_COV_DATA * data,
+        uint8_t * values,
+        unsigned values_len);
+
     int ccov_notify_decode_apdu(
         uint8_t * apdu,
         unsigned apdu_len,
@@ -0,0 +1,85 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef COVCLIENT_H
+#define COVCLIENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "bacdef.h"
+#include "bacenum.h"
+
+/* Number of remote points the COV client follows */
+#ifndef MAX_COV_CLIENT_POINTS
+#define MAX_COV_CLIENT_POINTS 16
+#endif
+
+/* The latest value of a remote point */
+typedef struct BACnet_COV_Client_Value {
+    /* BACNET_APPLICATION_TAG of the present value */
+    uint8_t tag;
+    union {
+        bool Boolean;
+        uint32_t Unsigned_Int;
+        int32_t Signed_Int;
+        float Real;
+        uint32_t Enumerated;
+    } type;
+    /* BACNET_STATUS_FLAGS, bit 0 is in alarm */
+    uint8_t status_flags;
+    /* read by polling, the device refused the subscription */
+    bool polled;
+    /* cov_client_uptime() when the value was received */
+    uint32_t timestamp;
+} BACNET_COV_CLIENT_VALUE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    void cov_client_init(
+        void);
+    void cov_client_task(
+        void);
+    void cov_client_timer_milliseconds(
+        uint16_t milliseconds);
+
+/* called by the application */
+    int cov_client_point_add(
+        uint32_t device_id,
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
+    bool cov_client_point_remove(
+        unsigned point);
+    bool cov_client_value(
+        unsigned point,
+        BACNET_COV_CLIENT_VALUE * value);
+    uint32_t cov_client_uptime(
+        void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
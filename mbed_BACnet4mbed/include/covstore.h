@@ -0,0 +1,57 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef COVSTORE_H
+#define COVSTORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* The COV subscriptions are kept in one record of the KVStore of mbed
+   OS, or in a file where there is no KVStore, e.g. on a host build. */
+#ifndef COV_STORE_KEY
+#define COV_STORE_KEY "/kv/bacnet_cov"
+#endif
+#ifndef COV_STORE_FILE
+#define COV_STORE_FILE "bacnet_cov.bin"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    bool cov_store_save(
+        const void *data,
+        size_t size);
+    size_t cov_store_size(
+        void);
+    bool cov_store_load(
+        void *data,
+        size_t size);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -0,0 +1,93 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef CREATE_OBJECT_H
+#define CREATE_OBJECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bacdef.h"
+#include "bacenum.h"
+#include "wp.h"
+
+/* objectSpecifier without an instance, or with instance 4194303:
+   the device chooses the instance of the new object */
+#define CREATE_OBJECT_ANY_INSTANCE BACNET_MAX_INSTANCE
+
+typedef struct BACnet_Create_Object_Data {
+    BACNET_OBJECT_TYPE object_type;
+    /* CREATE_OBJECT_ANY_INSTANCE, or the instance created on success */
+    uint32_t object_instance;
+    /* the encoded listOfInitialValues, inside of the context tags,
+       points into the service request */
+    uint8_t *initial_values;
+    unsigned initial_values_len;
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
+    /* 1 based element of listOfInitialValues that failed, 0 if none */
+    uint32_t first_failed_element;
+} BACNET_CREATE_OBJECT_DATA;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* decode the service request only */
+    int create_object_decode_service_request(
+        uint8_t * apdu,
+        unsigned apdu_len,
+        BACNET_CREATE_OBJECT_DATA * data);
+
+/* decode one BACnetPropertyValue of listOfInitialValues, into the
+   property, array index, value and priority of a WriteProperty */
+    int create_object_decode_initial_value(
+        uint8_t * apdu,
+        unsigned apdu_len,
+        BACNET_WRITE_PROPERTY_DATA * wp_data);
+
+    int create_object_ack_encode_apdu(
+        uint8_t * apdu,
+        uint8_t invoke_id,
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
+
+    int create_object_error_encode_apdu(
+        uint8_t * apdu,
+        uint8_t invoke_id,
+        BACNET_ERROR_CLASS error_class,
+        BACNET_ERROR_CODE error_code,
+        uint32_t first_failed_element);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+/** @defgroup OMCO Object Management-CreateObject (OM-CO)
+ * @ingroup OAS
+ * 15.3 CreateObject Service <br>
+ * The CreateObject service is used by a client BACnet-user to create a
+ * new instance of an object. The new object gets the initial values of
+ * the request; properties not in the request get their default values.
+ */
+#endif
@@ -0,0 +1,61 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef DELETE_OBJECT_H
+#define DELETE_OBJECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bacdef.h"
+#include "bacenum.h"
+
+typedef struct BACnet_Delete_Object_Data {
+    BACNET_OBJECT_TYPE object_type;
+    uint32_t object_instance;
+    BACNET_ERROR_CLASS error_class;
+    BACNET_ERROR_CODE error_code;
+} BACNET_DELETE_OBJECT_DATA;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* decode the service request only */
+    int delete_object_decode_service_request(
+        uint8_t * apdu,
+        unsigned apdu_len,
+        BACNET_DELETE_OBJECT_DATA * data);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+/** @defgroup OMDO Object Management-DeleteObject (OM-DO)
+ * @ingroup OAS
+ * 15.4 DeleteObject Service <br>
+ * The DeleteObject service is used by a client BACnet-user to delete an
+ * existing object. Objects that the device does not allow to be deleted
+ * are reported with OBJECT_DELETION_NOT_PERMITTED.
+ */
+#endif
@@ -163,6 +163,18 @@ extern "C" {
         BACNET_ADDRESS * src,
         BACNET_CONFIRMED_SERVICE_DATA * service_data);
 
+    void handler_create_object(
+        uint8_t * service_request,
+        uint16_t service_len,
+        BACNET_ADDRESS * src,
+        BACNET_CONFIRMED_SERVICE_DATA * service_data);
+
+    void handler_delete_object(
+        uint8_t * service_request,
+        uint16_t service_len,
+        BACNET_ADDRESS * src,
+        BACNET_CONFIRMED_SERVICE_DATA * service_data);
+
     void handler_device_communication_control(
         uint8_t * service_request,
         uint16_t service_len,
@@ -229,6 +241,11 @@ extern "C" {
         BACNET_READ_ACCESS_DATA * rpm_data);
 
     void handler_cov_subscribe(
+        uint8_t * service_request,
+        uint16_t service_len,
+        BACNET_ADDRESS * src,
+        BACNET_CONFIRMED_SERVICE_DATA * service_data);
+    void handler_cov_subscribe_property(
         uint8_t * service_request,
         uint16_t service_len,
         BACNET_ADDRESS * src,
@@ -239,13 +256,43 @@ extern "C" {
         void);
     void handler_cov_task(
         void);
+    void handler_cov_object_changed(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
+    void handler_cov_object_written(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
+    void handler_cov_object_deleted(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance);
+    bool handler_cov_min_interval_set(
+        BACNET_OBJECT_TYPE object_type,
+        uint32_t object_instance,
+        uint16_t milliseconds);
+    void handler_cov_timer_milliseconds(
+        uint16_t milliseconds);
+    uint32_t handler_cov_suppressed_count(
+        void);
     void handler_cov_timer_seconds(
         uint32_t elapsed_seconds);
     void handler_cov_init(
         void);
+    void handler_cov_restore(
+        void);
     int handler_cov_encode_subscriptions(
         uint8_t * apdu,
         int max_apdu);
+    bool handler_cov_subscriber_statistics(
+        unsigned index,
+        BACNET_ADDRESS * dest,
+        unsigned * outstanding,
+        uint32_t * sent,
+        uint32_t * failed);
+    bool handler_cov_subscriber_backlog(
+        unsigned index,
+        unsigned * backlog,
+        unsigned * backlog_peak,
+        uint32_t * notified);
 
     void handler_ucov_notification(
         uint8_t * service_request,
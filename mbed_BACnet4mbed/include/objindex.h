@@ -0,0 +1,96 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJINDEX_H
+#define OBJINDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "bacdef.h"
+
+/* maps an object instance number to the index of its descriptor */
+typedef struct BACnet_Object_Index_Slot {
+    /* OBJECT_INDEX_EMPTY if the slot is not used */
+    uint32_t instance;
+    uint16_t index;
+} OBJECT_INDEX_SLOT;
+
+#define OBJECT_INDEX_EMPTY UINT32_MAX
+
+/* index to instance function of the object type, for building the index */
+typedef uint32_t(
+    *object_index_instance_function) (
+    unsigned index);
+
+/* Open addressed hash table of the instances of one object type.
+   When the instances are compact, (instance - base) is used as the
+   hash, which is collision free (a perfect hash) for a contiguous
+   range. Sparse instances are spread with a multiplicative hash.
+   Without memory for the slots, the descriptors at index 0 to count-1
+   are scanned instead. */
+typedef struct BACnet_Object_Index {
+    /* NULL when scanning */
+    OBJECT_INDEX_SLOT *slots;
+    object_index_instance_function index_to_instance;
+    /* number of slots - 1, the number of slots is a power of two */
+    uint32_t mask;
+    /* lowest instance, when dense */
+    uint32_t base;
+    /* multiplicative hash: bits to drop, when sparse */
+    uint8_t shift;
+    /* number of indexed instances */
+    uint16_t count;
+    bool dense;
+} OBJECT_INDEX;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    bool object_index_build(
+        OBJECT_INDEX * object_index,
+        unsigned capacity,
+        unsigned count,
+        object_index_instance_function index_to_instance);
+    void object_index_clear(
+        OBJECT_INDEX * object_index);
+
+    bool object_index_add(
+        OBJECT_INDEX * object_index,
+        uint32_t instance,
+        unsigned index);
+    bool object_index_remove(
+        OBJECT_INDEX * object_index,
+        uint32_t instance);
+
+    bool object_index_find(
+        OBJECT_INDEX * object_index,
+        uint32_t instance,
+        unsigned *index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
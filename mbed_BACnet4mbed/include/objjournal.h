@@ -0,0 +1,97 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJJOURNAL_H
+#define OBJJOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* number of object list and name changes the device remembers */
+#ifndef MAX_OBJECT_JOURNAL_ENTRIES
+#define MAX_OBJECT_JOURNAL_ENTRIES 16
+#endif
+#if (MAX_OBJECT_JOURNAL_ENTRIES < 1)
+#error "MAX_OBJECT_JOURNAL_ENTRIES must be at least 1"
+#endif
+
+typedef enum {
+    OBJECT_CHANGE_ADDED = 0,
+    OBJECT_CHANGE_REMOVED = 1,
+    OBJECT_CHANGE_RENAMED = 2
+} OBJECT_CHANGE;
+
+typedef struct BACnet_Object_Journal_Entry {
+    /* the Database_Revision the change resulted in */
+    uint32_t revision;
+    uint32_t instance;
+    uint16_t type;
+    /* OBJECT_CHANGE */
+    uint8_t change;
+} OBJECT_JOURNAL_ENTRY;
+
+/* Ring of the last changes to the object list and the object names.
+   A client that cached the objects of the device at some revision
+   catches up by applying the entries after it, instead of reading the
+   object list and every name again. That works only if no entry after
+   its revision has been overwritten yet: the journal is complete for
+   revisions from base on. */
+typedef struct BACnet_Object_Journal {
+    OBJECT_JOURNAL_ENTRY entries[MAX_OBJECT_JOURNAL_ENTRIES];
+    /* index of the oldest entry */
+    unsigned first;
+    unsigned count;
+    /* every change after this revision is in the journal */
+    uint32_t base;
+} OBJECT_JOURNAL;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    void object_journal_init(
+        OBJECT_JOURNAL * journal,
+        uint32_t revision);
+
+    void object_journal_add(
+        OBJECT_JOURNAL * journal,
+        uint32_t revision,
+        OBJECT_CHANGE change,
+        int object_type,
+        uint32_t object_instance);
+
+    unsigned object_journal_count(
+        const OBJECT_JOURNAL * journal);
+    uint32_t object_journal_base(
+        const OBJECT_JOURNAL * journal);
+    bool object_journal_entry(
+        const OBJECT_JOURNAL * journal,
+        unsigned index,
+        OBJECT_JOURNAL_ENTRY * entry);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
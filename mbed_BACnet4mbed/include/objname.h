@@ -0,0 +1,93 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJNAME_H
+#define OBJNAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "bacdef.h"
+
+/* maps the hash of an object name to the object */
+typedef struct BACnet_Object_Name_Slot {
+    uint32_t hash;
+    uint32_t instance;
+    /* OBJECT_NAME_INDEX_EMPTY if the slot is not used */
+    uint16_t type;
+} OBJECT_NAME_SLOT;
+
+#define OBJECT_NAME_INDEX_EMPTY UINT16_MAX
+
+/* Open addressed hash table of the object names of a device. Only the
+   hash of a name is kept, the names stay in the descriptors, so a hit
+   is a candidate that the caller confirms by comparing the name. Two
+   objects with the same name (or hash) are both kept. */
+typedef struct BACnet_Object_Name_Index {
+    OBJECT_NAME_SLOT *slots;
+    /* number of slots - 1, the number of slots is a power of two */
+    uint32_t mask;
+    /* number of used slots */
+    uint16_t count;
+    /* an add did not fit, lookups must not rely on the index */
+    bool incomplete;
+} OBJECT_NAME_INDEX;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    uint32_t object_name_hash(
+        const char *name,
+        size_t length);
+
+    bool object_name_index_init(
+        OBJECT_NAME_INDEX * name_index,
+        unsigned capacity);
+    void object_name_index_clear(
+        OBJECT_NAME_INDEX * name_index);
+
+    bool object_name_index_add(
+        OBJECT_NAME_INDEX * name_index,
+        uint32_t hash,
+        int object_type,
+        uint32_t object_instance);
+    bool object_name_index_remove(
+        OBJECT_NAME_INDEX * name_index,
+        uint32_t hash,
+        int object_type,
+        uint32_t object_instance);
+
+    bool object_name_index_next(
+        OBJECT_NAME_INDEX * name_index,
+        uint32_t hash,
+        unsigned *cursor,
+        int *object_type,
+        uint32_t * object_instance);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
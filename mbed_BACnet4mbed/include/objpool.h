@@ -0,0 +1,94 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJPOOL_H
+#define OBJPOOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* number of objects of each creatable type that CreateObject or the
+   *_Create() functions can add to the objects of ObjectDescriptors.cpp */
+#ifndef MAX_CREATED_OBJECTS
+#define MAX_CREATED_OBJECTS 4
+#endif
+#if (MAX_CREATED_OBJECTS < 1)
+#error "MAX_CREATED_OBJECTS must be at least 1"
+#endif
+
+/* name buffer of a created object, excluding the nul terminator */
+#ifndef MAX_CREATED_OBJECT_NAME_LEN
+#define MAX_CREATED_OBJECT_NAME_LEN 32
+#endif
+
+/* Fixed number of equally sized blocks in static storage of the caller,
+   so creating and deleting objects never touches the heap. The used
+   blocks are kept in a dense list: position 0 to used-1 of order[]
+   are the used block numbers, the rest are the free ones. A block is
+   never moved, only its position in the list changes when another
+   block is freed. */
+typedef struct BACnet_Object_Pool {
+    uint8_t *storage;
+    size_t block_size;
+    /* block numbers, used ones first */
+    uint16_t *order;
+    uint16_t blocks;
+    uint16_t used;
+} OBJECT_POOL;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    void object_pool_init(
+        OBJECT_POOL * pool,
+        void *storage,
+        size_t block_size,
+        uint16_t * order,
+        unsigned blocks);
+
+    void *object_pool_alloc(
+        OBJECT_POOL * pool);
+    bool object_pool_free(
+        OBJECT_POOL * pool,
+        void *block);
+
+    bool object_pool_owns(
+        OBJECT_POOL * pool,
+        const void *block);
+    unsigned object_pool_position(
+        OBJECT_POOL * pool,
+        const void *block);
+    void *object_pool_at(
+        OBJECT_POOL * pool,
+        unsigned position);
+    unsigned object_pool_count(
+        OBJECT_POOL * pool);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -0,0 +1,97 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJSTATE_H
+#define OBJSTATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* The runtime state of the objects of one type that changes all the
+   time and is checked by every COV pass, stored column wise by the
+   position of the object in the instance index (see objindex.h). The
+   descriptors keep the configuration: names, callbacks, limits and the
+   event data of INTRINSIC_REPORTING. Checking the change flags of the
+   objects reads one bit per object instead of a descriptor line each. */
+typedef struct BACnet_Object_State {
+    float *Present_Value;
+    /* the value last reported by COV */
+    float *Prior_Value;
+    /* one bit per object, 32 objects per word */
+    uint32_t *Changed;
+    uint32_t *Out_Of_Service;
+    unsigned capacity;
+} OBJECT_STATE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    bool object_state_init(
+        OBJECT_STATE * state,
+        unsigned capacity);
+    void object_state_clear(
+        OBJECT_STATE * state);
+
+    void object_state_reset(
+        OBJECT_STATE * state,
+        unsigned position);
+    void object_state_move(
+        OBJECT_STATE * state,
+        unsigned from,
+        unsigned to);
+
+    void object_state_changed_set(
+        OBJECT_STATE * state,
+        unsigned position,
+        bool value);
+
+    void object_state_out_of_service_set(
+        OBJECT_STATE * state,
+        unsigned position,
+        bool value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/* checked for each object by every COV pass, so inline */
+static inline bool object_state_changed(
+    const OBJECT_STATE * state,
+    unsigned position)
+{
+    return (position < state->capacity) &&
+        ((state->Changed[position / 32] & (1UL << (position % 32))) != 0);
+}
+
+static inline bool object_state_out_of_service(
+    const OBJECT_STATE * state,
+    unsigned position)
+{
+    return (position < state->capacity) &&
+        ((state->Out_Of_Service[position / 32] &
+                (1UL << (position % 32))) != 0);
+}
+#endif
@@ -0,0 +1,82 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef PEERCAP_H
+#define PEERCAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "bacdef.h"
+#include "bacenum.h"
+#include "apdu.h"
+
+/* Number of peers whose APDU capabilities are remembered */
+#ifndef MAX_PEER_CAPABILITIES
+#define MAX_PEER_CAPABILITIES 16
+#endif
+
+typedef struct BACnet_Peer_Capability {
+    /* the address of the peer */
+    BACNET_ADDRESS address;
+    /* device instance, above BACNET_MAX_INSTANCE if not known yet */
+    uint32_t device_id;
+    /* max APDU length the peer accepts */
+    uint16_t max_apdu;
+    /* BACNET_SEGMENTATION supported by the peer */
+    uint8_t segmentation;
+    /* max segments the peer accepts, 0 = unspecified */
+    uint8_t max_segments;
+} BACNET_PEER_CAPABILITY;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+    void peercap_update_from_request(
+        BACNET_ADDRESS * src,
+        BACNET_CONFIRMED_SERVICE_DATA * service_data);
+    void peercap_update_from_i_am(
+        uint32_t device_id,
+        unsigned max_apdu,
+        int segmentation,
+        BACNET_ADDRESS * src);
+
+    bool peercap_bind_request(
+        uint32_t device_id,
+        BACNET_PEER_CAPABILITY * capability);
+    bool peercap_get(
+        BACNET_ADDRESS * dest,
+        BACNET_PEER_CAPABILITY * capability);
+    bool peercap_get_by_device(
+        uint32_t device_id,
+        BACNET_PEER_CAPABILITY * capability);
+/* max APDU to encode for the peer, never above our own MAX_APDU */
+    uint16_t peercap_max_apdu(
+        BACNET_ADDRESS * dest);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -34,6 +34,7 @@
    doing client requests */
 #if (!MAX_TSM_TRANSACTIONS)
 #define tsm_free_invoke_id(x) (void)x;
+#define tsm_invoke_id_busy(x, y) (void)x; (void)y;
 #else
 typedef enum {
     TSM_STATE_IDLE,
@@ -67,6 +68,12 @@ typedef struct BACnet_TSM_Data {
     /* used to perform timeout on Confirmed Requests */
     /* in milliseconds */
     uint16_t RequestTimer;
+    /* the timeout RequestTimer was last started with, doubled with
+       every retry, in milliseconds */
+    uint16_t RequestTimeout;
+    /* time since the request was first sent, in milliseconds */
+    /* used to sample the round trip time of the peer */
+    uint32_t ElapsedTime;
     /* unique id */
     uint8_t InvokeID;
     /* state that the TSM is in */
@@ -80,6 +87,58 @@ typedef struct BACnet_TSM_Data {
     unsigned apdu_len;
 } BACNET_TSM_DATA;
 
+/* Round trip time estimation per peer (RFC 6298 style).
+   The retransmission timeout of each peer is derived from the
+   smoothed round trip time and its variance. Each transaction starts
+   with it and backs off exponentially while the peer does not answer,
+   but never takes longer than apdu_timeout() * (apdu_retries() + 1),
+   the time of the fixed APDU timeout. */
+#ifndef MAX_TSM_PEERS
+#define MAX_TSM_PEERS 8
+#endif
+/* lower and upper bound of the retransmission timeout in milliseconds */
+#ifndef TSM_RTO_MIN
+#define TSM_RTO_MIN 250
+#endif
+#ifndef TSM_RTO_MAX
+#define TSM_RTO_MAX 6000
+#endif
+/* max number of confirmed requests in flight to one peer.
+   The window of a peer is halved when it answers busy or a request
+   times out, and grows by one again with every acknowledge.
+   By default one peer may take half of the transactions, so a slow
+   peer cannot block the requests to all others. */
+#ifndef TSM_PEER_WINDOW
+#if (MAX_TSM_TRANSACTIONS > 1)
+#define TSM_PEER_WINDOW (MAX_TSM_TRANSACTIONS / 2)
+#else
+#define TSM_PEER_WINDOW 1
+#endif
+#endif
+#if (TSM_PEER_WINDOW < 1) || (TSM_PEER_WINDOW > 255)
+#error "TSM_PEER_WINDOW must be 1..255"
+#endif
+
+typedef struct BACnet_TSM_Peer_Data {
+    /* the address of the peer */
+    BACNET_ADDRESS address;
+    /* smoothed round trip time in milliseconds */
+    uint16_t srtt;
+    /* round trip time variance in milliseconds */
+    uint16_t rttvar;
+    /* current retransmission timeout in milliseconds */
+    uint16_t rto;
+    /* number of round trip time samples taken */
+    uint16_t samples;
+    /* number of retransmissions to this peer */
+    uint16_t timeouts;
+    /* consecutive transactions that failed to confirm */
+    uint8_t failures;
+    /* current and configured number of requests in flight */
+    uint8_t window;
+    uint8_t window_max;
+} BACNET_TSM_PEER_DATA;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -118,6 +177,27 @@ extern "C" {
     bool tsm_invoke_id_failed(
         uint8_t invokeID);
 
+/* round trip time estimates of the peers we talk to */
+    unsigned tsm_peer_count(
+        void);
+    bool tsm_peer_data(
+        unsigned index,
+        BACNET_TSM_PEER_DATA * peer);
+    uint16_t tsm_peer_timeout(
+        BACNET_ADDRESS * dest);
+    uint8_t tsm_peer_retries(
+        BACNET_ADDRESS * dest);
+/* request pipelining: check before getting an invoke ID for dest */
+    bool tsm_window_available(
+        BACNET_ADDRESS * dest);
+    void tsm_peer_window_set(
+        BACNET_ADDRESS * dest,
+        uint8_t window);
+/* the peer answered busy (out of resources) to this request */
+    void tsm_invoke_id_busy(
+        uint8_t invokeID,
+        BACNET_ADDRESS * src);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
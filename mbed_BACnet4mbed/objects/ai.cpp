@@ -35,6 +35,10 @@
 #include "bacenum.h"
 #include "bactext.h"
 #include "config_bacnet.h"     /* the custom stuff */
+#include "objindex.h"
+#include "objpool.h"
+#include "objstate.h"
+#include "objengine.h"
 #include "device_obj.h"
 #include "handlers.h"
 #include "timestamp.h"
@@ -50,46 +54,230 @@
 extern EventQueue bacQueue;
 extern ANALOG_INPUT_DESCR AI_Descr[];
 uint32_t NUM_ANALOG_INPUTS;
+/* instance number to AI_Descr[] index */
+static OBJECT_INDEX AI_Index;
+/* AI_Descr[] are followed by the objects created at runtime */
+static unsigned AI_Static_Count;
+
+typedef struct analog_input_object {
+    ANALOG_INPUT_DESCR Descr;
+    char Name[MAX_CREATED_OBJECT_NAME_LEN + 1];
+} ANALOG_INPUT_OBJECT;
+
+static ANALOG_INPUT_OBJECT AI_Created[MAX_CREATED_OBJECTS];
+static uint16_t AI_Created_Order[MAX_CREATED_OBJECTS];
+static OBJECT_POOL AI_Pool;
+static char AI_No_Description[] = "";
+/* Present_Value, Out_Of_Service and the COV state, by index */
+static OBJECT_STATE AI_State;
+
+/* the descriptor at an index of the instance index */
+static ANALOG_INPUT_DESCR *Analog_Input_Descr(
+    unsigned index)
+{
+    if (index < AI_Static_Count)
+        return &AI_Descr[index];
 
+    return (ANALOG_INPUT_DESCR *) object_pool_at(&AI_Pool,
+        index - AI_Static_Count);
+}
 
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_UNITS,
-		PROP_COV_INCREMENT,
-    -1
-};
+/* the index of a descriptor, i.e. its position in AI_State */
+static unsigned Analog_Input_Position(
+    const ANALOG_INPUT_DESCR * object)
+{
+    if ((object >= &AI_Descr[0]) && (object < &AI_Descr[AI_Static_Count]))
+        return (unsigned) (object - &AI_Descr[0]);
+
+    return AI_Static_Count + object_pool_position(&AI_Pool, object);
+}
+
+/* the descriptor of an instance, NULL if there is none */
+static ANALOG_INPUT_DESCR *Analog_Input_Object(
+    uint32_t object_instance)
+{
+    unsigned index = 0;
+
+    if (object_index_find(&AI_Index, object_instance, &index))
+        return Analog_Input_Descr(index);
+
+    return NULL;
+}
+
+static void Analog_Input_Read_Notify(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_PROPERTY_ID object_property)
+{
+    if (object->read_callback) {
+        uint8_t id = bacQueue.call(object->read_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_AI_RDCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_AI_RDCB_FAILED, id, 0); }
+    }
+}
+
+static void Analog_Input_Write_Notify(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    (void) value;
+    if (object->write_callback) {
+        uint8_t id = bacQueue.call(object->write_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_AI_WRCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_AI_WRCB_FAILED, id, 0); }
+    }
+}
+
+/* Present_Value is read only, it follows the input */
+static int Analog_Input_Read_Present_Value(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        AI_State.Present_Value[Analog_Input_Position(object)]);
+}
+
+static int Analog_Input_Read_Status_Flags(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return object_encode_status_flags(&rpdata->application_data[0],
+        object->Event_State,
+        object_state_out_of_service(&AI_State,
+            Analog_Input_Position(object)));
+}
+
+static int Analog_Input_Read_Out_Of_Service(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_boolean(&rpdata->application_data[0],
+        object_state_out_of_service(&AI_State,
+            Analog_Input_Position(object)));
+}
+
+static bool Analog_Input_Write_Out_Of_Service(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_BOOLEAN,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object_state_out_of_service_set(&AI_State,
+        Analog_Input_Position(object), value->type.Boolean);
+
+    return true;
+}
+
+/* only the objects created at runtime have a buffer for a new name */
+static bool Analog_Input_Write_Object_Name(
+    ANALOG_INPUT_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!object_pool_owns(&AI_Pool, object)) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
 
-static const int Properties_Optional[] = {
-    PROP_DESCRIPTION,
-//    PROP_RELIABILITY,
-//    PROP_COV_INCREMENT,
+    return object_write_name(wp_data, value,
+        ((ANALOG_INPUT_OBJECT *) object)->Name, sizeof(((ANALOG_INPUT_OBJECT *) object)->Name));
+}
+
+/* The properties of the Analog Input object type, the ReadProperty,
+   WriteProperty and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<ANALOG_INPUT_DESCR>
+    Analog_Input_Properties[] = {
+    {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+        object_read_object_identifier<ANALOG_INPUT_DESCR>, NULL},
+    {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+        object_read_string<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::object_name>,
+        Analog_Input_Write_Object_Name},
+    {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+        object_read_object_type<ANALOG_INPUT_DESCR>, NULL},
+    {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Analog_Input_Read_Present_Value, NULL},
+    {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Analog_Input_Read_Status_Flags, NULL},
+    {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+        object_read_event_state<ANALOG_INPUT_DESCR>, NULL},
+    {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+        Analog_Input_Read_Out_Of_Service,
+        Analog_Input_Write_Out_Of_Service},
+    {PROP_UNITS, OBJ_PROP_REQUIRED,
+        object_read_units<ANALOG_INPUT_DESCR>,
+        object_write_units<ANALOG_INPUT_DESCR>},
+    {PROP_COV_INCREMENT, OBJ_PROP_REQUIRED,
+        object_read_cov_increment<ANALOG_INPUT_DESCR>,
+        object_write_cov_increment<ANALOG_INPUT_DESCR>},
+    {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+        object_read_string<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::Object_Description>, NULL},
+    {PROP_RELIABILITY, OBJ_PROP_OPTIONAL,
+        object_read_reliability<ANALOG_INPUT_DESCR>, NULL},
 #if defined(INTRINSIC_REPORTING)
-    PROP_TIME_DELAY,
-    PROP_NOTIFICATION_CLASS,
-    PROP_HIGH_LIMIT,
-    PROP_LOW_LIMIT,
-    PROP_DEADBAND,
-    PROP_LIMIT_ENABLE,
-    PROP_EVENT_ENABLE,
-    PROP_ACKED_TRANSITIONS,
-    PROP_NOTIFY_TYPE,
-    PROP_EVENT_TIME_STAMPS,
+    {PROP_TIME_DELAY, OBJ_PROP_OPTIONAL,
+        object_read_time_delay<ANALOG_INPUT_DESCR>,
+        object_write_time_delay<ANALOG_INPUT_DESCR>},
+    {PROP_NOTIFICATION_CLASS, OBJ_PROP_OPTIONAL,
+        object_read_notification_class<ANALOG_INPUT_DESCR>,
+        object_write_notification_class<ANALOG_INPUT_DESCR>},
+    {PROP_HIGH_LIMIT, OBJ_PROP_OPTIONAL,
+        object_read_real<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::High_Limit>,
+        object_write_real<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::High_Limit>},
+    {PROP_LOW_LIMIT, OBJ_PROP_OPTIONAL,
+        object_read_real<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::Low_Limit>,
+        object_write_real<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::Low_Limit>},
+    {PROP_DEADBAND, OBJ_PROP_OPTIONAL,
+        object_read_real<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::Deadband>,
+        object_write_real<ANALOG_INPUT_DESCR,
+            &ANALOG_INPUT_DESCR::Deadband>},
+    {PROP_LIMIT_ENABLE, OBJ_PROP_OPTIONAL,
+        object_read_limit_enable<ANALOG_INPUT_DESCR>,
+        object_write_limit_enable<ANALOG_INPUT_DESCR>},
+    {PROP_EVENT_ENABLE, OBJ_PROP_OPTIONAL,
+        object_read_event_enable<ANALOG_INPUT_DESCR>,
+        object_write_event_enable<ANALOG_INPUT_DESCR>},
+    {PROP_ACKED_TRANSITIONS, OBJ_PROP_OPTIONAL,
+        object_read_acked_transitions<ANALOG_INPUT_DESCR>, NULL},
+    {PROP_NOTIFY_TYPE, OBJ_PROP_OPTIONAL,
+        object_read_notify_type<ANALOG_INPUT_DESCR>,
+        object_write_notify_type<ANALOG_INPUT_DESCR>},
+    {PROP_EVENT_TIME_STAMPS, OBJ_PROP_OPTIONAL | OBJ_PROP_ARRAY,
+        object_read_event_time_stamps<ANALOG_INPUT_DESCR>, NULL},
 #endif
-    -1
 };
 
-static const int Properties_Proprietary[] = {
-//    9997,   // test case for real encoding-decoding unsigned value correctly
-//    9998,   // test case for unsigned encoding-decoding unsigned value correctly
-//    9999,   // test case for signed encoding-decoding negative value correctly
-    -1
+static int Analog_Input_Property_List[
+    OBJ_PROPERTY_COUNT(Analog_Input_Properties) + 3];
+static uint8_t Analog_Input_Property_Order[
+    OBJ_PROPERTY_COUNT(Analog_Input_Properties) + 1];
+
+static const BACnet_Object_Class<ANALOG_INPUT_DESCR> Analog_Input_Class = {
+    OBJECT_ANALOG_INPUT,
+    Analog_Input_Properties,
+    OBJ_PROPERTY_COUNT(Analog_Input_Properties),
+    Analog_Input_Property_List,
+    Analog_Input_Property_Order,
+    Analog_Input_Object,
+    Analog_Input_Read_Notify,
+    Analog_Input_Write_Notify
 };
 
 void Analog_Input_Property_Lists(
@@ -97,14 +285,8 @@ void Analog_Input_Property_Lists(
     const int **pOptional,
     const int **pProprietary)
 {
-    if (pRequired)
-        *pRequired = Properties_Required;
-    if (pOptional)
-        *pOptional = Properties_Optional;
-    if (pProprietary)
-        *pProprietary = Properties_Proprietary;
-
-    return;
+    object_property_lists(&Analog_Input_Class, pRequired, pOptional,
+        pProprietary);
 }
 
 
@@ -112,23 +294,38 @@ void Analog_Input_Init(
     void)
 {
     unsigned i;
-    float dummy;
     
 #if defined(INTRINSIC_REPORTING)
     unsigned j;
 #endif
 
-    for (i = 0; i < Analog_Input_Count(); i++)
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_ANALOG_INPUTS = 0;
+    while (AI_Descr[NUM_ANALOG_INPUTS].object_instance <= BACNET_MAX_INSTANCE)
+        NUM_ANALOG_INPUTS++;
+    AI_Static_Count = NUM_ANALOG_INPUTS;
+    object_pool_init(&AI_Pool, AI_Created, sizeof(ANALOG_INPUT_OBJECT),
+        AI_Created_Order, MAX_CREATED_OBJECTS);
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&AI_Index, NUM_ANALOG_INPUTS + MAX_CREATED_OBJECTS,
+            NUM_ANALOG_INPUTS, Analog_Input_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_ANALOG_INPUT,
+            NUM_ANALOG_INPUTS); }
+    /* all values 0.0, in service and unchanged; without the memory for
+       MAX_CREATED_OBJECTS more, CreateObject is refused */
+    if (!object_state_init(&AI_State,
+            NUM_ANALOG_INPUTS + MAX_CREATED_OBJECTS) &&
+        !object_state_init(&AI_State, NUM_ANALOG_INPUTS))
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_APPLICATION,
+                MBED_ERROR_CODE_OUT_OF_MEMORY), "Analog Input state");
+
+    for (i = 0; i < NUM_ANALOG_INPUTS; i++)
     {
-      AI_Descr[i].Present_Value = 0.0f;
-      AI_Descr[i].Prior_Value = 0.0f;
-      AI_Descr[i].Out_Of_Service = false;
       AI_Descr[i].Reliability = RELIABILITY_NO_FAULT_DETECTED;
       
+      /* 1.0 unless configured */
       AI_Descr[i].COV_Increment = 
-        (AI_Descr[i].COV_Increment == dummy) ? 1.0f : AI_Descr[i].COV_Increment;
-      
-      AI_Descr[i].Changed = false;
+        (AI_Descr[i].COV_Increment == 0.0f) ? 1.0f : AI_Descr[i].COV_Increment;
       
 #if defined(INTRINSIC_REPORTING)
       AI_Descr[i].Event_State = EVENT_STATE_NORMAL;
@@ -153,6 +350,137 @@ void Analog_Input_Init(
     }
 }
 
+/** Creates an object with default values, e.g. for CreateObject.
+ * @param object_instance [in] The instance of the new object.
+ * @return true if the object was created, false if the instance exists
+ *         or MAX_CREATED_OBJECTS are in use.
+ */
+bool Analog_Input_Create(
+    uint32_t object_instance)
+{
+    ANALOG_INPUT_OBJECT *object = NULL;
+    ANALOG_INPUT_DESCR *descr = NULL;
+#if defined(INTRINSIC_REPORTING)
+    unsigned i = 0;
+#endif
+
+    if ((object_instance > BACNET_MAX_INSTANCE) ||
+        (NUM_ANALOG_INPUTS >= AI_State.capacity) ||
+        Analog_Input_Valid_Instance(object_instance))
+        return false;
+    object = (ANALOG_INPUT_OBJECT *) object_pool_alloc(&AI_Pool);
+    if (!object)
+        return false;
+    snprintf(object->Name, sizeof(object->Name), "AI_%lu",
+        (unsigned long) object_instance);
+    descr = &object->Descr;
+    descr->object_instance = object_instance;
+    descr->object_name = object->Name;
+    descr->Object_Description = AI_No_Description;
+    descr->Units = UNITS_NO_UNITS;
+    descr->COV_Increment = 1.0f;
+    descr->Event_State = EVENT_STATE_NORMAL;
+    descr->Reliability = RELIABILITY_NO_FAULT_DETECTED;
+#if defined(INTRINSIC_REPORTING)
+    /* notification class not connected */
+    descr->Notification_Class = BACNET_MAX_INSTANCE;
+    for (i = 0; i < MAX_BACNET_EVENT_TRANSITION; i++) {
+        datetime_wildcard_set(&descr->Event_Time_Stamps[i]);
+        descr->Acked_Transitions[i].bIsAcked = true;
+    }
+#endif
+    /* lookups by instance find the object only once it is filled in */
+    core_util_critical_section_enter();
+    if (!object_index_add(&AI_Index, object_instance, NUM_ANALOG_INPUTS)) {
+        core_util_critical_section_exit();
+        object_pool_free(&AI_Pool, object);
+        return false;
+    }
+    object_state_reset(&AI_State, NUM_ANALOG_INPUTS);
+    NUM_ANALOG_INPUTS++;
+    core_util_critical_section_exit();
+    Device_Object_Name_Index_Add(OBJECT_ANALOG_INPUT, object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_ADDED, OBJECT_ANALOG_INPUT,
+        object_instance);
+
+    return true;
+}
+
+/** Deletes an object created at runtime, those of AI_Descr[] stay.
+ * The last created object takes over the position of the deleted one.
+ * @param object_instance [in] The instance of the object.
+ * @return true if the object was deleted.
+ */
+bool Analog_Input_Delete(
+    uint32_t object_instance)
+{
+    ANALOG_INPUT_DESCR *object = Analog_Input_Object(object_instance);
+    ANALOG_INPUT_DESCR *last = NULL;
+    unsigned position = 0;
+
+    if (!object || !object_pool_owns(&AI_Pool, object))
+        return false;
+    position = object_pool_position(&AI_Pool, object);
+    last = (ANALOG_INPUT_DESCR *) object_pool_at(&AI_Pool,
+        object_pool_count(&AI_Pool) - 1);
+    Device_Object_Name_Index_Remove(OBJECT_ANALOG_INPUT, object_instance);
+    /* the application thread and the COV ticker look objects up by
+       instance, they must not see the index or the state half moved */
+    core_util_critical_section_enter();
+    object_index_remove(&AI_Index, object_instance);
+    object_pool_free(&AI_Pool, object);
+    if (last != object) {
+        object_index_remove(&AI_Index, last->object_instance);
+        object_index_add(&AI_Index, last->object_instance,
+            AI_Static_Count + position);
+        object_state_move(&AI_State, NUM_ANALOG_INPUTS - 1,
+            AI_Static_Count + position);
+    }
+    NUM_ANALOG_INPUTS--;
+    core_util_critical_section_exit();
+    Device_Object_Changed(OBJECT_CHANGE_REMOVED, OBJECT_ANALOG_INPUT,
+        object_instance);
+
+    return true;
+}
+
+/* deletes all objects created at runtime */
+void Analog_Input_Cleanup(
+    void)
+{
+    while (object_pool_count(&AI_Pool)) {
+        ANALOG_INPUT_DESCR *object =
+            (ANALOG_INPUT_DESCR *) object_pool_at(&AI_Pool, 0);
+
+        Analog_Input_Delete(object->object_instance);
+    }
+}
+
+/** Renames an object created at runtime, the names of AI_Descr[]
+ *  are fixed.
+ * @param object_instance [in] The instance of the object.
+ * @param new_name [in] The new name, truncated to
+ *        MAX_CREATED_OBJECT_NAME_LEN characters.
+ * @return true if the object was renamed.
+ */
+bool Analog_Input_Name_Set(
+    uint32_t object_instance,
+    char *new_name)
+{
+    ANALOG_INPUT_DESCR *object = Analog_Input_Object(object_instance);
+
+    if (!object || !new_name || !object_pool_owns(&AI_Pool, object))
+        return false;
+    Device_Object_Name_Index_Remove(OBJECT_ANALOG_INPUT, object_instance);
+    snprintf(((ANALOG_INPUT_OBJECT *) object)->Name,
+        sizeof(((ANALOG_INPUT_OBJECT *) object)->Name), "%s", new_name);
+    Device_Object_Name_Index_Add(OBJECT_ANALOG_INPUT, object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_RENAMED, OBJECT_ANALOG_INPUT,
+        object_instance);
+
+    return true;
+}
+
 /* we simply have 0-n object instances.  Yours might be */
 /* more complex, and then you need validate that the */
 /* given instance exists */
@@ -173,13 +501,7 @@ bool Analog_Input_Valid_Instance(
 unsigned Analog_Input_Count(
     void)
 {
-	uint32_t i=0;
-	
-	while(AI_Descr[i].object_instance <= BACNET_MAX_INSTANCE)
-		i++;
-	
-	NUM_ANALOG_INPUTS = i;
-  return i;
+    return NUM_ANALOG_INPUTS;
 }
 
 /* we simply have 0-n object instances.  Yours might be */
@@ -188,7 +510,7 @@ unsigned Analog_Input_Count(
 uint32_t Analog_Input_Index_To_Instance(
     unsigned index)
 {
-    return AI_Descr[index].object_instance;
+    return Analog_Input_Descr(index)->object_instance;
 }
 
 /* we simply have 0-n object instances.  Yours might be */
@@ -199,13 +521,10 @@ unsigned Analog_Input_Instance_To_Index(
 {
     unsigned index = 0;
 
-    for(index=0; index<NUM_ANALOG_INPUTS; index++)
-		{
-			if(AI_Descr[index].object_instance == object_instance)
-				return index;
-		}
+    if (object_index_find(&AI_Index, object_instance, &index))
+        return index;
 
-    return index;
+    return NUM_ANALOG_INPUTS;
 }
 
 float Analog_Input_Present_Value(
@@ -216,7 +535,7 @@ float Analog_Input_Present_Value(
 
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) {
-        value = AI_Descr[index].Present_Value;
+        value = AI_State.Present_Value[index];
     }
 
     return value;
@@ -230,16 +549,18 @@ static void Analog_Input_COV_Detect(unsigned int index,
     float cov_delta = 0.0;
 
     if (index < NUM_ANALOG_INPUTS) {
-        prior_value = AI_Descr[index].Prior_Value;
-        cov_increment = AI_Descr[index].COV_Increment;
+        prior_value = AI_State.Prior_Value[index];
+        cov_increment = Analog_Input_Descr(index)->COV_Increment;
         if (prior_value > value) {
             cov_delta = prior_value - value;
         } else {
             cov_delta = value - prior_value;
         }
         if (cov_delta >= cov_increment) {
-            AI_Descr[index].Changed = true;
-						AI_Descr[index].Prior_Value = value;
+            object_state_changed_set(&AI_State, index, true);
+            AI_State.Prior_Value[index] = value;
+            handler_cov_object_changed(OBJECT_ANALOG_INPUT,
+                Analog_Input_Index_To_Instance(index));
         }
     }
 }
@@ -253,7 +574,7 @@ void Analog_Input_Present_Value_Set(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) {
         Analog_Input_COV_Detect(index, value);
-        AI_Descr[index].Present_Value = value;
+        AI_State.Present_Value[index] = value;
     }
 }
 
@@ -267,7 +588,7 @@ bool Analog_Input_Object_Name(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        status = characterstring_init_ansi(object_name, AI_Descr[index].object_name);
+        status = characterstring_init_ansi(object_name, Analog_Input_Descr(index)->object_name);
     }
 
     return status;
@@ -285,7 +606,7 @@ bool Analog_Input_Object_Description(
     if (index < NUM_ANALOG_INPUTS) 
 		{ 
       status = 
-        characterstring_init_ansi(object_description, AI_Descr[index].Object_Description);
+        characterstring_init_ansi(object_description, Analog_Input_Descr(index)->Object_Description);
     }
 
     return status;
@@ -300,7 +621,7 @@ bool Analog_Input_Change_Of_Value(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        changed = AI_Descr[index].Changed;
+        changed = object_state_changed(&AI_State, index);
     }
 
     return changed;
@@ -314,7 +635,7 @@ void Analog_Input_Change_Of_Value_Clear(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        AI_Descr[index].Changed = false;
+        object_state_changed_set(&AI_State, index, false);
     }
 }
 
@@ -323,44 +644,10 @@ bool Analog_Input_Encode_Value_List(
     uint32_t object_instance,
     BACNET_PROPERTY_VALUE * value_list)
 {
-    bool status = false;
-
-    if (value_list) {
-        value_list->propertyIdentifier = PROP_PRESENT_VALUE;
-        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-        value_list->value.context_specific = false;
-        value_list->value.tag = BACNET_APPLICATION_TAG_REAL;
-        value_list->value.type.Real = Analog_Input_Present_Value(object_instance);
-        value_list->value.next = NULL;
-        value_list->priority = BACNET_NO_PRIORITY;
-        value_list = value_list->next;
-    }
-    if (value_list) {
-        value_list->propertyIdentifier = PROP_STATUS_FLAGS;
-        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-        value_list->value.context_specific = false;
-        value_list->value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
-        bitstring_init(&value_list->value.type.Bit_String);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-            STATUS_FLAG_IN_ALARM, false);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-            STATUS_FLAG_FAULT, false);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-            STATUS_FLAG_OVERRIDDEN, false);
-        if (Analog_Input_Out_Of_Service(object_instance)) {
-            bitstring_set_bit(&value_list->value.type.Bit_String,
-                STATUS_FLAG_OUT_OF_SERVICE, true);
-        } else {
-            bitstring_set_bit(&value_list->value.type.Bit_String,
-                STATUS_FLAG_OUT_OF_SERVICE, false);
-        }
-        value_list->value.next = NULL;
-        value_list->priority = BACNET_NO_PRIORITY;
-        value_list->next = NULL;
-    }
-    status = Analog_Input_Change_Of_Value(object_instance);
+    object_encode_value_list(&Analog_Input_Class, object_instance,
+        value_list);
 
-    return status;
+    return Analog_Input_Change_Of_Value(object_instance);
 }
 
 float Analog_Input_COV_Increment(
@@ -372,7 +659,7 @@ float Analog_Input_COV_Increment(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        value = AI_Descr[index].COV_Increment;
+        value = Analog_Input_Descr(index)->COV_Increment;
     }
 
     return value;
@@ -387,7 +674,7 @@ void Analog_Input_COV_Increment_Set(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        AI_Descr[index].COV_Increment = value;
+        Analog_Input_Descr(index)->COV_Increment = value;
     }
 }
 
@@ -400,7 +687,7 @@ bool Analog_Input_Out_Of_Service(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        value = AI_Descr[index].Out_Of_Service;
+        value = object_state_out_of_service(&AI_State, index);
     }
 
     return value;
@@ -415,510 +702,22 @@ void Analog_Input_Out_Of_Service_Set(
     index = Analog_Input_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_INPUTS) 
 		{
-        AI_Descr[index].Out_Of_Service = value;
+        object_state_out_of_service_set(&AI_State, index, value);
     }
 }
 
 /* return apdu length, or BACNET_STATUS_ERROR on error */
-/* assumption - object has already exists */
 int Analog_Input_Read_Property(
     BACNET_READ_PROPERTY_DATA * rpdata)
 {
-    int apdu_len = 0;   /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    ANALOG_INPUT_DESCR *CurrentAI;
-    unsigned object_index = 0;
-#if defined(INTRINSIC_REPORTING)
-    unsigned i = 0;
-    int len = 0;
-#endif
-    uint8_t *apdu = NULL;
-
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
-        return 0;
-    }
-
-    object_index = Analog_Input_Instance_To_Index(rpdata->object_instance);
-    if (object_index < NUM_ANALOG_INPUTS)
-        CurrentAI = &AI_Descr[object_index];
-    else
-        return BACNET_STATUS_ERROR;
-
-		if(AI_Descr[object_index].read_callback)
-		{
-		  uint8_t id = bacQueue.call(AI_Descr[object_index].read_callback, (uint32_t)rpdata->object_property);
-		  
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_AI_RDCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_AI_RDCB_FAILED, id, 0); }
-		}
-		
-    apdu = rpdata->application_data;
-    switch ((int) rpdata->object_property) {
-        case PROP_OBJECT_IDENTIFIER:
-            apdu_len =
-                encode_application_object_id(&apdu[0], OBJECT_ANALOG_INPUT,
-                rpdata->object_instance);
-            break;
-
-        case PROP_OBJECT_NAME:
-            Analog_Input_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        
-        case PROP_DESCRIPTION:
-            Analog_Input_Object_Description(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-
-        case PROP_OBJECT_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], OBJECT_ANALOG_INPUT);
-            break;
-
-        case PROP_PRESENT_VALUE:
-            apdu_len =
-                encode_application_real(&apdu[0],
-                Analog_Input_Present_Value(rpdata->object_instance));
-            break;
-
-        case PROP_STATUS_FLAGS:
-            bitstring_init(&bit_string);
-#if defined(INTRINSIC_REPORTING)
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM,
-                CurrentAI->Event_State ? true : false);
-#else
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-#endif
-            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE,
-                CurrentAI->Out_Of_Service);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_EVENT_STATE:
-#if defined(INTRINSIC_REPORTING)
-            apdu_len =
-                encode_application_enumerated(&apdu[0],
-                CurrentAI->Event_State);
-#else
-            apdu_len =
-                encode_application_enumerated(&apdu[0], EVENT_STATE_NORMAL);
-#endif
-            break;
-
-        case PROP_RELIABILITY:
-            apdu_len =
-                encode_application_enumerated(&apdu[0],
-                CurrentAI->Reliability);
-            break;
-
-        case PROP_OUT_OF_SERVICE:
-            apdu_len =
-                encode_application_boolean(&apdu[0],
-                CurrentAI->Out_Of_Service);
-            break;
-
-        case PROP_UNITS:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], CurrentAI->Units);
-            break;
-
-        case PROP_COV_INCREMENT:
-            apdu_len = encode_application_real(&apdu[0],
-                CurrentAI->COV_Increment);
-            break;
-
-#if defined(INTRINSIC_REPORTING)
-        case PROP_TIME_DELAY:
-            apdu_len =
-                encode_application_unsigned(&apdu[0], CurrentAI->Time_Delay);
-            break;
-
-        case PROP_NOTIFICATION_CLASS:
-            apdu_len =
-                encode_application_unsigned(&apdu[0],
-                CurrentAI->Notification_Class);
-            break;
-
-        case PROP_HIGH_LIMIT:
-            apdu_len =
-                encode_application_real(&apdu[0], CurrentAI->High_Limit);
-            break;
-
-        case PROP_LOW_LIMIT:
-            apdu_len = encode_application_real(&apdu[0], CurrentAI->Low_Limit);
-            break;
-
-        case PROP_DEADBAND:
-            apdu_len = encode_application_real(&apdu[0], CurrentAI->Deadband);
-            break;
-
-        case PROP_LIMIT_ENABLE:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, 0,
-                (CurrentAI->
-                    Limit_Enable & EVENT_LOW_LIMIT_ENABLE) ? true : false);
-            bitstring_set_bit(&bit_string, 1,
-                (CurrentAI->
-                    Limit_Enable & EVENT_HIGH_LIMIT_ENABLE) ? true : false);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_EVENT_ENABLE:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_OFFNORMAL,
-                (CurrentAI->
-                    Event_Enable & EVENT_ENABLE_TO_OFFNORMAL) ? true : false);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_FAULT,
-                (CurrentAI->
-                    Event_Enable & EVENT_ENABLE_TO_FAULT) ? true : false);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_NORMAL,
-                (CurrentAI->
-                    Event_Enable & EVENT_ENABLE_TO_NORMAL) ? true : false);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_ACKED_TRANSITIONS:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_OFFNORMAL,
-                CurrentAI->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
-                bIsAcked);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_FAULT,
-                CurrentAI->Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_NORMAL,
-                CurrentAI->Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_NOTIFY_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0],
-                CurrentAI->Notify_Type ? NOTIFY_EVENT : NOTIFY_ALARM);
-            break;
-
-        case PROP_EVENT_TIME_STAMPS:
-            /* Array element zero is the number of elements in the array */
-            if (rpdata->array_index == 0)
-                apdu_len =
-                    encode_application_unsigned(&apdu[0],
-                    MAX_BACNET_EVENT_TRANSITION);
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            else if (rpdata->array_index == BACNET_ARRAY_ALL) {
-                for (i = 0; i < MAX_BACNET_EVENT_TRANSITION; i++) {;
-                    len =
-                        encode_opening_tag(&apdu[apdu_len],
-                        TIME_STAMP_DATETIME);
-                    len +=
-                        encode_application_date(&apdu[apdu_len + len],
-                        &CurrentAI->Event_Time_Stamps[i].date);
-                    len +=
-                        encode_application_time(&apdu[apdu_len + len],
-                        &CurrentAI->Event_Time_Stamps[i].time);
-                    len +=
-                        encode_closing_tag(&apdu[apdu_len + len],
-                        TIME_STAMP_DATETIME);
-
-                    /* add it if we have room */
-                    if ((apdu_len + len) < MAX_APDU)
-                        apdu_len += len;
-                    else {
-                        rpdata->error_class = ERROR_CLASS_SERVICES;
-                        rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                        apdu_len = BACNET_STATUS_ERROR;
-                        break;
-                    }
-                }
-            } else if (rpdata->array_index <= MAX_BACNET_EVENT_TRANSITION) {
-                apdu_len =
-                    encode_opening_tag(&apdu[apdu_len], TIME_STAMP_DATETIME);
-                apdu_len +=
-                    encode_application_date(&apdu[apdu_len],
-                    &CurrentAI->Event_Time_Stamps[rpdata->array_index].date);
-                apdu_len +=
-                    encode_application_time(&apdu[apdu_len],
-                    &CurrentAI->Event_Time_Stamps[rpdata->array_index].time);
-                apdu_len +=
-                    encode_closing_tag(&apdu[apdu_len], TIME_STAMP_DATETIME);
-            } else {
-                rpdata->error_class = ERROR_CLASS_PROPERTY;
-                rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                apdu_len = BACNET_STATUS_ERROR;
-            }
-            break;
-#endif
-
-//        case 9997:
-//            /* test case for real encoding-decoding unsigned value correctly */
-//            apdu_len = encode_application_real(&apdu[0], 90.510F);
-//            break;
-//        case 9998:
-//            /* test case for unsigned encoding-decoding unsigned value correctly */
-//            apdu_len = encode_application_unsigned(&apdu[0], 90);
-//            break;
-//        case 9999:
-//            /* test case for signed encoding-decoding negative value correctly */
-//            apdu_len = encode_application_signed(&apdu[0], -200);
-//            break;
-        default:
-            rpdata->error_class = ERROR_CLASS_PROPERTY;
-            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            apdu_len = BACNET_STATUS_ERROR;
-            break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->object_property != PROP_EVENT_TIME_STAMPS)
-        && (rpdata->array_index != BACNET_ARRAY_ALL)) {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+    return object_read_property(&Analog_Input_Class, rpdata);
 }
 
 /* returns true if successful */
 bool Analog_Input_Write_Property(
     BACNET_WRITE_PROPERTY_DATA * wp_data)
 {
-    bool status = false;        /* return value */
-    unsigned int object_index = 0;
-    int len = 0;
-    BACNET_APPLICATION_DATA_VALUE value;
-    ANALOG_INPUT_DESCR *CurrentAI;
-
-    /* decode the some of the request */
-    len =
-        bacapp_decode_application_data(wp_data->application_data,
-        wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0) {
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-        return false;
-    }
-    /*  only array properties can have array options */
-    if ((wp_data->object_property != PROP_EVENT_TIME_STAMPS) &&
-        (wp_data->array_index != BACNET_ARRAY_ALL)) {
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        return false;
-    }
-    object_index = Analog_Input_Instance_To_Index(wp_data->object_instance);
-    if (object_index < NUM_ANALOG_INPUTS) {
-        CurrentAI = &AI_Descr[object_index];
-    } else {
-        return false;
-    }
-
-    switch ((int) wp_data->object_property) {
-//        case PROP_PRESENT_VALUE:
-//            status =
-//                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-//                &wp_data->error_class, &wp_data->error_code);
-
-//            if (status) {
-//                if (CurrentAI->Out_Of_Service == true) {
-//                    Analog_Input_Present_Value_Set(wp_data->object_instance,
-//                        value.type.Real);
-//                } else {
-//                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-//                    wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-//                    status = false;
-//                }
-//            }
-//            break;
-
-        case PROP_OUT_OF_SERVICE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BOOLEAN,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                Analog_Input_Out_Of_Service_Set(
-                    wp_data->object_instance,
-                    value.type.Boolean);
-            }
-            break;
-
-        case PROP_UNITS:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                CurrentAI->Units = value.type.Enumerated;
-            }
-            break;
-
-        case PROP_COV_INCREMENT:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                if (value.type.Real >= 0.0f) {
-                    Analog_Input_COV_Increment_Set(
-                        wp_data->object_instance,
-                        value.type.Real);
-                } else {
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                }
-            }
-            break;
-
-#if defined(INTRINSIC_REPORTING)
-        case PROP_TIME_DELAY:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAI->Time_Delay = value.type.Unsigned_Int;
-                CurrentAI->Remaining_Time_Delay = CurrentAI->Time_Delay;
-            }
-            break;
-
-        case PROP_NOTIFICATION_CLASS:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAI->Notification_Class = value.type.Unsigned_Int;
-            }
-            break;
-
-        case PROP_HIGH_LIMIT:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAI->High_Limit = value.type.Real;
-            }
-            break;
-
-        case PROP_LOW_LIMIT:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAI->Low_Limit = value.type.Real;
-            }
-            break;
-
-        case PROP_DEADBAND:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAI->Deadband = value.type.Real;
-            }
-            break;
-
-        case PROP_LIMIT_ENABLE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BIT_STRING,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                if (value.type.Bit_String.bits_used == 2) {
-                    CurrentAI->Limit_Enable = value.type.Bit_String.value[0];
-                } else {
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                    status = false;
-                }
-            }
-            break;
-
-        case PROP_EVENT_ENABLE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BIT_STRING,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                if (value.type.Bit_String.bits_used == 3) {
-                    CurrentAI->Event_Enable = value.type.Bit_String.value[0];
-                } else {
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                    status = false;
-                }
-            }
-            break;
-
-        case PROP_NOTIFY_TYPE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                switch ((BACNET_NOTIFY_TYPE) value.type.Enumerated) {
-                    case NOTIFY_EVENT:
-                        CurrentAI->Notify_Type = 1;
-                        break;
-                    case NOTIFY_ALARM:
-                        CurrentAI->Notify_Type = 0;
-                        break;
-                    default:
-                        wp_data->error_class = ERROR_CLASS_PROPERTY;
-                        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                        status = false;
-                        break;
-                }
-            }
-            break;
-#endif
-        case PROP_OBJECT_IDENTIFIER:
-        case PROP_OBJECT_NAME:
-        case PROP_OBJECT_TYPE:
-        case PROP_STATUS_FLAGS:
-        case PROP_EVENT_STATE:
-        case PROP_DESCRIPTION:
-        case PROP_RELIABILITY:
-				case PROP_PRESENT_VALUE:
-#if defined(INTRINSIC_REPORTING)
-        case PROP_ACKED_TRANSITIONS:
-        case PROP_EVENT_TIME_STAMPS:
-#endif
-//        case 9997:
-//        case 9998:
-//        case 9999:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-            break;
-        default:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            break;
-    }
-		
-		if(AI_Descr[object_index].write_callback)
-		{
-			uint8_t id = bacQueue.call(AI_Descr[object_index].write_callback, (uint32_t)wp_data->object_property);
-		  
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_AI_WRCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_AI_WRCB_FAILED, id, 0); }
-		}
-    
-    return status;
+    return object_write_property(&Analog_Input_Class, wp_data);
 }
 
 
@@ -939,7 +738,7 @@ void Analog_Input_Intrinsic_Reporting(
 
     object_index = Analog_Input_Instance_To_Index(object_instance);
     if (object_index < NUM_ANALOG_INPUTS)
-        CurrentAI = &AI_Descr[object_index];
+        CurrentAI = Analog_Input_Descr(object_index);
     else
         return;
 
@@ -968,7 +767,7 @@ void Analog_Input_Intrinsic_Reporting(
         SendNotify = true;
     } else {
         /* actual Present_Value */
-        PresentVal = Analog_Input_Present_Value(object_instance);
+        PresentVal = AI_State.Present_Value[object_index];
         FromState = CurrentAI->Event_State;
         switch (CurrentAI->Event_State) {
             case EVENT_STATE_NORMAL:
@@ -1175,7 +974,7 @@ void Analog_Input_Intrinsic_Reporting(
                 statusFlags, STATUS_FLAG_OVERRIDDEN, false);
             bitstring_set_bit(&event_data.notificationParams.outOfRange.
                 statusFlags, STATUS_FLAG_OUT_OF_SERVICE,
-                CurrentAI->Out_Of_Service);
+                object_state_out_of_service(&AI_State, object_index));
             /* Deadband used for limit checking. */
             event_data.notificationParams.outOfRange.deadband =
                 CurrentAI->Deadband;
@@ -1233,16 +1032,16 @@ int Analog_Input_Event_Information(
     /* check index */
     if (index < NUM_ANALOG_INPUTS) {
         /* Event_State not equal to NORMAL */
-        IsActiveEvent = (AI_Descr[index].Event_State != EVENT_STATE_NORMAL);
+        IsActiveEvent = (Analog_Input_Descr(index)->Event_State != EVENT_STATE_NORMAL);
 
         /* Acked_Transitions property, which has at least one of the bits
            (TO-OFFNORMAL, TO-FAULT, TONORMAL) set to FALSE. */
         IsNotAckedTransitions =
-            (AI_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].
+            (Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
             bIsAcked ==
-            false) | (AI_Descr[index].Acked_Transitions[TRANSITION_TO_FAULT].
+            false) | (Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_FAULT].
             bIsAcked ==
-            false) | (AI_Descr[index].Acked_Transitions[TRANSITION_TO_NORMAL].
+            false) | (Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_NORMAL].
             bIsAcked == false);
     } else
         return -1;      /* end of list  */
@@ -1253,40 +1052,40 @@ int Analog_Input_Event_Information(
         getevent_data->objectIdentifier.instance =
             Analog_Input_Index_To_Instance(index);
         /* Event State */
-        getevent_data->eventState = AI_Descr[index].Event_State;
+        getevent_data->eventState = Analog_Input_Descr(index)->Event_State;
         /* Acknowledged Transitions */
         bitstring_init(&getevent_data->acknowledgedTransitions);
         bitstring_set_bit(&getevent_data->acknowledgedTransitions,
             TRANSITION_TO_OFFNORMAL,
-            AI_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].
+            Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
             bIsAcked);
         bitstring_set_bit(&getevent_data->acknowledgedTransitions,
             TRANSITION_TO_FAULT,
-            AI_Descr[index].Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
+            Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
         bitstring_set_bit(&getevent_data->acknowledgedTransitions,
             TRANSITION_TO_NORMAL,
-            AI_Descr[index].Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
+            Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
         /* Event Time Stamps */
         for (i = 0; i < 3; i++) {
             getevent_data->eventTimeStamps[i].tag = TIME_STAMP_DATETIME;
             getevent_data->eventTimeStamps[i].value.dateTime =
-                AI_Descr[index].Event_Time_Stamps[i];
+                Analog_Input_Descr(index)->Event_Time_Stamps[i];
         }
         /* Notify Type */
-        getevent_data->notifyType = AI_Descr[index].Notify_Type;
+        getevent_data->notifyType = Analog_Input_Descr(index)->Notify_Type;
         /* Event Enable */
         bitstring_init(&getevent_data->eventEnable);
         bitstring_set_bit(&getevent_data->eventEnable, TRANSITION_TO_OFFNORMAL,
-            (AI_Descr[index].
+            (Analog_Input_Descr(index)->
                 Event_Enable & EVENT_ENABLE_TO_OFFNORMAL) ? true : false);
         bitstring_set_bit(&getevent_data->eventEnable, TRANSITION_TO_FAULT,
-            (AI_Descr[index].
+            (Analog_Input_Descr(index)->
                 Event_Enable & EVENT_ENABLE_TO_FAULT) ? true : false);
         bitstring_set_bit(&getevent_data->eventEnable, TRANSITION_TO_NORMAL,
-            (AI_Descr[index].
+            (Analog_Input_Descr(index)->
                 Event_Enable & EVENT_ENABLE_TO_NORMAL) ? true : false);
         /* Event Priorities */
-        Notification_Class_Get_Priorities(AI_Descr[index].Notification_Class,
+        Notification_Class_Get_Priorities(Analog_Input_Descr(index)->Notification_Class,
             getevent_data->eventPriorities);
 
         return 1;       /* active event */
@@ -1308,7 +1107,7 @@ int Analog_Input_Alarm_Ack(
         instance);
 
     if (object_index < NUM_ANALOG_INPUTS)
-        CurrentAI = &AI_Descr[object_index];
+        CurrentAI = Analog_Input_Descr(object_index);
     else {
         *error_code = ERROR_CODE_UNKNOWN_OBJECT;
         return -1;
@@ -1404,27 +1203,27 @@ int Analog_Input_Alarm_Summary(
     if (index < NUM_ANALOG_INPUTS) {
         /* Event_State is not equal to NORMAL  and
            Notify_Type property value is ALARM */
-        if ((AI_Descr[index].Event_State != EVENT_STATE_NORMAL) &&
-            (AI_Descr[index].Notify_Type == NOTIFY_ALARM)) {
+        if ((Analog_Input_Descr(index)->Event_State != EVENT_STATE_NORMAL) &&
+            (Analog_Input_Descr(index)->Notify_Type == NOTIFY_ALARM)) {
             /* Object Identifier */
             getalarm_data->objectIdentifier.type = OBJECT_ANALOG_INPUT;
             getalarm_data->objectIdentifier.instance =
                 Analog_Input_Index_To_Instance(index);
             /* Alarm State */
-            getalarm_data->alarmState = AI_Descr[index].Event_State;
+            getalarm_data->alarmState = Analog_Input_Descr(index)->Event_State;
             /* Acknowledged Transitions */
             bitstring_init(&getalarm_data->acknowledgedTransitions);
             bitstring_set_bit(&getalarm_data->acknowledgedTransitions,
                 TRANSITION_TO_OFFNORMAL,
-                AI_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].
+                Analog_Input_Descr(index)->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
                 bIsAcked);
             bitstring_set_bit(&getalarm_data->acknowledgedTransitions,
                 TRANSITION_TO_FAULT,
-                AI_Descr[index].
+                Analog_Input_Descr(index)->
                 Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
             bitstring_set_bit(&getalarm_data->acknowledgedTransitions,
                 TRANSITION_TO_NORMAL,
-                AI_Descr[index].
+                Analog_Input_Descr(index)->
                 Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
 
             return 1;   /* active alarm */
@@ -53,11 +53,9 @@ extern "C" {
 				ai_callback write_callback;
         float COV_Increment;
         unsigned Event_State:3;
-        float Present_Value;
-		float Prior_Value;
+        /* Present_Value, Out_Of_Service and the COV state are kept
+           apart, see objstate.h */
         BACNET_RELIABILITY Reliability;
-        bool Out_Of_Service;
-        bool Changed;
 #if defined(INTRINSIC_REPORTING)
         uint32_t Time_Delay;
         uint32_t Notification_Class;
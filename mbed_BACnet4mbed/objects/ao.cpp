@@ -33,6 +33,9 @@
 #include "bacenum.h"
 #include "bacapp.h"
 #include "config_bacnet.h"     /* the custom stuff */
+#include "objindex.h"
+#include "objengine.h"
+#include "objcommand.h"
 #include "wp.h"
 #include "ao.h"
 #include "handlers.h"
@@ -42,41 +45,184 @@
 
 extern EventQueue bacQueue;
 
-
-/* we choose to have a NULL level in our system represented by */
-/* a particular value.  When the priorities are not in use, they */
-/* will be relinquished (i.e. set to the NULL level). */
-#define AO_LEVEL_NULL NULL
-/* When all the priorities are level null, the present value returns */
-/* the Relinquish Default value */
-#define AO_RELINQUISH_DEFAULT 0
-
 extern ANALOG_OUTPUT_DESCR AO_Descr[];
 
 uint32_t NUM_ANALOG_OUTPUTS;
+/* instance number to AO_Descr[] index */
+static OBJECT_INDEX AO_Index;
 
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_UNITS,
-    PROP_PRIORITY_ARRAY,
-    PROP_RELINQUISH_DEFAULT,
-    -1
-};
+/* the descriptor of an instance, NULL if there is none */
+static ANALOG_OUTPUT_DESCR *Analog_Output_Object(
+    uint32_t object_instance)
+{
+    unsigned index = 0;
+
+    if (object_index_find(&AO_Index, object_instance, &index))
+        return &AO_Descr[index];
+
+    return NULL;
+}
+
+static void Analog_Output_Read_Notify(
+    ANALOG_OUTPUT_DESCR * object,
+    BACNET_PROPERTY_ID object_property)
+{
+    if (object->read_callback) {
+        uint8_t id = bacQueue.call(object->read_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_AO_RDCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_AO_RDCB_FAILED, id, 0); }
+    }
+}
+
+static void Analog_Output_Write_Notify(
+    ANALOG_OUTPUT_DESCR * object,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (object->write_callback) {
+        /* a relinquish passes the value now in charge */
+        float level = (value->tag == BACNET_APPLICATION_TAG_NULL) ?
+            object->Effective_Value : value->type.Real;
 
-static const int Properties_Optional[] = {
-    PROP_DESCRIPTION,
-    -1
+        EVRECORD2(BACNET_EVQ_AO_VAL_DECODED, level, 0);
+
+        uint8_t id = bacQueue.call(object->write_callback,
+            (uint32_t) object_property, level);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_AO_WRCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_AO_WRCB_FAILED, id, 0); }
+    }
+}
+
+/* a change of the present value by COV_Increment or more is reported
+   by COV */
+static void Analog_Output_Changed(
+    ANALOG_OUTPUT_DESCR * object)
+{
+    float cov_delta = 0.0f;
+
+    if (object->Prior_Value > object->Effective_Value) {
+        cov_delta = object->Prior_Value - object->Effective_Value;
+    } else {
+        cov_delta = object->Effective_Value - object->Prior_Value;
+    }
+    if (cov_delta >= object->COV_Increment) {
+        object->Changed = true;
+        object->Prior_Value = object->Effective_Value;
+        handler_cov_object_changed(OBJECT_ANALOG_OUTPUT,
+            object->Object_Instance);
+    }
+}
+
+static int Analog_Output_Read_Present_Value(
+    ANALOG_OUTPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        object->Effective_Value);
+}
+
+static bool Analog_Output_Write_Present_Value(
+    ANALOG_OUTPUT_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if ((value->tag != BACNET_APPLICATION_TAG_NULL) &&
+        !WPValidateArgType(value, BACNET_APPLICATION_TAG_REAL,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    if (!object_write_priority_valid(wp_data))
+        return false;
+    if (value->tag == BACNET_APPLICATION_TAG_NULL)
+        return object_command_relinquish(object, wp_data->priority,
+            Analog_Output_Changed);
+
+    return object_command_set(object, wp_data->priority, value->type.Real,
+        Analog_Output_Changed);
+}
+
+static int Analog_Output_Encode_Priority(
+    ANALOG_OUTPUT_DESCR * object,
+    unsigned element,
+    uint8_t * apdu)
+{
+    if (!object_command_active(object, element + 1))
+        return encode_application_null(&apdu[0]);
+
+    return encode_application_real(&apdu[0], object->Present_Value[element]);
+}
+
+static int Analog_Output_Read_Priority_Array(
+    ANALOG_OUTPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return object_read_array(object, rpdata, BACNET_MAX_PRIORITY,
+        Analog_Output_Encode_Priority);
+}
+
+static int Analog_Output_Read_Relinquish_Default(
+    ANALOG_OUTPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        object->Relinquish_Default);
+}
+
+/* The properties of the Analog Output object type, the ReadProperty,
+   WriteProperty and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<ANALOG_OUTPUT_DESCR>
+    Analog_Output_Properties[] = {
+    {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+        object_read_object_identifier<ANALOG_OUTPUT_DESCR>, NULL},
+    {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+        object_read_string<ANALOG_OUTPUT_DESCR,
+            &ANALOG_OUTPUT_DESCR::Object_Name>, NULL},
+    {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+        object_read_object_type<ANALOG_OUTPUT_DESCR>, NULL},
+    {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Analog_Output_Read_Present_Value,
+        Analog_Output_Write_Present_Value},
+    {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        object_read_status_flags<ANALOG_OUTPUT_DESCR>, NULL},
+    {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+        object_read_event_state<ANALOG_OUTPUT_DESCR>, NULL},
+    {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+        object_read_out_of_service<ANALOG_OUTPUT_DESCR>,
+        object_write_out_of_service<ANALOG_OUTPUT_DESCR>},
+    {PROP_UNITS, OBJ_PROP_REQUIRED,
+        object_read_units<ANALOG_OUTPUT_DESCR>, NULL},
+    {PROP_PRIORITY_ARRAY, OBJ_PROP_REQUIRED | OBJ_PROP_ARRAY,
+        Analog_Output_Read_Priority_Array, NULL},
+    {PROP_RELINQUISH_DEFAULT, OBJ_PROP_REQUIRED,
+        Analog_Output_Read_Relinquish_Default, NULL},
+    {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+        object_read_string<ANALOG_OUTPUT_DESCR,
+            &ANALOG_OUTPUT_DESCR::Object_Description>, NULL},
+    {PROP_COV_INCREMENT, OBJ_PROP_OPTIONAL,
+        object_read_cov_increment<ANALOG_OUTPUT_DESCR>,
+        object_write_cov_increment<ANALOG_OUTPUT_DESCR>},
 };
 
-static const int Properties_Proprietary[] = {
-    -1
+static int Analog_Output_Property_List[
+    OBJ_PROPERTY_COUNT(Analog_Output_Properties) + 3];
+static uint8_t Analog_Output_Property_Order[
+    OBJ_PROPERTY_COUNT(Analog_Output_Properties) + 1];
+
+static const BACnet_Object_Class<ANALOG_OUTPUT_DESCR> Analog_Output_Class = {
+    OBJECT_ANALOG_OUTPUT,
+    Analog_Output_Properties,
+    OBJ_PROPERTY_COUNT(Analog_Output_Properties),
+    Analog_Output_Property_List,
+    Analog_Output_Property_Order,
+    Analog_Output_Object,
+    Analog_Output_Read_Notify,
+    Analog_Output_Write_Notify
 };
 
 void Analog_Output_Property_Lists(
@@ -84,27 +230,34 @@ void Analog_Output_Property_Lists(
     const int **pOptional,
     const int **pProprietary)
 {
-    if (pRequired)
-        *pRequired = Properties_Required;
-    if (pOptional)
-        *pOptional = Properties_Optional;
-    if (pProprietary)
-        *pProprietary = Properties_Proprietary;
-
-    return;
+    object_property_lists(&Analog_Output_Class, pRequired, pOptional,
+        pProprietary);
 }
 
 void Analog_Output_Init(
     void)
 {
-    unsigned i, j;
-
-		/* initialize all the analog output priority arrays to NULL */
-		for (i = 0; i < Analog_Output_Count(); i++) {
-				for (j = 0; j < BACNET_MAX_PRIORITY; j++) {
-						AO_Descr[i].Present_Value[j] = AO_LEVEL_NULL;
-				}
-		}
+    unsigned i;
+
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_ANALOG_OUTPUTS = 0;
+    while (AO_Descr[NUM_ANALOG_OUTPUTS].Object_Instance <= BACNET_MAX_INSTANCE)
+        NUM_ANALOG_OUTPUTS++;
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&AO_Index, NUM_ANALOG_OUTPUTS, NUM_ANALOG_OUTPUTS,
+            Analog_Output_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_ANALOG_OUTPUT,
+            NUM_ANALOG_OUTPUTS); }
+
+    /* initialize all the analog output priority arrays to NULL */
+    for (i = 0; i < NUM_ANALOG_OUTPUTS; i++) {
+        object_command_init(&AO_Descr[i]);
+        AO_Descr[i].Prior_Value = AO_Descr[i].Effective_Value;
+        AO_Descr[i].Changed = false;
+        AO_Descr[i].COV_Increment =
+            (AO_Descr[i].COV_Increment == 0.0f) ? 1.0f :
+            AO_Descr[i].COV_Increment;
+    }
 
     return;
 }
@@ -129,13 +282,7 @@ bool Analog_Output_Valid_Instance(
 unsigned Analog_Output_Count(
     void)
 {
-	uint32_t i=0;
-	
-	while(AO_Descr[i].Object_Instance <= BACNET_MAX_INSTANCE)
-		i++;
-	
-	NUM_ANALOG_OUTPUTS = i;
-  return i;
+    return NUM_ANALOG_OUTPUTS;
 }
 
 /* we simply have 0-n object instances.  Yours might be */
@@ -155,53 +302,32 @@ unsigned Analog_Output_Instance_To_Index(
 {
     unsigned index = 0;
 
-    for(index=0; index<NUM_ANALOG_OUTPUTS; index++)
-		{
-			if(AO_Descr[index].Object_Instance == object_instance)
-				return index;
-		}
+    if (object_index_find(&AO_Index, object_instance, &index))
+        return index;
 
-    return index;
+    return NUM_ANALOG_OUTPUTS;
 }
 
 float Analog_Output_Present_Value(
     uint32_t object_instance)
 {
-    float value = AO_RELINQUISH_DEFAULT;
-    unsigned index = 0;
-    unsigned i = 0;
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
 
-    index = Analog_Output_Instance_To_Index(object_instance);
-    if (index < NUM_ANALOG_OUTPUTS) {
-        for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-            if (AO_Descr[index].Present_Value[i] != AO_LEVEL_NULL) {
-                value = AO_Descr[index].Present_Value[i];
-                break;
-            }
-        }
-    }
+    if (object)
+        return object->Effective_Value;
 
-    return value;
+    return 0.0f;
 }
 
 unsigned Analog_Output_Present_Value_Priority(
     uint32_t object_instance)
 {
-    unsigned index = 0; /* instance to index conversion */
-    unsigned i = 0;     /* loop counter */
-    unsigned priority = 0;      /* return value */
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
 
-    index = Analog_Output_Instance_To_Index(object_instance);
-    if (index < NUM_ANALOG_OUTPUTS) {
-        for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-            if (AO_Descr[index].Present_Value[i] != AO_LEVEL_NULL) {
-                priority = i + 1;
-                break;
-            }
-        }
-    }
+    if (object)
+        return object_command_priority(object);
 
-    return priority;
+    return 0;
 }
 
 bool Analog_Output_Present_Value_Set(
@@ -209,21 +335,80 @@ bool Analog_Output_Present_Value_Set(
     float value,
     unsigned priority)
 {
-    unsigned index = 0;
-    bool status = false;
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
 
-    index = Analog_Output_Instance_To_Index(object_instance);
-    if (index < NUM_ANALOG_OUTPUTS) {
-        if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-            (priority != 6 /* reserved */ )) {
-            AO_Descr[index].Present_Value[priority - 1] = value;
-            status = true;
-        }
-    }
+    if (object && (priority != 6 /* reserved */ ))
+        return object_command_set(object, priority, value,
+            Analog_Output_Changed);
 
-    return status;
+    return false;
+}
+
+bool Analog_Output_Present_Value_Relinquish(
+    uint32_t object_instance,
+    unsigned priority)
+{
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
+
+    if (object && (priority != 6 /* reserved */ ))
+        return object_command_relinquish(object, priority,
+            Analog_Output_Changed);
+
+    return false;
+}
+
+/* returns true if value has changed */
+bool Analog_Output_Encode_Value_List(
+    uint32_t object_instance,
+    BACNET_PROPERTY_VALUE * value_list)
+{
+    if (!object_encode_value_list(&Analog_Output_Class, object_instance,
+            value_list))
+        return false;
+
+    return Analog_Output_Change_Of_Value(object_instance);
+}
+
+bool Analog_Output_Change_Of_Value(
+    uint32_t object_instance)
+{
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
+
+    if (object)
+        return object->Changed;
+
+    return false;
+}
+
+void Analog_Output_Change_Of_Value_Clear(
+    uint32_t object_instance)
+{
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
+
+    if (object)
+        object->Changed = false;
 }
 
+float Analog_Output_COV_Increment(
+    uint32_t object_instance)
+{
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
+
+    if (object)
+        return object->COV_Increment;
+
+    return 0.0f;
+}
+
+void Analog_Output_COV_Increment_Set(
+    uint32_t object_instance,
+    float value)
+{
+    ANALOG_OUTPUT_DESCR *object = Analog_Output_Object(object_instance);
+
+    if (object)
+        object->COV_Increment = value;
+}
 
 /* note: the object name must be unique within this device */
 bool Analog_Output_Object_Name(
@@ -264,273 +449,12 @@ bool Analog_Output_Object_Description(
 int Analog_Output_Read_Property(
     BACNET_READ_PROPERTY_DATA * rpdata)
 {
-    int len = 0;
-    int apdu_len = 0;   /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    float real_value = (float) 1.414;
-    unsigned object_index = 0;
-    unsigned i = 0;
-    bool state = false;
-    uint8_t *apdu = NULL;
-
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
-        return 0;
-    }
-		
-    object_index = Analog_Output_Instance_To_Index(rpdata->object_instance);
-		
-		if(AO_Descr[object_index].read_callback)
-		{
-		  uint8_t id = bacQueue.call(AO_Descr[object_index].read_callback, (uint32_t)rpdata->object_property);
-				
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_AO_RDCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_AO_RDCB_FAILED, id, 0); }
-		}
-				
-    apdu = rpdata->application_data;
-    switch (rpdata->object_property) {
-        case PROP_OBJECT_IDENTIFIER:
-            apdu_len =
-                encode_application_object_id(&apdu[0], OBJECT_ANALOG_OUTPUT,
-                rpdata->object_instance);
-            break;
-        case PROP_OBJECT_NAME:
-            Analog_Output_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_DESCRIPTION:
-            Analog_Output_Object_Description(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_OBJECT_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], OBJECT_ANALOG_OUTPUT);
-            break;
-        case PROP_PRESENT_VALUE:
-            real_value = Analog_Output_Present_Value(rpdata->object_instance);
-            apdu_len = encode_application_real(&apdu[0], real_value);
-            break;
-        case PROP_STATUS_FLAGS:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE, false);
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-        case PROP_EVENT_STATE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], EVENT_STATE_NORMAL);
-            break;
-        case PROP_OUT_OF_SERVICE:
-            object_index =
-                Analog_Output_Instance_To_Index(rpdata->object_instance);
-            state = AO_Descr[object_index].Out_Of_Service;
-            apdu_len = encode_application_boolean(&apdu[0], state);
-            break;
-        case PROP_UNITS:
-            apdu_len = encode_application_enumerated(&apdu[0], UNITS_PERCENT);
-            break;
-        case PROP_PRIORITY_ARRAY:
-            /* Array element zero is the number of elements in the array */
-            if (rpdata->array_index == 0)
-                apdu_len =
-                    encode_application_unsigned(&apdu[0], BACNET_MAX_PRIORITY);
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            else if (rpdata->array_index == BACNET_ARRAY_ALL) {
-                object_index =
-                    Analog_Output_Instance_To_Index(rpdata->object_instance);
-                for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-                    /* FIXME: check if we have room before adding it to APDU */
-                    if (AO_Descr[object_index].Present_Value[i] == AO_LEVEL_NULL)
-                        len = encode_application_null(&apdu[apdu_len]);
-                    else {
-                        real_value = AO_Descr[object_index].Present_Value[i];
-                        len =
-                            encode_application_real(&apdu[apdu_len],
-                            real_value);
-                    }
-                    /* add it if we have room */
-                    if ((apdu_len + len) < MAX_APDU)
-                        apdu_len += len;
-                    else {
-                        rpdata->error_class = ERROR_CLASS_SERVICES;
-                        rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                        apdu_len = BACNET_STATUS_ERROR;
-                        break;
-                    }
-                }
-            } else {
-                object_index =
-                    Analog_Output_Instance_To_Index(rpdata->object_instance);
-                if (rpdata->array_index <= BACNET_MAX_PRIORITY) {
-                    if (AO_Descr[object_index].Present_Value[rpdata->array_index - 1] == AO_LEVEL_NULL)
-                        apdu_len = encode_application_null(&apdu[0]);
-                    else {
-                        real_value = AO_Descr[object_index].Present_Value[rpdata->array_index - 1];
-                        apdu_len =
-                            encode_application_real(&apdu[0], real_value);
-                    }
-                } else {
-                    rpdata->error_class = ERROR_CLASS_PROPERTY;
-                    rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                    apdu_len = BACNET_STATUS_ERROR;
-                }
-            }
-            break;
-        case PROP_RELINQUISH_DEFAULT:
-            real_value = AO_RELINQUISH_DEFAULT;
-            apdu_len = encode_application_real(&apdu[0], real_value);
-            break;
-        default:
-            rpdata->error_class = ERROR_CLASS_PROPERTY;
-            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            apdu_len = BACNET_STATUS_ERROR;
-            break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->object_property != PROP_PRIORITY_ARRAY) &&
-        (rpdata->array_index != BACNET_ARRAY_ALL)) {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+    return object_read_property(&Analog_Output_Class, rpdata);
 }
 
 /* returns true if successful */
 bool Analog_Output_Write_Property(
     BACNET_WRITE_PROPERTY_DATA * wp_data)
 {
-    bool status = false;        /* return value */
-    unsigned int object_index = 0;
-    int len = 0;
-    unsigned int priority = 0;
-    BACNET_APPLICATION_DATA_VALUE value;
-
-    /* decode the some of the request */
-    len =
-        bacapp_decode_application_data(wp_data->application_data,
-        wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0) {
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-        return false;
-    }
-    /*  only array properties can have array options */
-    if ((wp_data->object_property != PROP_PRIORITY_ARRAY) &&
-        (wp_data->array_index != BACNET_ARRAY_ALL)) {
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        return false;
-    }
-		
-		object_index = Analog_Output_Instance_To_Index(wp_data->object_instance);
-		
-    switch (wp_data->object_property) {
-        case PROP_PRESENT_VALUE:
-						priority = wp_data->priority;
-						status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL, &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                /* Command priority 6 is reserved for use by Minimum On/Off
-                   algorithm and may not be used for other purposes in any
-                   object. */
-								if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-                    (priority != 6 /* reserved */ )) {
-										status = Analog_Output_Present_Value_Set(wp_data->object_instance, value.type.Real, priority);
-                } else if (priority == 6) {
-                    /* Command priority 6 is reserved for use by Minimum On/Off
-                       algorithm and may not be used for other purposes in any
-                       object. */
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                } else {
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                }
-            } else {
-								status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_NULL, &wp_data->error_class, &wp_data->error_code);
-								if (status) {
-										if (priority && (priority <= BACNET_MAX_PRIORITY) && (priority != 6 /* reserved */ )) {
-												status = Analog_Output_Present_Value_Set(wp_data->object_instance, AO_LEVEL_NULL, priority);
-										}	else if (priority == 6) {
-												wp_data->error_class = ERROR_CLASS_PROPERTY;
-												wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-										} else {
-												wp_data->error_class = ERROR_CLASS_PROPERTY;
-												wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-										}
-								} else {
-										status = false;
-										wp_data->error_class = ERROR_CLASS_PROPERTY;
-										wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
-								}
-            }
-            break;
-        case PROP_OUT_OF_SERVICE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BOOLEAN,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                object_index =
-                    Analog_Output_Instance_To_Index(wp_data->object_instance);
-                AO_Descr[object_index].Out_Of_Service =
-                    value.type.Boolean;
-            }
-            break;
-        case PROP_OBJECT_IDENTIFIER:
-        case PROP_OBJECT_NAME:
-        case PROP_OBJECT_TYPE:
-        case PROP_STATUS_FLAGS:
-        case PROP_EVENT_STATE:
-        case PROP_UNITS:
-        case PROP_PRIORITY_ARRAY:
-        case PROP_RELINQUISH_DEFAULT:
-        case PROP_DESCRIPTION:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-            break;
-        default:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            break;
-    }
-		
-		if(status)
-		{
-			if(AO_Descr[object_index].write_callback)
-			{
-				BACNET_APPLICATION_DATA_VALUE value;
-				len = bacapp_decode_application_data(wp_data->application_data,
-																						 wp_data->application_data_len,
-																						 &value);
-				
-				if(len > 0)
-				{ EVRECORD2(BACNET_EVQ_AO_VAL_DECODED, value.type.Real, len); }
-				else
-				{ EVRECORD2(BACNET_EVQ_AO_VAL_DECODE_FAIL, len, 0); }
-				
-				uint8_t id = bacQueue.call(AO_Descr[object_index].write_callback,
-																	 (uint32_t)wp_data->object_property,
-																	 (float)   value.type.Real);
-					
-				if(id > 0)
-				{ EVRECORD2(BACNET_EVQ_AO_WRCB_CALLED, id, 0); }
-				else
-				{ EVRECORD2(BACNET_EVQ_AO_WRCB_FAILED, id, 0); }
-			}
-		}
-		
-    return status;
+    return object_write_property(&Analog_Output_Class, wp_data);
 }
-
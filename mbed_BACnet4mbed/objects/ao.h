@@ -46,10 +46,18 @@ extern "C" {
       uint16_t Units;
 			ao_callback_rd read_callback;
 			ao_callback_wr write_callback;
+			float COV_Increment;
 			unsigned Event_State:3;
 			float Present_Value[16];
+			/* see objcommand.h */
+			uint16_t Priority_Active;
+			float Relinquish_Default;
+			float Effective_Value;
 			BACNET_RELIABILITY Reliability;
 			bool Out_Of_Service;
+			/* the present value last reported by COV */
+			float Prior_Value;
+			bool Changed;
 		} ANALOG_OUTPUT_DESCR;
 	
     void Analog_Output_Property_Lists(
@@ -79,6 +87,19 @@ extern "C" {
         uint32_t object_instance,
         unsigned priority);
 
+    bool Analog_Output_Encode_Value_List(
+        uint32_t object_instance,
+        BACNET_PROPERTY_VALUE * value_list);
+    bool Analog_Output_Change_Of_Value(
+        uint32_t instance);
+    void Analog_Output_Change_Of_Value_Clear(
+        uint32_t instance);
+    float Analog_Output_COV_Increment(
+        uint32_t instance);
+    void Analog_Output_COV_Increment_Set(
+        uint32_t instance,
+        float value);
+
     bool Analog_Output_Object_Name(
         uint32_t object_instance,
         BACNET_CHARACTER_STRING * object_name);
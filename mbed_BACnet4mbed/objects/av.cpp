@@ -37,6 +37,11 @@
 #include "bacapp.h"
 #include "bactext.h"
 #include "config_bacnet.h"     /* the custom stuff */
+#include "objindex.h"
+#include "objpool.h"
+#include "objstate.h"
+#include "objengine.h"
+#include "objcommand.h"
 #include "device_obj.h"
 #include "handlers.h"
 #include "av.h"
@@ -51,46 +56,287 @@
 extern EventQueue bacQueue;
 extern ANALOG_VALUE_DESCR AV_Descr[];
 uint32_t NUM_ANALOG_VALUES;
+/* instance number to AV_Descr[] index */
+static OBJECT_INDEX AV_Index;
+/* AV_Descr[] are followed by the objects created at runtime */
+static unsigned AV_Static_Count;
+
+typedef struct analog_value_object {
+    ANALOG_VALUE_DESCR Descr;
+    char Name[MAX_CREATED_OBJECT_NAME_LEN + 1];
+} ANALOG_VALUE_OBJECT;
+
+static ANALOG_VALUE_OBJECT AV_Created[MAX_CREATED_OBJECTS];
+static uint16_t AV_Created_Order[MAX_CREATED_OBJECTS];
+static OBJECT_POOL AV_Pool;
+static char AV_No_Description[] = "";
+/* Out_Of_Service and the COV state, by index; the present value stays
+   with the priority array */
+static OBJECT_STATE AV_State;
+
+/* the descriptor at an index of the instance index */
+static ANALOG_VALUE_DESCR *Analog_Value_Descr(
+    unsigned index)
+{
+    if (index < AV_Static_Count)
+        return &AV_Descr[index];
 
-#define AV_LEVEL_NULL NULL
-#define AV_RELINQUISH_DEFAULT 0
-
-
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Analog_Value_Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_UNITS,
-    -1
-};
+    return (ANALOG_VALUE_DESCR *) object_pool_at(&AV_Pool,
+        index - AV_Static_Count);
+}
+
+/* the index of a descriptor, i.e. its position in AV_State */
+static unsigned Analog_Value_Position(
+    const ANALOG_VALUE_DESCR * object)
+{
+    if ((object >= &AV_Descr[0]) && (object < &AV_Descr[AV_Static_Count]))
+        return (unsigned) (object - &AV_Descr[0]);
+
+    return AV_Static_Count + object_pool_position(&AV_Pool, object);
+}
+
+/* the descriptor of an instance, NULL if there is none */
+static ANALOG_VALUE_DESCR *Analog_Value_Object(
+    uint32_t object_instance)
+{
+    unsigned index = 0;
 
-static const int Analog_Value_Properties_Optional[] = {
-    PROP_DESCRIPTION,
-	PROP_COV_INCREMENT,
-    PROP_PRIORITY_ARRAY,
-    PROP_RELINQUISH_DEFAULT,
+    if (object_index_find(&AV_Index, object_instance, &index))
+        return Analog_Value_Descr(index);
+
+    return NULL;
+}
+
+static void Analog_Value_Read_Notify(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_PROPERTY_ID object_property)
+{
+    if (object->read_callback) {
+        uint8_t id = bacQueue.call(object->read_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_AV_RDCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_AV_RDCB_FAILED, id, 0); }
+    }
+}
+
+static void Analog_Value_Write_Notify(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (object->write_callback && !object->PV_WriteProtected) {
+        /* a relinquish passes the value now in charge */
+        float level = (value->tag == BACNET_APPLICATION_TAG_NULL) ?
+            object->Effective_Value : value->type.Real;
+        uint8_t id = bacQueue.call(object->write_callback,
+            (uint32_t) object_property, level);
+
+        if (id > 0) { EVRECORD2(BACNET_EVQ_AV_WRCB_CALLED, id, 0); }
+        else       { EVRECORD2(BACNET_EVQ_AV_WRCB_FAILED, id, 0); }
+    }
+}
+
+static int Analog_Value_Read_Present_Value(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        object->Effective_Value);
+}
+
+static bool Analog_Value_Write_Present_Value(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if ((value->tag != BACNET_APPLICATION_TAG_NULL) &&
+        !WPValidateArgType(value, BACNET_APPLICATION_TAG_REAL,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    /* If explicitly defined as such, any write attempt to
+       PRESENT_VALUE will be blocked / answered with an
+       error message. */
+    if (object->PV_WriteProtected) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+    if (!object_write_priority_valid(wp_data))
+        return false;
+    if (value->tag == BACNET_APPLICATION_TAG_NULL)
+        return Analog_Value_Present_Value_Relinquish(
+            wp_data->object_instance, wp_data->priority);
+
+    return Analog_Value_Present_Value_Set(wp_data->object_instance,
+        value->type.Real, wp_data->priority);
+}
+
+static int Analog_Value_Encode_Priority(
+    ANALOG_VALUE_DESCR * object,
+    unsigned element,
+    uint8_t * apdu)
+{
+    if (!object_command_active(object, element + 1))
+        return encode_application_null(&apdu[0]);
+
+    return encode_application_real(&apdu[0], object->Present_Value[element]);
+}
+
+static int Analog_Value_Read_Priority_Array(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return object_read_array(object, rpdata, BACNET_MAX_PRIORITY,
+        Analog_Value_Encode_Priority);
+}
+
+static int Analog_Value_Read_Status_Flags(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return object_encode_status_flags(&rpdata->application_data[0],
+        object->Event_State,
+        object_state_out_of_service(&AV_State,
+            Analog_Value_Position(object)));
+}
+
+static int Analog_Value_Read_Out_Of_Service(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_boolean(&rpdata->application_data[0],
+        object_state_out_of_service(&AV_State,
+            Analog_Value_Position(object)));
+}
+
+static bool Analog_Value_Write_Out_Of_Service(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_BOOLEAN,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object_state_out_of_service_set(&AV_State,
+        Analog_Value_Position(object), value->type.Boolean);
+
+    return true;
+}
+
+static int Analog_Value_Read_Relinquish_Default(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        object->Relinquish_Default);
+}
+
+/* only the objects created at runtime have a buffer for a new name */
+static bool Analog_Value_Write_Object_Name(
+    ANALOG_VALUE_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!object_pool_owns(&AV_Pool, object)) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+
+    return object_write_name(wp_data, value,
+        ((ANALOG_VALUE_OBJECT *) object)->Name, sizeof(((ANALOG_VALUE_OBJECT *) object)->Name));
+}
+
+/* The properties of the Analog Value object type, the ReadProperty,
+   WriteProperty and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<ANALOG_VALUE_DESCR>
+    Analog_Value_Properties[] = {
+    {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+        object_read_object_identifier<ANALOG_VALUE_DESCR>, NULL},
+    {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+        object_read_string<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::Object_Name>,
+        Analog_Value_Write_Object_Name},
+    {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+        object_read_object_type<ANALOG_VALUE_DESCR>, NULL},
+    {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Analog_Value_Read_Present_Value,
+        Analog_Value_Write_Present_Value},
+    {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Analog_Value_Read_Status_Flags, NULL},
+    {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+        object_read_event_state<ANALOG_VALUE_DESCR>, NULL},
+    {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+        Analog_Value_Read_Out_Of_Service,
+        Analog_Value_Write_Out_Of_Service},
+    {PROP_UNITS, OBJ_PROP_REQUIRED,
+        object_read_units<ANALOG_VALUE_DESCR>,
+        object_write_units<ANALOG_VALUE_DESCR>},
+    {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+        object_read_string<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::Object_Description>, NULL},
+    {PROP_COV_INCREMENT, OBJ_PROP_OPTIONAL,
+        object_read_cov_increment<ANALOG_VALUE_DESCR>,
+        object_write_cov_increment<ANALOG_VALUE_DESCR>},
+    {PROP_PRIORITY_ARRAY, OBJ_PROP_OPTIONAL | OBJ_PROP_ARRAY,
+        Analog_Value_Read_Priority_Array, NULL},
+    {PROP_RELINQUISH_DEFAULT, OBJ_PROP_OPTIONAL,
+        Analog_Value_Read_Relinquish_Default, NULL},
 #if defined(INTRINSIC_REPORTING)
-    PROP_TIME_DELAY,
-    PROP_NOTIFICATION_CLASS,
-    PROP_HIGH_LIMIT,
-    PROP_LOW_LIMIT,
-    PROP_DEADBAND,
-    PROP_LIMIT_ENABLE,
-    PROP_EVENT_ENABLE,
-    PROP_ACKED_TRANSITIONS,
-    PROP_NOTIFY_TYPE,
-    PROP_EVENT_TIME_STAMPS,
+    {PROP_TIME_DELAY, OBJ_PROP_OPTIONAL,
+        object_read_time_delay<ANALOG_VALUE_DESCR>,
+        object_write_time_delay<ANALOG_VALUE_DESCR>},
+    {PROP_NOTIFICATION_CLASS, OBJ_PROP_OPTIONAL,
+        object_read_notification_class<ANALOG_VALUE_DESCR>,
+        object_write_notification_class<ANALOG_VALUE_DESCR>},
+    {PROP_HIGH_LIMIT, OBJ_PROP_OPTIONAL,
+        object_read_real<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::High_Limit>,
+        object_write_real<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::High_Limit>},
+    {PROP_LOW_LIMIT, OBJ_PROP_OPTIONAL,
+        object_read_real<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::Low_Limit>,
+        object_write_real<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::Low_Limit>},
+    {PROP_DEADBAND, OBJ_PROP_OPTIONAL,
+        object_read_real<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::Deadband>,
+        object_write_real<ANALOG_VALUE_DESCR,
+            &ANALOG_VALUE_DESCR::Deadband>},
+    {PROP_LIMIT_ENABLE, OBJ_PROP_OPTIONAL,
+        object_read_limit_enable<ANALOG_VALUE_DESCR>,
+        object_write_limit_enable<ANALOG_VALUE_DESCR>},
+    {PROP_EVENT_ENABLE, OBJ_PROP_OPTIONAL,
+        object_read_event_enable<ANALOG_VALUE_DESCR>,
+        object_write_event_enable<ANALOG_VALUE_DESCR>},
+    {PROP_ACKED_TRANSITIONS, OBJ_PROP_OPTIONAL,
+        object_read_acked_transitions<ANALOG_VALUE_DESCR>, NULL},
+    {PROP_NOTIFY_TYPE, OBJ_PROP_OPTIONAL,
+        object_read_notify_type<ANALOG_VALUE_DESCR>,
+        object_write_notify_type<ANALOG_VALUE_DESCR>},
+    {PROP_EVENT_TIME_STAMPS, OBJ_PROP_OPTIONAL | OBJ_PROP_ARRAY,
+        object_read_event_time_stamps<ANALOG_VALUE_DESCR>, NULL},
 #endif
-    -1
 };
 
-static const int Analog_Value_Properties_Proprietary[] = {
-    -1
+static int Analog_Value_Property_List[
+    OBJ_PROPERTY_COUNT(Analog_Value_Properties) + 3];
+static uint8_t Analog_Value_Property_Order[
+    OBJ_PROPERTY_COUNT(Analog_Value_Properties) + 1];
+
+static const BACnet_Object_Class<ANALOG_VALUE_DESCR> Analog_Value_Class = {
+    OBJECT_ANALOG_VALUE,
+    Analog_Value_Properties,
+    OBJ_PROPERTY_COUNT(Analog_Value_Properties),
+    Analog_Value_Property_List,
+    Analog_Value_Property_Order,
+    Analog_Value_Object,
+    Analog_Value_Read_Notify,
+    Analog_Value_Write_Notify
 };
 
 void Analog_Value_Property_Lists(
@@ -98,34 +344,47 @@ void Analog_Value_Property_Lists(
     const int **pOptional,
     const int **pProprietary)
 {
-    if (pRequired)
-        *pRequired = Analog_Value_Properties_Required;
-    if (pOptional)
-        *pOptional = Analog_Value_Properties_Optional;
-    if (pProprietary)
-        *pProprietary = Analog_Value_Properties_Proprietary;
-
-    return;
+    object_property_lists(&Analog_Value_Class, pRequired, pOptional,
+        pProprietary);
 }
 
 void Analog_Value_Init(
     void)
 {
-	unsigned i, j;
-	float dummy;
+	unsigned i;
+#if defined(INTRINSIC_REPORTING)
+	unsigned j;
+#endif
 
-    for (i = 0; i < Analog_Value_Count(); i++)
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_ANALOG_VALUES = 0;
+    while (AV_Descr[NUM_ANALOG_VALUES].Object_Instance <= BACNET_MAX_INSTANCE)
+        NUM_ANALOG_VALUES++;
+    AV_Static_Count = NUM_ANALOG_VALUES;
+    object_pool_init(&AV_Pool, AV_Created, sizeof(ANALOG_VALUE_OBJECT),
+        AV_Created_Order, MAX_CREATED_OBJECTS);
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&AV_Index, NUM_ANALOG_VALUES + MAX_CREATED_OBJECTS,
+            NUM_ANALOG_VALUES, Analog_Value_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_ANALOG_VALUE,
+            NUM_ANALOG_VALUES); }
+    /* in service and unchanged; without the memory for
+       MAX_CREATED_OBJECTS more, CreateObject is refused */
+    if (!object_state_init(&AV_State,
+            NUM_ANALOG_VALUES + MAX_CREATED_OBJECTS) &&
+        !object_state_init(&AV_State, NUM_ANALOG_VALUES))
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_APPLICATION,
+                MBED_ERROR_CODE_OUT_OF_MEMORY), "Analog Value state");
+
+    for (i = 0; i < NUM_ANALOG_VALUES; i++)
     {
-			for(j=0; j < BACNET_MAX_PRIORITY; j++)
-      { AV_Descr[i].Present_Value[j] = AV_LEVEL_NULL; }
+      object_command_init(&AV_Descr[i]);
 
-			AV_Descr[i].Prior_Value = 0.0f;
-      AV_Descr[i].Out_Of_Service = false;
+      AV_State.Prior_Value[i] = AV_Descr[i].Effective_Value;
 
+      /* 1.0 unless configured */
       AV_Descr[i].COV_Increment = 
-        (AV_Descr[i].COV_Increment == dummy) ? 1.0f : AV_Descr[i].COV_Increment;
-
-      AV_Descr[i].Changed = false;
+        (AV_Descr[i].COV_Increment == 0.0f) ? 1.0f : AV_Descr[i].COV_Increment;
 
 #if defined(INTRINSIC_REPORTING)
       AV_Descr[i].Event_State = EVENT_STATE_NORMAL;
@@ -150,6 +409,138 @@ void Analog_Value_Init(
     }
 }
 
+/** Creates an object with default values, e.g. for CreateObject.
+ * @param object_instance [in] The instance of the new object.
+ * @return true if the object was created, false if the instance exists
+ *         or MAX_CREATED_OBJECTS are in use.
+ */
+bool Analog_Value_Create(
+    uint32_t object_instance)
+{
+    ANALOG_VALUE_OBJECT *object = NULL;
+    ANALOG_VALUE_DESCR *descr = NULL;
+#if defined(INTRINSIC_REPORTING)
+    unsigned i = 0;
+#endif
+
+    if ((object_instance > BACNET_MAX_INSTANCE) ||
+        (NUM_ANALOG_VALUES >= AV_State.capacity) ||
+        Analog_Value_Valid_Instance(object_instance))
+        return false;
+    object = (ANALOG_VALUE_OBJECT *) object_pool_alloc(&AV_Pool);
+    if (!object)
+        return false;
+    snprintf(object->Name, sizeof(object->Name), "AV_%lu",
+        (unsigned long) object_instance);
+    descr = &object->Descr;
+    descr->Object_Instance = object_instance;
+    descr->Object_Name = object->Name;
+    descr->Object_Description = AV_No_Description;
+    descr->Relinquish_Default = 0.0f;
+    object_command_init(descr);
+    descr->Units = UNITS_NO_UNITS;
+    descr->COV_Increment = 1.0f;
+    descr->Event_State = EVENT_STATE_NORMAL;
+#if defined(INTRINSIC_REPORTING)
+    /* notification class not connected */
+    descr->Notification_Class = BACNET_MAX_INSTANCE;
+    for (i = 0; i < MAX_BACNET_EVENT_TRANSITION; i++) {
+        datetime_wildcard_set(&descr->Event_Time_Stamps[i]);
+        descr->Acked_Transitions[i].bIsAcked = true;
+    }
+#endif
+    /* lookups by instance find the object only once it is filled in */
+    core_util_critical_section_enter();
+    if (!object_index_add(&AV_Index, object_instance, NUM_ANALOG_VALUES)) {
+        core_util_critical_section_exit();
+        object_pool_free(&AV_Pool, object);
+        return false;
+    }
+    object_state_reset(&AV_State, NUM_ANALOG_VALUES);
+    NUM_ANALOG_VALUES++;
+    core_util_critical_section_exit();
+    Device_Object_Name_Index_Add(OBJECT_ANALOG_VALUE, object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_ADDED, OBJECT_ANALOG_VALUE,
+        object_instance);
+
+    return true;
+}
+
+/** Deletes an object created at runtime, those of AV_Descr[] stay.
+ * The last created object takes over the position of the deleted one.
+ * @param object_instance [in] The instance of the object.
+ * @return true if the object was deleted.
+ */
+bool Analog_Value_Delete(
+    uint32_t object_instance)
+{
+    ANALOG_VALUE_DESCR *object = Analog_Value_Object(object_instance);
+    ANALOG_VALUE_DESCR *last = NULL;
+    unsigned position = 0;
+
+    if (!object || !object_pool_owns(&AV_Pool, object))
+        return false;
+    position = object_pool_position(&AV_Pool, object);
+    last = (ANALOG_VALUE_DESCR *) object_pool_at(&AV_Pool,
+        object_pool_count(&AV_Pool) - 1);
+    Device_Object_Name_Index_Remove(OBJECT_ANALOG_VALUE, object_instance);
+    /* the application thread and the COV ticker look objects up by
+       instance, they must not see the index or the state half moved */
+    core_util_critical_section_enter();
+    object_index_remove(&AV_Index, object_instance);
+    object_pool_free(&AV_Pool, object);
+    if (last != object) {
+        object_index_remove(&AV_Index, last->Object_Instance);
+        object_index_add(&AV_Index, last->Object_Instance,
+            AV_Static_Count + position);
+        object_state_move(&AV_State, NUM_ANALOG_VALUES - 1,
+            AV_Static_Count + position);
+    }
+    NUM_ANALOG_VALUES--;
+    core_util_critical_section_exit();
+    Device_Object_Changed(OBJECT_CHANGE_REMOVED, OBJECT_ANALOG_VALUE,
+        object_instance);
+
+    return true;
+}
+
+/* deletes all objects created at runtime */
+void Analog_Value_Cleanup(
+    void)
+{
+    while (object_pool_count(&AV_Pool)) {
+        ANALOG_VALUE_DESCR *object =
+            (ANALOG_VALUE_DESCR *) object_pool_at(&AV_Pool, 0);
+
+        Analog_Value_Delete(object->Object_Instance);
+    }
+}
+
+/** Renames an object created at runtime, the names of AV_Descr[]
+ *  are fixed.
+ * @param object_instance [in] The instance of the object.
+ * @param new_name [in] The new name, truncated to
+ *        MAX_CREATED_OBJECT_NAME_LEN characters.
+ * @return true if the object was renamed.
+ */
+bool Analog_Value_Name_Set(
+    uint32_t object_instance,
+    char *new_name)
+{
+    ANALOG_VALUE_DESCR *object = Analog_Value_Object(object_instance);
+
+    if (!object || !new_name || !object_pool_owns(&AV_Pool, object))
+        return false;
+    Device_Object_Name_Index_Remove(OBJECT_ANALOG_VALUE, object_instance);
+    snprintf(((ANALOG_VALUE_OBJECT *) object)->Name,
+        sizeof(((ANALOG_VALUE_OBJECT *) object)->Name), "%s", new_name);
+    Device_Object_Name_Index_Add(OBJECT_ANALOG_VALUE, object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_RENAMED, OBJECT_ANALOG_VALUE,
+        object_instance);
+
+    return true;
+}
+
 /* we simply have 0-n object instances.  Yours might be */
 /* more complex, and then you need validate that the */
 /* given instance exists */
@@ -170,13 +561,7 @@ bool Analog_Value_Valid_Instance(
 unsigned Analog_Value_Count(
     void)
 {
-	uint32_t i=0;
-	
-	while(AV_Descr[i].Object_Instance <= BACNET_MAX_INSTANCE)
-		i++;
-	
-	NUM_ANALOG_VALUES = i;
-  return i;
+    return NUM_ANALOG_VALUES;
 }
 
 /* we simply have 0-n object instances.  Yours might be */
@@ -185,7 +570,7 @@ unsigned Analog_Value_Count(
 uint32_t Analog_Value_Index_To_Instance(
     unsigned index)
 {
-    return AV_Descr[index].Object_Instance;
+    return Analog_Value_Descr(index)->Object_Instance;
 }
 
 /* we simply have 0-n object instances.  Yours might be */
@@ -196,13 +581,10 @@ unsigned Analog_Value_Instance_To_Index(
 {
     unsigned index = 0;
 
-    for(index=0; index<NUM_ANALOG_VALUES; index++)
-		{
-			if(AV_Descr[index].Object_Instance == object_instance)
-				return index;
-		}
+    if (object_index_find(&AV_Index, object_instance, &index))
+        return index;
 
-    return index;
+    return NUM_ANALOG_VALUES;
 }
 
 /**
@@ -215,62 +597,51 @@ unsigned Analog_Value_Instance_To_Index(
  *
  * @return  true if values are within range and present-value is set.
  */
+/* a change of the present value by COV_Increment or more is reported
+   by COV */
+static void Analog_Value_Changed(
+    ANALOG_VALUE_DESCR * object)
+{
+    unsigned position = Analog_Value_Position(object);
+    float prior_value = AV_State.Prior_Value[position];
+    float cov_delta = 0.0f;
+
+    if (prior_value > object->Effective_Value) {
+        cov_delta = prior_value - object->Effective_Value;
+    } else {
+        cov_delta = object->Effective_Value - prior_value;
+    }
+    if (cov_delta >= object->COV_Increment) {
+        object_state_changed_set(&AV_State, position, true);
+        AV_State.Prior_Value[position] = object->Effective_Value;
+        handler_cov_object_changed(OBJECT_ANALOG_VALUE,
+            object->Object_Instance);
+    }
+}
+
 bool Analog_Value_Present_Value_Set(
 	uint32_t object_instance,
 	float value,
 	uint8_t priority)
 {
-	unsigned index = 0;
-	bool status = false;
-	float prior_value = 0.0;
-	float cov_increment = 0.0;
-	float cov_delta = 0.0;
+	ANALOG_VALUE_DESCR *object = Analog_Value_Object(object_instance);
 
-	index = Analog_Value_Instance_To_Index(object_instance);
-	if (index < NUM_ANALOG_VALUES) {		
-		prior_value = AV_Descr[index].Prior_Value;
-		cov_increment = AV_Descr[index].COV_Increment;
-		
-		if (prior_value > value) {
-				cov_delta = prior_value - value;
-		} else {
-				cov_delta = value - prior_value;
-		}
-		if (cov_delta >= cov_increment) {
-				AV_Descr[index].Changed = true;
-				AV_Descr[index].Prior_Value = value;
-		}
-		
-		if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-				(priority != 6 /* reserved */ )) {
-				AV_Descr[index].Present_Value[priority - 1] = value;
-				status = true;
-		}
-		status = true;
-	}
-	return status;
+	if (object && (priority != 6 /* reserved */ ))
+		return object_command_set(object, priority, value,
+			Analog_Value_Changed);
+
+	return false;
 }
 
 float Analog_Value_Present_Value(
 	uint32_t object_instance)
 {
-	float value = AV_RELINQUISH_DEFAULT;
-	float current_value = AV_RELINQUISH_DEFAULT;
-	unsigned index = 0;
-	unsigned i;
-	
-	index = Analog_Value_Instance_To_Index(object_instance);
-	if (index < NUM_ANALOG_VALUES) {
-			for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-					current_value = AV_Descr[index].Present_Value[i];
-					if (current_value != AV_LEVEL_NULL) {
-							value = AV_Descr[index].Present_Value[i];
-							break;
-					}
-			}
-	}
+	ANALOG_VALUE_DESCR *object = Analog_Value_Object(object_instance);
 
-	return value;
+	if (object)
+		return object->Effective_Value;
+
+	return 0.0f;
 }
 
 bool Analog_Value_Change_Of_Value(
@@ -282,7 +653,7 @@ bool Analog_Value_Change_Of_Value(
     index = Analog_Value_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_VALUES) 
 		{
-        changed = AV_Descr[index].Changed;
+        changed = object_state_changed(&AV_State, index);
     }
 
     return changed;
@@ -296,7 +667,7 @@ void Analog_Value_Change_Of_Value_Clear(
     index = Analog_Value_Instance_To_Index(object_instance);
     if (index < NUM_ANALOG_VALUES) 
 		{
-        AV_Descr[index].Changed = false;
+        object_state_changed_set(&AV_State, index, false);
     }	
 }
 
@@ -305,44 +676,10 @@ bool Analog_Value_Encode_Value_List(
 	uint32_t object_instance,
 	BACNET_PROPERTY_VALUE * value_list)
 {
-	bool status = false;
-
-	if (value_list) {
-			value_list->propertyIdentifier = PROP_PRESENT_VALUE;
-			value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-			value_list->value.context_specific = false;
-			value_list->value.tag = BACNET_APPLICATION_TAG_REAL;
-			value_list->value.type.Real = Analog_Value_Present_Value(object_instance);
-			value_list->value.next = NULL;
-			value_list->priority = BACNET_NO_PRIORITY;
-			value_list = value_list->next;
-	}
-	if (value_list) {
-			value_list->propertyIdentifier = PROP_STATUS_FLAGS;
-			value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-			value_list->value.context_specific = false;
-			value_list->value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
-			bitstring_init(&value_list->value.type.Bit_String);
-			bitstring_set_bit(&value_list->value.type.Bit_String,
-					STATUS_FLAG_IN_ALARM, false);
-			bitstring_set_bit(&value_list->value.type.Bit_String,
-					STATUS_FLAG_FAULT, false);
-			bitstring_set_bit(&value_list->value.type.Bit_String,
-					STATUS_FLAG_OVERRIDDEN, false);
-			if (Analog_Value_Out_Of_Service(object_instance)) {
-					bitstring_set_bit(&value_list->value.type.Bit_String,
-							STATUS_FLAG_OUT_OF_SERVICE, true);
-			} else {
-					bitstring_set_bit(&value_list->value.type.Bit_String,
-							STATUS_FLAG_OUT_OF_SERVICE, false);
-			}
-			value_list->value.next = NULL;
-			value_list->priority = BACNET_NO_PRIORITY;
-			value_list->next = NULL;
-	}
-	status = Analog_Value_Change_Of_Value(object_instance);
+	object_encode_value_list(&Analog_Value_Class, object_instance,
+		value_list);
 
-	return status;
+	return Analog_Value_Change_Of_Value(object_instance);
 }
 
 float Analog_Value_COV_Increment(
@@ -354,7 +691,7 @@ float Analog_Value_COV_Increment(
 	index = Analog_Value_Instance_To_Index(object_instance);
 	if (index < NUM_ANALOG_VALUES) 
 	{
-			value = AV_Descr[index].COV_Increment;
+			value = Analog_Value_Descr(index)->COV_Increment;
 	}
 
 	return value;
@@ -369,7 +706,7 @@ void Analog_Value_COV_Increment_Set(
 	index = Analog_Value_Instance_To_Index(object_instance);
 	if (index < NUM_ANALOG_VALUES) 
 	{
-			AV_Descr[index].COV_Increment = value;
+			Analog_Value_Descr(index)->COV_Increment = value;
 	}
 }
 /* note: the object name must be unique within this device */
@@ -383,7 +720,7 @@ bool Analog_Value_Object_Name(
     index = Analog_Value_Instance_To_Index(object_instance);
 
     if (index < NUM_ANALOG_VALUES) {
-        status = characterstring_init_ansi(object_name, AV_Descr[index].Object_Name);
+        status = characterstring_init_ansi(object_name, Analog_Value_Descr(index)->Object_Name);
     }
 
     return status;
@@ -401,7 +738,7 @@ bool Analog_Value_Object_Description(
     if (index < NUM_ANALOG_VALUES)
     {
       status = 
-        characterstring_init_ansi(object_description, AV_Descr[index].Object_Description);
+        characterstring_init_ansi(object_description, Analog_Value_Descr(index)->Object_Description);
     }
 
     return status;
@@ -416,7 +753,7 @@ bool Analog_Value_Out_Of_Service(
 	index = Analog_Value_Instance_To_Index(object_instance);
 	if (index < NUM_ANALOG_VALUES) 
 	{
-			value = AV_Descr[index].Out_Of_Service;
+			value = object_state_out_of_service(&AV_State, index);
 	}
 
 	return value;
@@ -431,7 +768,7 @@ void Analog_Value_Out_Of_Service_Set(
 	index = Analog_Value_Instance_To_Index(object_instance);
 	if (index < NUM_ANALOG_VALUES) 
 	{
-			AV_Descr[index].Out_Of_Service = oos_flag;
+			object_state_out_of_service_set(&AV_State, index, oos_flag);
 	}
 }
 
@@ -439,14 +776,13 @@ bool Analog_Value_Present_Value_Relinquish(
     uint32_t object_instance,
     unsigned priority)
 {
-    bool status = false;
+    ANALOG_VALUE_DESCR *object = Analog_Value_Object(object_instance);
 
-        if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-            (priority != 6 /* reserved */ )) {
-            status = Analog_Value_Present_Value_Set(object_instance, AV_LEVEL_NULL, priority);
-        }
+    if (object && (priority != 6 /* reserved */ ))
+        return object_command_relinquish(object, priority,
+            Analog_Value_Changed);
 
-    return status;
+    return false;
 }
 
 uint16_t Analog_Value_Units(uint32_t instance)
@@ -457,7 +793,7 @@ uint16_t Analog_Value_Units(uint32_t instance)
 	index = Analog_Value_Instance_To_Index(instance);
 	if (index < NUM_ANALOG_VALUES) 
 	{
-			value = (BACNET_ENGINEERING_UNITS)AV_Descr[index].Units;
+			value = (BACNET_ENGINEERING_UNITS)Analog_Value_Descr(index)->Units;
 	}
 
 	return (uint16_t)value;
@@ -470,7 +806,7 @@ bool Analog_Value_Units_Set(uint32_t instance, BACNET_ENGINEERING_UNITS unit)
 	index = Analog_Value_Instance_To_Index(instance);
 	if (index < NUM_ANALOG_VALUES) 
 	{
-			AV_Descr[index].Units = unit;
+			Analog_Value_Descr(index)->Units = unit;
       return true;
 	}
   
@@ -481,565 +817,14 @@ bool Analog_Value_Units_Set(uint32_t instance, BACNET_ENGINEERING_UNITS unit)
 int Analog_Value_Read_Property(
     BACNET_READ_PROPERTY_DATA * rpdata)
 {
-    int apdu_len = 0;   /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    float real_value = (float) 1.414;
-    unsigned object_index = 0;
-    bool state = false;
-    uint8_t *apdu = NULL;
-    ANALOG_VALUE_DESCR *CurrentAV;
-		unsigned i = 0;
-    int len = 0;
-
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
-        return 0;
-    }
-
-    apdu = rpdata->application_data;
-
-    object_index = Analog_Value_Instance_To_Index(rpdata->object_instance);
-    if (object_index < NUM_ANALOG_VALUES)
-        CurrentAV = &AV_Descr[object_index];
-    else
-        return BACNET_STATUS_ERROR;
-		
-		if(AV_Descr[object_index].read_callback)
-		{
-		  uint8_t id = bacQueue.call(AV_Descr[object_index].read_callback, (uint32_t)rpdata->object_property);
-				
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_AV_RDCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_AV_RDCB_FAILED, id, 0); }
-		}
-		
-    switch (rpdata->object_property) {
-        case PROP_OBJECT_IDENTIFIER:
-            apdu_len =
-                encode_application_object_id(&apdu[0], OBJECT_ANALOG_VALUE,
-                rpdata->object_instance);
-            break;
-
-        case PROP_OBJECT_NAME:
-            Analog_Value_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_DESCRIPTION:
-            Analog_Value_Object_Description(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-
-        case PROP_OBJECT_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], OBJECT_ANALOG_VALUE);
-            break;
-
-        case PROP_PRESENT_VALUE:
-            real_value = Analog_Value_Present_Value(rpdata->object_instance);
-            apdu_len = encode_application_real(&apdu[0], real_value);
-            break;
-case PROP_PRIORITY_ARRAY:
-            /* Array element zero is the number of elements in the array */
-            if (rpdata->array_index == 0)
-                apdu_len =
-                    encode_application_unsigned(&apdu[0], BACNET_MAX_PRIORITY);
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            else if (rpdata->array_index == BACNET_ARRAY_ALL) {
-                object_index =
-                    Analog_Value_Instance_To_Index(rpdata->object_instance);
-                for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-                    /* FIXME: check if we have room before adding it to APDU */
-                    if (AV_Descr[object_index].Present_Value[i] == AV_LEVEL_NULL)
-                        len = encode_application_null(&apdu[apdu_len]);
-                    else {
-                        real_value = AV_Descr[object_index].Present_Value[i];
-                        len =
-                            encode_application_real(&apdu[apdu_len],
-                            real_value);
-                    }
-                    /* add it if we have room */
-                    if ((apdu_len + len) < MAX_APDU)
-                        apdu_len += len;
-                    else {
-                        rpdata->error_class = ERROR_CLASS_SERVICES;
-                        rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                        apdu_len = BACNET_STATUS_ERROR;
-                        break;
-                    }
-                }
-            } else {
-                object_index =
-                    Analog_Value_Instance_To_Index(rpdata->object_instance);
-                if (rpdata->array_index <= BACNET_MAX_PRIORITY) {
-                    if (AV_Descr[object_index].Present_Value[rpdata->array_index - 1] == AV_LEVEL_NULL)
-                        apdu_len = encode_application_null(&apdu[0]);
-                    else {
-                        real_value = AV_Descr[object_index].Present_Value[rpdata->array_index - 1];
-                        apdu_len =
-                            encode_application_real(&apdu[0], real_value);
-                    }
-                } else {
-                    rpdata->error_class = ERROR_CLASS_PROPERTY;
-                    rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                    apdu_len = BACNET_STATUS_ERROR;
-                }
-            }
-            break;
-        case PROP_RELINQUISH_DEFAULT:
-            real_value = AV_RELINQUISH_DEFAULT;
-            apdu_len = encode_application_real(&apdu[0], real_value);
-            break;
-        case PROP_STATUS_FLAGS:
-            bitstring_init(&bit_string);
-#if defined(INTRINSIC_REPORTING)
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM,
-                CurrentAV->Event_State ? true : false);
-#else
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-#endif
-            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE,
-                CurrentAV->Out_Of_Service);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_EVENT_STATE:
-#if defined(INTRINSIC_REPORTING)
-            apdu_len =
-                encode_application_enumerated(&apdu[0],
-                CurrentAV->Event_State);
-#else
-            apdu_len =
-                encode_application_enumerated(&apdu[0], EVENT_STATE_NORMAL);
-#endif
-            break;
-
-        case PROP_OUT_OF_SERVICE:
-            state = CurrentAV->Out_Of_Service;
-            apdu_len = encode_application_boolean(&apdu[0], state);
-            break;
-
-        case PROP_UNITS:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], CurrentAV->Units);
-            break;
-
-#if defined(INTRINSIC_REPORTING)
-        case PROP_TIME_DELAY:
-            apdu_len =
-                encode_application_unsigned(&apdu[0], CurrentAV->Time_Delay);
-            break;
-
-        case PROP_NOTIFICATION_CLASS:
-            apdu_len =
-                encode_application_unsigned(&apdu[0],
-                CurrentAV->Notification_Class);
-            break;
-
-        case PROP_HIGH_LIMIT:
-            apdu_len =
-                encode_application_real(&apdu[0], CurrentAV->High_Limit);
-            break;
-
-        case PROP_LOW_LIMIT:
-            apdu_len = encode_application_real(&apdu[0], CurrentAV->Low_Limit);
-            break;
-
-        case PROP_DEADBAND:
-            apdu_len = encode_application_real(&apdu[0], CurrentAV->Deadband);
-            break;
-
-        case PROP_LIMIT_ENABLE:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, 0,
-                (CurrentAV->
-                    Limit_Enable & EVENT_LOW_LIMIT_ENABLE) ? true : false);
-            bitstring_set_bit(&bit_string, 1,
-                (CurrentAV->
-                    Limit_Enable & EVENT_HIGH_LIMIT_ENABLE) ? true : false);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_EVENT_ENABLE:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_OFFNORMAL,
-                (CurrentAV->
-                    Event_Enable & EVENT_ENABLE_TO_OFFNORMAL) ? true : false);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_FAULT,
-                (CurrentAV->
-                    Event_Enable & EVENT_ENABLE_TO_FAULT) ? true : false);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_NORMAL,
-                (CurrentAV->
-                    Event_Enable & EVENT_ENABLE_TO_NORMAL) ? true : false);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_ACKED_TRANSITIONS:
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_OFFNORMAL,
-                CurrentAV->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
-                bIsAcked);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_FAULT,
-                CurrentAV->Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
-            bitstring_set_bit(&bit_string, TRANSITION_TO_NORMAL,
-                CurrentAV->Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
-
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-
-        case PROP_NOTIFY_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0],
-                CurrentAV->Notify_Type ? NOTIFY_EVENT : NOTIFY_ALARM);
-            break;
-
-        case PROP_EVENT_TIME_STAMPS:
-            /* Array element zero is the number of elements in the array */
-            if (rpdata->array_index == 0)
-                apdu_len =
-                    encode_application_unsigned(&apdu[0],
-                    MAX_BACNET_EVENT_TRANSITION);
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            else if (rpdata->array_index == BACNET_ARRAY_ALL) {
-                for (i = 0; i < MAX_BACNET_EVENT_TRANSITION; i++) {;
-                    len =
-                        encode_opening_tag(&apdu[apdu_len],
-                        TIME_STAMP_DATETIME);
-                    len +=
-                        encode_application_date(&apdu[apdu_len + len],
-                        &CurrentAV->Event_Time_Stamps[i].date);
-                    len +=
-                        encode_application_time(&apdu[apdu_len + len],
-                        &CurrentAV->Event_Time_Stamps[i].time);
-                    len +=
-                        encode_closing_tag(&apdu[apdu_len + len],
-                        TIME_STAMP_DATETIME);
-
-                    /* add it if we have room */
-                    if ((apdu_len + len) < MAX_APDU)
-                        apdu_len += len;
-                    else {
-                        rpdata->error_class = ERROR_CLASS_SERVICES;
-                        rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                        apdu_len = BACNET_STATUS_ERROR;
-                        break;
-                    }
-                }
-            } else if (rpdata->array_index <= MAX_BACNET_EVENT_TRANSITION) {
-                apdu_len =
-                    encode_opening_tag(&apdu[apdu_len], TIME_STAMP_DATETIME);
-                apdu_len +=
-                    encode_application_date(&apdu[apdu_len],
-                    &CurrentAV->Event_Time_Stamps[rpdata->array_index].date);
-                apdu_len +=
-                    encode_application_time(&apdu[apdu_len],
-                    &CurrentAV->Event_Time_Stamps[rpdata->array_index].time);
-                apdu_len +=
-                    encode_closing_tag(&apdu[apdu_len], TIME_STAMP_DATETIME);
-            } else {
-                rpdata->error_class = ERROR_CLASS_PROPERTY;
-                rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                apdu_len = BACNET_STATUS_ERROR;
-            }
-            break;
-#endif
-        case PROP_COV_INCREMENT:
-            apdu_len = encode_application_real(&apdu[0],
-                CurrentAV->COV_Increment);
-            break;
-        default:
-            rpdata->error_class = ERROR_CLASS_PROPERTY;
-            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            apdu_len = BACNET_STATUS_ERROR;
-            break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->object_property != PROP_PRIORITY_ARRAY) &&
-        (rpdata->object_property != PROP_EVENT_TIME_STAMPS) &&
-        (rpdata->array_index != BACNET_ARRAY_ALL)) {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+    return object_read_property(&Analog_Value_Class, rpdata);
 }
 
 /* returns true if successful */
 bool Analog_Value_Write_Property(
     BACNET_WRITE_PROPERTY_DATA * wp_data)
 {
-    bool status = false;        /* return value */
-    unsigned int object_index = 0;
-    int len = 0;
-    unsigned int priority = 0;
-    BACNET_APPLICATION_DATA_VALUE value;
-    ANALOG_VALUE_DESCR *CurrentAV;
-
-    /* decode the some of the request */
-    len =
-        bacapp_decode_application_data(wp_data->application_data,
-        wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0) {
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-        return false;
-    }
-    if ((wp_data->object_property != PROP_PRIORITY_ARRAY) &&
-        (wp_data->object_property != PROP_EVENT_TIME_STAMPS) &&
-        (wp_data->array_index != BACNET_ARRAY_ALL)) {
-        /*  only array properties can have array options */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        return false;
-    }
-
-    object_index = Analog_Value_Instance_To_Index(wp_data->object_instance);
-
-    if (object_index < NUM_ANALOG_VALUES)
-        CurrentAV = &AV_Descr[object_index];
-    else
-        return false;
-
-    switch (wp_data->object_property) {
-        case PROP_PRESENT_VALUE:
-						priority = wp_data->priority;
-						status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL, &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                /* If explicitly defined as such, any write attempt to 
-                   PRESENT_VALUE will be blocked / answered with an
-                   error message. */
-                if (AV_Descr[object_index].PV_WriteProtected) {
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                }
-                else {
-                  /* Command priority 6 is reserved for use by Minimum On/Off
-                     algorithm and may not be used for other purposes in any
-                     object. */
-                  if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-                      (priority != 6 /* reserved */ )) {
-                      status = Analog_Value_Present_Value_Set(wp_data->object_instance, value.type.Real, priority);
-                  } else if (priority == 6) {
-                      /* Command priority 6 is reserved for use by Minimum On/Off
-                         algorithm and may not be used for other purposes in any
-                         object. */
-                      wp_data->error_class = ERROR_CLASS_PROPERTY;
-                      wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                  } else {
-                      wp_data->error_class = ERROR_CLASS_PROPERTY;
-                      wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                  }
-                }
-            } else {
-								status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_NULL, &wp_data->error_class, &wp_data->error_code);
-								if (status) {
-										if (priority && (priority <= BACNET_MAX_PRIORITY) && (priority != 6 /* reserved */ )) {
-												Analog_Value_Present_Value_Set(wp_data->object_instance, AV_LEVEL_NULL, priority);
-										}	else if (priority == 6) {
-												wp_data->error_class = ERROR_CLASS_PROPERTY;
-												wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-										} else {
-												wp_data->error_class = ERROR_CLASS_PROPERTY;
-												wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-										}
-								} else {
-										status = false;
-										wp_data->error_class = ERROR_CLASS_PROPERTY;
-										wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
-								}
-            }
-            break;
-
-        case PROP_OUT_OF_SERVICE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BOOLEAN,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                CurrentAV->Out_Of_Service = value.type.Boolean;
-            }
-            break;
-
-        case PROP_UNITS:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                CurrentAV->Units = value.type.Enumerated;
-            }
-            break;
-						
-        case PROP_COV_INCREMENT:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                if (value.type.Real >= 0.0f) {
-                    Analog_Value_COV_Increment_Set(
-                        wp_data->object_instance,
-                        value.type.Real);
-                } else {
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                }
-            }
-            break;
-#if defined(INTRINSIC_REPORTING)
-        case PROP_TIME_DELAY:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAV->Time_Delay = value.type.Unsigned_Int;
-                CurrentAV->Remaining_Time_Delay = CurrentAV->Time_Delay;
-            }
-            break;
-
-        case PROP_NOTIFICATION_CLASS:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAV->Notification_Class = value.type.Unsigned_Int;
-            }
-            break;
-
-        case PROP_HIGH_LIMIT:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAV->High_Limit = value.type.Real;
-            }
-            break;
-
-        case PROP_LOW_LIMIT:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAV->Low_Limit = value.type.Real;
-            }
-            break;
-
-        case PROP_DEADBAND:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_REAL,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                CurrentAV->Deadband = value.type.Real;
-            }
-            break;
-
-        case PROP_LIMIT_ENABLE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BIT_STRING,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                if (value.type.Bit_String.bits_used == 2) {
-                    CurrentAV->Limit_Enable = value.type.Bit_String.value[0];
-                } else {
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                    status = false;
-                }
-            }
-            break;
-
-        case PROP_EVENT_ENABLE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BIT_STRING,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                if (value.type.Bit_String.bits_used == 3) {
-                    CurrentAV->Event_Enable = value.type.Bit_String.value[0];
-                } else {
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                    status = false;
-                }
-            }
-            break;
-
-        case PROP_NOTIFY_TYPE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED,
-                &wp_data->error_class, &wp_data->error_code);
-
-            if (status) {
-                switch ((BACNET_NOTIFY_TYPE) value.type.Enumerated) {
-                    case NOTIFY_EVENT:
-                        CurrentAV->Notify_Type = 1;
-                        break;
-                    case NOTIFY_ALARM:
-                        CurrentAV->Notify_Type = 0;
-                        break;
-                    default:
-                        wp_data->error_class = ERROR_CLASS_PROPERTY;
-                        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                        status = false;
-                        break;
-                }
-            }
-            break;
-#endif
-        case PROP_OBJECT_IDENTIFIER:
-        case PROP_OBJECT_NAME:
-        case PROP_OBJECT_TYPE:
-        case PROP_STATUS_FLAGS:
-        case PROP_EVENT_STATE:
-        case PROP_DESCRIPTION:
-        case PROP_RELINQUISH_DEFAULT:
-        case PROP_PRIORITY_ARRAY:
-#if defined(INTRINSIC_REPORTING)
-        case PROP_ACKED_TRANSITIONS:
-        case PROP_EVENT_TIME_STAMPS:
-#endif
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-            break;
-        default:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            break;
-    }
-
-		if(AV_Descr[object_index].write_callback && !AV_Descr[object_index].PV_WriteProtected)
-		{
-      BACNET_APPLICATION_DATA_VALUE value;
-			len = bacapp_decode_application_data(wp_data->application_data,
-																					 wp_data->application_data_len,
-																					 &value);
-      
-		  uint8_t id = bacQueue.call(AV_Descr[object_index].write_callback, 
-                                 (uint32_t)wp_data->object_property,
-                                 (float) value.type.Real);
-		  
-		  if(id > 0) { EVRECORD2(BACNET_EVQ_AV_WRCB_CALLED, id, 0); }
-		  else       { EVRECORD2(BACNET_EVQ_AV_WRCB_FAILED, id, 0); }
-		}
-		
-    return status;
+    return object_write_property(&Analog_Value_Class, wp_data);
 }
 
 
@@ -1060,7 +845,7 @@ void Analog_Value_Intrinsic_Reporting(
 
     object_index = Analog_Value_Instance_To_Index(object_instance);
     if (object_index < MAX_ANALOG_VALUES)
-        CurrentAV = &AV_Descr[object_index];
+        CurrentAV = Analog_Value_Descr(object_index);
     else
         return;
 
@@ -1089,7 +874,7 @@ void Analog_Value_Intrinsic_Reporting(
         SendNotify = true;
     } else {
         /* actual Present_Value */
-        PresentVal = Analog_Value_Present_Value(object_instance);
+        PresentVal = CurrentAV->Effective_Value;
         FromState = CurrentAV->Event_State;
         switch (CurrentAV->Event_State) {
             case EVENT_STATE_NORMAL:
@@ -1296,7 +1081,7 @@ void Analog_Value_Intrinsic_Reporting(
                 statusFlags, STATUS_FLAG_OVERRIDDEN, false);
             bitstring_set_bit(&event_data.notificationParams.outOfRange.
                 statusFlags, STATUS_FLAG_OUT_OF_SERVICE,
-                CurrentAV->Out_Of_Service);
+                object_state_out_of_service(&AV_State, object_index));
             /* Deadband used for limit checking. */
             event_data.notificationParams.outOfRange.deadband =
                 CurrentAV->Deadband;
@@ -1354,16 +1139,16 @@ int Analog_Value_Event_Information(
     /* check index */
     if (index < MAX_ANALOG_VALUES) {
         /* Event_State not equal to NORMAL */
-        IsActiveEvent = (AV_Descr[index].Event_State != EVENT_STATE_NORMAL);
+        IsActiveEvent = (Analog_Value_Descr(index)->Event_State != EVENT_STATE_NORMAL);
 
         /* Acked_Transitions property, which has at least one of the bits
            (TO-OFFNORMAL, TO-FAULT, TONORMAL) set to FALSE. */
         IsNotAckedTransitions =
-            (AV_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].
+            (Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
             bIsAcked ==
-            false) | (AV_Descr[index].Acked_Transitions[TRANSITION_TO_FAULT].
+            false) | (Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_FAULT].
             bIsAcked ==
-            false) | (AV_Descr[index].Acked_Transitions[TRANSITION_TO_NORMAL].
+            false) | (Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_NORMAL].
             bIsAcked == false);
     } else
         return -1;      /* end of list  */
@@ -1374,40 +1159,40 @@ int Analog_Value_Event_Information(
         getevent_data->objectIdentifier.instance =
             Analog_Value_Index_To_Instance(index);
         /* Event State */
-        getevent_data->eventState = AV_Descr[index].Event_State;
+        getevent_data->eventState = Analog_Value_Descr(index)->Event_State;
         /* Acknowledged Transitions */
         bitstring_init(&getevent_data->acknowledgedTransitions);
         bitstring_set_bit(&getevent_data->acknowledgedTransitions,
             TRANSITION_TO_OFFNORMAL,
-            AV_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].
+            Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
             bIsAcked);
         bitstring_set_bit(&getevent_data->acknowledgedTransitions,
             TRANSITION_TO_FAULT,
-            AV_Descr[index].Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
+            Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
         bitstring_set_bit(&getevent_data->acknowledgedTransitions,
             TRANSITION_TO_NORMAL,
-            AV_Descr[index].Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
+            Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
         /* Event Time Stamps */
         for (i = 0; i < 3; i++) {
             getevent_data->eventTimeStamps[i].tag = TIME_STAMP_DATETIME;
             getevent_data->eventTimeStamps[i].value.dateTime =
-                AV_Descr[index].Event_Time_Stamps[i];
+                Analog_Value_Descr(index)->Event_Time_Stamps[i];
         }
         /* Notify Type */
-        getevent_data->notifyType = AV_Descr[index].Notify_Type;
+        getevent_data->notifyType = Analog_Value_Descr(index)->Notify_Type;
         /* Event Enable */
         bitstring_init(&getevent_data->eventEnable);
         bitstring_set_bit(&getevent_data->eventEnable, TRANSITION_TO_OFFNORMAL,
-            (AV_Descr[index].
+            (Analog_Value_Descr(index)->
                 Event_Enable & EVENT_ENABLE_TO_OFFNORMAL) ? true : false);
         bitstring_set_bit(&getevent_data->eventEnable, TRANSITION_TO_FAULT,
-            (AV_Descr[index].
+            (Analog_Value_Descr(index)->
                 Event_Enable & EVENT_ENABLE_TO_FAULT) ? true : false);
         bitstring_set_bit(&getevent_data->eventEnable, TRANSITION_TO_NORMAL,
-            (AV_Descr[index].
+            (Analog_Value_Descr(index)->
                 Event_Enable & EVENT_ENABLE_TO_NORMAL) ? true : false);
         /* Event Priorities */
-        Notification_Class_Get_Priorities(AV_Descr[index].Notification_Class,
+        Notification_Class_Get_Priorities(Analog_Value_Descr(index)->Notification_Class,
             getevent_data->eventPriorities);
 
         return 1;       /* active event */
@@ -1428,7 +1213,7 @@ int Analog_Value_Alarm_Ack(
         instance);
 
     if (object_index < MAX_ANALOG_VALUES)
-        CurrentAV = &AV_Descr[object_index];
+        CurrentAV = Analog_Value_Descr(object_index);
     else {
         *error_code = ERROR_CODE_UNKNOWN_OBJECT;
         return -1;
@@ -1527,27 +1312,27 @@ int Analog_Value_Alarm_Summary(
     if (index < MAX_ANALOG_VALUES) {
         /* Event_State is not equal to NORMAL  and
            Notify_Type property value is ALARM */
-        if ((AV_Descr[index].Event_State != EVENT_STATE_NORMAL) &&
-            (AV_Descr[index].Notify_Type == NOTIFY_ALARM)) {
+        if ((Analog_Value_Descr(index)->Event_State != EVENT_STATE_NORMAL) &&
+            (Analog_Value_Descr(index)->Notify_Type == NOTIFY_ALARM)) {
             /* Object Identifier */
             getalarm_data->objectIdentifier.type = OBJECT_ANALOG_VALUE;
             getalarm_data->objectIdentifier.instance =
                 Analog_Value_Index_To_Instance(index);
             /* Alarm State */
-            getalarm_data->alarmState = AV_Descr[index].Event_State;
+            getalarm_data->alarmState = Analog_Value_Descr(index)->Event_State;
             /* Acknowledged Transitions */
             bitstring_init(&getalarm_data->acknowledgedTransitions);
             bitstring_set_bit(&getalarm_data->acknowledgedTransitions,
                 TRANSITION_TO_OFFNORMAL,
-                AV_Descr[index].Acked_Transitions[TRANSITION_TO_OFFNORMAL].
+                Analog_Value_Descr(index)->Acked_Transitions[TRANSITION_TO_OFFNORMAL].
                 bIsAcked);
             bitstring_set_bit(&getalarm_data->acknowledgedTransitions,
                 TRANSITION_TO_FAULT,
-                AV_Descr[index].
+                Analog_Value_Descr(index)->
                 Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
             bitstring_set_bit(&getalarm_data->acknowledgedTransitions,
                 TRANSITION_TO_NORMAL,
-                AV_Descr[index].
+                Analog_Value_Descr(index)->
                 Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
 
             return 1;   /* active alarm */
@@ -55,10 +55,13 @@ extern "C" {
 		av_callback_wr write_callback;
 		float COV_Increment;
         unsigned Event_State:3;
-        bool Out_Of_Service;
         float Present_Value[16];
-		float Prior_Value;
-		bool Changed;
+        /* see objcommand.h */
+        uint16_t Priority_Active;
+        float Relinquish_Default;
+        float Effective_Value;
+        /* Out_Of_Service and the COV state are kept apart, see
+           objstate.h */
         bool PV_WriteProtected;
 #if defined(INTRINSIC_REPORTING)
         uint32_t Time_Delay;
@@ -95,6 +98,9 @@ extern "C" {
     bool Analog_Value_Object_Name(
         uint32_t object_instance,
         BACNET_CHARACTER_STRING * object_name);
+    bool Analog_Value_Name_Set(
+        uint32_t object_instance,
+        char *new_name);
     
     bool Analog_Value_Object_Description(
         uint32_t object_instance,
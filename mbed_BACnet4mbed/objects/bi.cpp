@@ -32,6 +32,8 @@
 #include "bacdcode.h"
 #include "bacenum.h"
 #include "config_bacnet.h"
+#include "objindex.h"
+#include "objengine.h"
 #include "bi.h"
 #include "handlers.h"
 #include "mbed.h"
@@ -44,26 +46,85 @@ extern EventQueue bacQueue;
 extern BINARY_INPUT_DESCR BI_Descr[];
 
 uint32_t NUM_BINARY_INPUTS;
+/* instance number to BI_Descr[] index */
+static OBJECT_INDEX BI_Index;
 
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Binary_Input_Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_POLARITY,
-    -1
-};
+/* the descriptor of an instance, NULL if there is none */
+static BINARY_INPUT_DESCR *Binary_Input_Object(
+    uint32_t object_instance)
+{
+    unsigned index = 0;
+
+    if (object_index_find(&BI_Index, object_instance, &index))
+        return &BI_Descr[index];
 
-static const int Binary_Input_Properties_Optional[] = {
-    -1
+    return NULL;
+}
+
+static void Binary_Input_Read_Notify(
+    BINARY_INPUT_DESCR * object,
+    BACNET_PROPERTY_ID object_property)
+{
+    if (object->read_callback) {
+        uint8_t id = bacQueue.call(object->read_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_BI_RDCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_BI_RDCB_FAILED, id, 0); }
+    }
+}
+
+/* Present_Value is read only, it follows the input */
+static int Binary_Input_Read_Present_Value(
+    BINARY_INPUT_DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Present_Value);
+}
+
+/* The properties of the Binary Input object type, the ReadProperty
+   and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<BINARY_INPUT_DESCR>
+    Binary_Input_Properties[] = {
+    {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+        object_read_object_identifier<BINARY_INPUT_DESCR>, NULL},
+    {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+        object_read_string<BINARY_INPUT_DESCR,
+            &BINARY_INPUT_DESCR::Object_Name>, NULL},
+    {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+        object_read_object_type<BINARY_INPUT_DESCR>, NULL},
+    {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Binary_Input_Read_Present_Value, NULL},
+    {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        object_read_status_flags<BINARY_INPUT_DESCR>, NULL},
+    {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+        object_read_event_state<BINARY_INPUT_DESCR>, NULL},
+    {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+        object_read_out_of_service<BINARY_INPUT_DESCR>, NULL},
+    {PROP_POLARITY, OBJ_PROP_REQUIRED,
+        object_read_polarity<BINARY_INPUT_DESCR>, NULL},
+    {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+        object_read_string<BINARY_INPUT_DESCR,
+            &BINARY_INPUT_DESCR::Object_Description>, NULL},
 };
 
-static const int Binary_Input_Properties_Proprietary[] = {
-    -1
+static int Binary_Input_Property_List[
+    OBJ_PROPERTY_COUNT(Binary_Input_Properties) + 3];
+static uint8_t Binary_Input_Property_Order[
+    OBJ_PROPERTY_COUNT(Binary_Input_Properties) + 1];
+
+static const BACnet_Object_Class<BINARY_INPUT_DESCR> Binary_Input_Class = {
+    OBJECT_BINARY_INPUT,
+    Binary_Input_Properties,
+    OBJ_PROPERTY_COUNT(Binary_Input_Properties),
+    Binary_Input_Property_List,
+    Binary_Input_Property_Order,
+    Binary_Input_Object,
+    Binary_Input_Read_Notify,
+    NULL
 };
 
 void Binary_Input_Property_Lists(
@@ -71,17 +132,8 @@ void Binary_Input_Property_Lists(
     const int **pOptional,
     const int **pProprietary)
 {
-    if (pRequired) {
-        *pRequired = Binary_Input_Properties_Required;
-    }
-    if (pOptional) {
-        *pOptional = Binary_Input_Properties_Optional;
-    }
-    if (pProprietary) {
-        *pProprietary = Binary_Input_Properties_Proprietary;
-    }
-
-    return;
+    object_property_lists(&Binary_Input_Class, pRequired, pOptional,
+        pProprietary);
 }
 
 void Binary_Input_Init(
@@ -89,7 +141,17 @@ void Binary_Input_Init(
 {
     unsigned i;
 
-    for (i = 0; i < Binary_Input_Count(); i++) {
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_BINARY_INPUTS = 0;
+    while (BI_Descr[NUM_BINARY_INPUTS].Object_Instance <= BACNET_MAX_INSTANCE)
+        NUM_BINARY_INPUTS++;
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&BI_Index, NUM_BINARY_INPUTS, NUM_BINARY_INPUTS,
+            Binary_Input_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_BINARY_INPUT,
+            NUM_BINARY_INPUTS); }
+
+    for (i = 0; i < NUM_BINARY_INPUTS; i++) {
       BI_Descr[i].Changed = false;
 			if(BI_Descr[i].Polarity == POLARITY_NORMAL)
 				BI_Descr[i].Present_Value = BINARY_INACTIVE;
@@ -118,13 +180,7 @@ bool Binary_Input_Valid_Instance(
 unsigned Binary_Input_Count(
     void)
 {
-	uint32_t i=0;
-	
-	while(BI_Descr[i].Object_Instance <= BACNET_MAX_INSTANCE)
-		i++;
-	
-	NUM_BINARY_INPUTS = i;
-  return i;
+    return NUM_BINARY_INPUTS;
 }
 
 /* we simply have 0-n object instances.*/
@@ -142,13 +198,10 @@ unsigned Binary_Input_Instance_To_Index(
 {
     unsigned index = 0;
 
-    for(index=0; index<NUM_BINARY_INPUTS; index++)
-		{
-			if(BI_Descr[index].Object_Instance == object_instance)
-				return index;
-		}
+    if (object_index_find(&BI_Index, object_instance, &index))
+        return index;
 
-    return index;
+    return NUM_BINARY_INPUTS;
 }
 
 BACNET_BINARY_PV Binary_Input_Present_Value(
@@ -214,45 +267,10 @@ bool Binary_Input_Encode_Value_List(
     uint32_t object_instance,
     BACNET_PROPERTY_VALUE * value_list)
 {
-    bool status = false;
+    object_encode_value_list(&Binary_Input_Class, object_instance,
+        value_list);
 
-    if (value_list) {
-        value_list->propertyIdentifier = PROP_PRESENT_VALUE;
-        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-        value_list->value.context_specific = false;
-        value_list->value.tag = BACNET_APPLICATION_TAG_ENUMERATED;
-        value_list->value.next = NULL;
-        value_list->value.type.Enumerated =
-            Binary_Input_Present_Value(object_instance);
-        value_list->priority = BACNET_NO_PRIORITY;
-        value_list = value_list->next;
-    }
-    if (value_list) {
-        value_list->propertyIdentifier = PROP_STATUS_FLAGS;
-        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-        value_list->value.context_specific = false;
-        value_list->value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
-        value_list->value.next = NULL;
-        bitstring_init(&value_list->value.type.Bit_String);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-            STATUS_FLAG_IN_ALARM, false);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-            STATUS_FLAG_FAULT, false);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-            STATUS_FLAG_OVERRIDDEN, false);
-        if (Binary_Input_Out_Of_Service(object_instance)) {
-            bitstring_set_bit(&value_list->value.type.Bit_String,
-                STATUS_FLAG_OUT_OF_SERVICE, true);
-        } else {
-            bitstring_set_bit(&value_list->value.type.Bit_String,
-                STATUS_FLAG_OUT_OF_SERVICE, false);
-        }
-        value_list->priority = BACNET_NO_PRIORITY;
-        value_list->next = NULL;
-    }
-    status = Binary_Input_Change_Of_Value(object_instance);
-
-    return status;
+    return Binary_Input_Change_Of_Value(object_instance);
 }
 
 bool Binary_Input_Change_Of_Value(
@@ -280,88 +298,10 @@ void Binary_Input_Change_Of_Value_Clear(
 }
 
 /* return apdu length, or -1 on error */
-/* assumption - object already exists, and has been bounds checked */
 int Binary_Input_Read_Property(
     BACNET_READ_PROPERTY_DATA * rpdata)
 {
-    int apdu_len = 0;   /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    BACNET_BINARY_PV value = BINARY_INACTIVE;
-    uint8_t *apdu = NULL;
-	  uint32_t index;
-
-
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
-        return 0;
-    }
-		index = Binary_Input_Instance_To_Index(rpdata->object_instance);
-				
-		if(BI_Descr[index].read_callback)
-		{
-		  uint8_t id = bacQueue.call(BI_Descr[index].read_callback, (uint32_t)rpdata->object_property);
-		  
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_BI_RDCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_BI_RDCB_FAILED, id, 0); }
-		}
-		
-    apdu = rpdata->application_data;
-    switch (rpdata->object_property) {
-        case PROP_OBJECT_IDENTIFIER:
-            apdu_len =
-                encode_application_object_id(&apdu[0], OBJECT_BINARY_INPUT,
-                rpdata->object_instance);
-            break;
-        case PROP_OBJECT_NAME:
-        case PROP_DESCRIPTION:
-            Binary_Input_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_OBJECT_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], OBJECT_BINARY_INPUT);
-            break;
-        case PROP_PRESENT_VALUE:
-            value = Binary_Input_Present_Value(rpdata->object_instance);
-            apdu_len = encode_application_enumerated(&apdu[0], value);
-            break;
-        case PROP_STATUS_FLAGS:
-            /* note: see the details in the standard on how to use these */
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE, false);
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-        case PROP_EVENT_STATE:
-            /* note: see the details in the standard on how to use this */
-            apdu_len = encode_application_enumerated(&apdu[0], BI_Descr[index].Event_State);
-            break;
-        case PROP_OUT_OF_SERVICE:
-            apdu_len = encode_application_boolean(&apdu[0], false);
-            break;
-        case PROP_POLARITY:
-            apdu_len = encode_application_enumerated(&apdu[0], BI_Descr[index].Polarity);
-            break;
-        default:
-            rpdata->error_class = ERROR_CLASS_PROPERTY;
-            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            apdu_len = BACNET_STATUS_ERROR;
-            break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->array_index != BACNET_ARRAY_ALL)) {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+    return object_read_property(&Binary_Input_Class, rpdata);
 }
 
 bool Binary_Input_Present_Value_Set(
@@ -373,8 +313,10 @@ bool Binary_Input_Present_Value_Set(
 
     index = Binary_Input_Instance_To_Index(object_instance);
     if (index < NUM_BINARY_INPUTS) {
-			if (BI_Descr[index].Present_Value != value)
+			if (BI_Descr[index].Present_Value != value) {
 				BI_Descr[index].Changed = true;
+				handler_cov_object_changed(OBJECT_BINARY_INPUT, object_instance);
+			}
 			
 			BI_Descr[index].Present_Value = value;
 			status = true;
@@ -33,6 +33,9 @@
 #include "bacdcode.h"
 #include "bacenum.h"
 #include "config_bacnet.h"
+#include "objindex.h"
+#include "objengine.h"
+#include "objcommand.h"
 #include "handlers.h"
 #include "bo.h"
 
@@ -40,51 +43,170 @@
 
 extern EventQueue bacQueue;
 
-
-/* When all the priorities are level null, the present value returns */
-/* the Relinquish Default value */
-#define RELINQUISH_DEFAULT BINARY_INACTIVE
-
 extern BINARY_OUTPUT_DESCR BO_Descr[];
 
 uint32_t NUM_BINARY_OUTPUTS;
+/* instance number to BO_Descr[] index */
+static OBJECT_INDEX BO_Index;
 
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Binary_Output_Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_POLARITY,
-    PROP_PRIORITY_ARRAY,
-    PROP_RELINQUISH_DEFAULT,
-    -1
-};
+/* the descriptor of an instance, NULL if there is none */
+static BINARY_OUTPUT_DESCR *Binary_Output_Object(uint32_t object_instance)
+{
+    unsigned index = 0;
+
+    if (object_index_find(&BO_Index, object_instance, &index))
+        return &BO_Descr[index];
+
+    return NULL;
+}
+
+static void Binary_Output_Read_Notify(BINARY_OUTPUT_DESCR *object,
+                                      BACNET_PROPERTY_ID   object_property)
+{
+    if (object->read_callback) {
+        uint8_t id = bacQueue.call(object->read_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_BO_RDCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_BO_RDCB_FAILED, id, 0); }
+    }
+}
+
+static void Binary_Output_Write_Notify(BINARY_OUTPUT_DESCR           *object,
+                                       BACNET_PROPERTY_ID             object_property,
+                                       BACNET_APPLICATION_DATA_VALUE *value)
+{
+    if (object->write_callback) {
+        /* a relinquish passes the value now in charge */
+        bool level = (value->tag == BACNET_APPLICATION_TAG_NULL) ?
+            (object->Effective_Value == BINARY_ACTIVE) :
+            (bool) value->type.Boolean;
+        uint8_t id = bacQueue.call(object->write_callback,
+                                   (uint32_t) object_property,
+                                   level);
+
+        if (id > 0) { EVRECORD2(BACNET_EVQ_BO_WRCB_CALLED, id, 0); }
+        else        { EVRECORD2(BACNET_EVQ_BO_WRCB_FAILED, id, 0); }
+    }
+}
+
+/* a change of the present value is reported by COV */
+static void Binary_Output_Changed(BINARY_OUTPUT_DESCR *object)
+{
+    object->Changed = true;
+    handler_cov_object_changed(OBJECT_BINARY_OUTPUT, object->Object_Instance);
+}
+
+static int Binary_Output_Read_Present_Value(BINARY_OUTPUT_DESCR       *object,
+                                            BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Effective_Value);
+}
+
+static bool Binary_Output_Write_Present_Value(BINARY_OUTPUT_DESCR           *object,
+                                              BACNET_WRITE_PROPERTY_DATA    *wp_data,
+                                              BACNET_APPLICATION_DATA_VALUE *value)
+{
+    if (value->tag != BACNET_APPLICATION_TAG_NULL) {
+        if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_ENUMERATED,
+                &wp_data->error_class, &wp_data->error_code))
+            return false;
+        if (value->type.Enumerated > MAX_BINARY_PV)
+            return object_write_value_out_of_range(wp_data);
+    }
+    if (!object_write_priority_valid(wp_data))
+        return false;
+    if (value->tag == BACNET_APPLICATION_TAG_NULL)
+        return object_command_relinquish(object, wp_data->priority,
+            Binary_Output_Changed);
+
+    return object_command_set(object, wp_data->priority,
+        (uint8_t) value->type.Enumerated, Binary_Output_Changed);
+}
+
+static int Binary_Output_Encode_Priority(BINARY_OUTPUT_DESCR *object,
+                                         unsigned             element,
+                                         uint8_t             *apdu)
+{
+    if (!object_command_active(object, element + 1))
+        return encode_application_null(&apdu[0]);
+
+    return encode_application_enumerated(&apdu[0],
+        object->Present_Value[element]);
+}
+
+static int Binary_Output_Read_Priority_Array(BINARY_OUTPUT_DESCR       *object,
+                                             BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return object_read_array(object, rpdata, BACNET_MAX_PRIORITY,
+        Binary_Output_Encode_Priority);
+}
+
+static int Binary_Output_Read_Relinquish_Default(BINARY_OUTPUT_DESCR       *object,
+                                                 BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Relinquish_Default);
+}
 
-static const int Binary_Output_Properties_Optional[] = {
-    PROP_DESCRIPTION,
-    -1,
+/* The properties of the Binary Output object type, the ReadProperty,
+   WriteProperty and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<BINARY_OUTPUT_DESCR>
+    Binary_Output_Properties[] = {
+    {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+        object_read_object_identifier<BINARY_OUTPUT_DESCR>, NULL},
+    {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+        object_read_string<BINARY_OUTPUT_DESCR,
+            &BINARY_OUTPUT_DESCR::Object_Name>, NULL},
+    {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+        object_read_object_type<BINARY_OUTPUT_DESCR>, NULL},
+    {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Binary_Output_Read_Present_Value,
+        Binary_Output_Write_Present_Value},
+    {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        object_read_status_flags<BINARY_OUTPUT_DESCR>, NULL},
+    {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+        object_read_event_state<BINARY_OUTPUT_DESCR>, NULL},
+    {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+        object_read_out_of_service<BINARY_OUTPUT_DESCR>,
+        object_write_out_of_service<BINARY_OUTPUT_DESCR>},
+    {PROP_POLARITY, OBJ_PROP_REQUIRED,
+        object_read_polarity<BINARY_OUTPUT_DESCR>,
+        object_write_polarity<BINARY_OUTPUT_DESCR>},
+    {PROP_PRIORITY_ARRAY, OBJ_PROP_REQUIRED | OBJ_PROP_ARRAY,
+        Binary_Output_Read_Priority_Array, NULL},
+    {PROP_RELINQUISH_DEFAULT, OBJ_PROP_REQUIRED,
+        Binary_Output_Read_Relinquish_Default, NULL},
+    {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+        object_read_string<BINARY_OUTPUT_DESCR,
+            &BINARY_OUTPUT_DESCR::Object_Description>, NULL},
 };
 
-static const int Binary_Output_Properties_Proprietary[] = {
-    -1,
+static int Binary_Output_Property_List[
+    OBJ_PROPERTY_COUNT(Binary_Output_Properties) + 3];
+static uint8_t Binary_Output_Property_Order[
+    OBJ_PROPERTY_COUNT(Binary_Output_Properties) + 1];
+
+static const BACnet_Object_Class<BINARY_OUTPUT_DESCR> Binary_Output_Class = {
+    OBJECT_BINARY_OUTPUT,
+    Binary_Output_Properties,
+    OBJ_PROPERTY_COUNT(Binary_Output_Properties),
+    Binary_Output_Property_List,
+    Binary_Output_Property_Order,
+    Binary_Output_Object,
+    Binary_Output_Read_Notify,
+    Binary_Output_Write_Notify
 };
 
 void Binary_Output_Property_Lists(const int **pRequired,
                                   const int **pOptional,
                                   const int **pProprietary)
 {
-    if (pRequired)
-		{ *pRequired = Binary_Output_Properties_Required; }
-    if (pOptional)
-		{ *pOptional = Binary_Output_Properties_Optional; }
-    if (pProprietary)
-		{ *pProprietary = Binary_Output_Properties_Proprietary; }
-
-    return;
+    object_property_lists(&Binary_Output_Class, pRequired, pOptional,
+        pProprietary);
 }
 
 /* we simply have 0-n object instances. */
@@ -102,13 +224,7 @@ bool Binary_Output_Valid_Instance(uint32_t object_instance)
 /* we simply have 0-n object instances. */
 unsigned Binary_Output_Count(void)
 {
-	uint32_t i=0;
-	
-	while(BO_Descr[i].Object_Instance <= BACNET_MAX_INSTANCE)
-		i++;
-	
-	NUM_BINARY_OUTPUTS = i;
-  return i;
+    return NUM_BINARY_OUTPUTS;
 }
 
 /* we simply have 0-n object instances. */
@@ -122,74 +238,78 @@ unsigned Binary_Output_Instance_To_Index(uint32_t object_instance)
 {
     unsigned index = 0;
 
-    for(index=0; index<NUM_BINARY_OUTPUTS; index++)
-		{
-			if(BO_Descr[index].Object_Instance == object_instance)
-				return index;
-		}
-
-    return index;
-}
-
-static BACNET_BINARY_PV Present_Value(unsigned int index)
-{
-    BACNET_BINARY_PV value = RELINQUISH_DEFAULT;
-    BACNET_BINARY_PV current_value = RELINQUISH_DEFAULT;
-    unsigned i = 0;
-
-    if (index < NUM_BINARY_OUTPUTS) {
-        for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-            current_value = (BACNET_BINARY_PV) BO_Descr[index].Present_Value[i];
-            if (current_value != BINARY_NULL) {
-                value = (BACNET_BINARY_PV) BO_Descr[index].Present_Value[i];
-                break;
-            }
-        }
-    }
+    if (object_index_find(&BO_Index, object_instance, &index))
+        return index;
 
-    return value;
+    return NUM_BINARY_OUTPUTS;
 }
 
 BACNET_BINARY_PV Binary_Output_Present_Value(uint32_t object_instance)
 {
-    unsigned index = 0;
+    BINARY_OUTPUT_DESCR *object = Binary_Output_Object(object_instance);
 
-    index = Binary_Output_Instance_To_Index(object_instance);
+    if (object)
+        return (BACNET_BINARY_PV) object->Effective_Value;
 
-    return Present_Value(index);
+    return BINARY_INACTIVE;
 }
 
+/* a binary_value of BINARY_NULL relinquishes the priority */
 bool Binary_Output_Present_Value_Set(uint32_t         object_instance,
                                      BACNET_BINARY_PV binary_value,
                                      unsigned         priority)
-{       /* 0..15 */
-    bool status = false;
-		uint32_t index;
-	
-		index = Binary_Output_Instance_To_Index(object_instance);
-	
-    if (index < NUM_BINARY_OUTPUTS) {
-        if (priority <= BACNET_MAX_PRIORITY) {
-            BO_Descr[index].Present_Value[priority-1] = binary_value;
-            status = true;
-        }
-    }
+{
+    BINARY_OUTPUT_DESCR *object = Binary_Output_Object(object_instance);
 
-    return status;
+    if (!object)
+        return false;
+    if (binary_value == BINARY_NULL)
+        return object_command_relinquish(object, priority,
+            Binary_Output_Changed);
+
+    return object_command_set(object, priority, (uint8_t) binary_value,
+        Binary_Output_Changed);
 }
 
-static void Binary_Output_Polarity_Set(uint32_t        object_instance,
-                                       BACNET_POLARITY polarity)
+bool Binary_Output_Present_Value_Relinquish(uint32_t object_instance,
+                                            unsigned priority)
 {
-		uint32_t index;
-	
-    index = Binary_Output_Instance_To_Index(object_instance);
-	
-    if (index < NUM_BINARY_OUTPUTS)
-		{
-        if (polarity < MAX_POLARITY)
-				{ BO_Descr[index].Polarity = polarity; }
-    }
+    BINARY_OUTPUT_DESCR *object = Binary_Output_Object(object_instance);
+
+    if (object)
+        return object_command_relinquish(object, priority,
+            Binary_Output_Changed);
+
+    return false;
+}
+
+/* returns true if value has changed */
+bool Binary_Output_Encode_Value_List(uint32_t               object_instance,
+                                     BACNET_PROPERTY_VALUE *value_list)
+{
+    if (!object_encode_value_list(&Binary_Output_Class, object_instance,
+            value_list))
+        return false;
+
+    return Binary_Output_Change_Of_Value(object_instance);
+}
+
+bool Binary_Output_Change_Of_Value(uint32_t object_instance)
+{
+    BINARY_OUTPUT_DESCR *object = Binary_Output_Object(object_instance);
+
+    if (object)
+        return object->Changed;
+
+    return false;
+}
+
+void Binary_Output_Change_Of_Value_Clear(uint32_t object_instance)
+{
+    BINARY_OUTPUT_DESCR *object = Binary_Output_Object(object_instance);
+
+    if (object)
+        object->Changed = false;
 }
 
 BACNET_POLARITY Binary_Output_Polarity(uint32_t object_instance)
@@ -260,312 +380,35 @@ bool Binary_Output_Object_Description(uint32_t                 object_instance,
 /* return apdu len, or -1 on error */
 int Binary_Output_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 {
-    int len = 0;
-    int apdu_len = 0;   /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    BACNET_BINARY_PV present_value = BINARY_INACTIVE;
-    unsigned object_index = 0;
-    unsigned i = 0;
-    bool state = false;
-    uint8_t *apdu = NULL;
-
-    if ((rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
-        return 0;
-    }
-		
-		object_index = Binary_Output_Instance_To_Index(rpdata->object_instance);
-		
-		if(BO_Descr[object_index].read_callback)
-		{
-		  uint8_t id = bacQueue.call(BO_Descr[object_index].read_callback, (uint32_t)rpdata->object_property);
-		  
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_BO_RDCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_BO_RDCB_FAILED, id, 0); }
-		}
-		
-    apdu = rpdata->application_data;
-    switch (rpdata->object_property) {
-				case PROP_OBJECT_NAME:
-            Binary_Output_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_DESCRIPTION:
-            Binary_Output_Object_Description(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_PRESENT_VALUE:
-            present_value =
-                Binary_Output_Present_Value(rpdata->object_instance);
-            apdu_len = encode_application_enumerated(&apdu[0], present_value);
-            break;
-        case PROP_STATUS_FLAGS:
-            /* note: see the details in the standard on how to use these */
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE, false);
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-        case PROP_EVENT_STATE:
-            /* note: see the details in the standard on how to use this */
-            apdu_len =
-                encode_application_enumerated(&apdu[0], EVENT_STATE_NORMAL);
-            break;
-        case PROP_OUT_OF_SERVICE:
-            object_index =
-                Binary_Output_Instance_To_Index(rpdata->object_instance);
-            state = BO_Descr[object_index].Out_Of_Service;
-            apdu_len = encode_application_boolean(&apdu[0], state);
-            break;
-        case PROP_POLARITY:
-            object_index =
-                Binary_Output_Instance_To_Index(rpdata->object_instance);
-            apdu_len =
-                encode_application_enumerated(&apdu[0],
-                BO_Descr[object_index].Polarity);
-            break;
-        case PROP_PRIORITY_ARRAY:
-            /* Array element zero is the number of elements in the array */
-            if (rpdata->array_index == 0)
-                apdu_len =
-                    encode_application_unsigned(&apdu[0], BACNET_MAX_PRIORITY);
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            else if (rpdata->array_index == BACNET_ARRAY_ALL) {
-                object_index =
-                    Binary_Output_Instance_To_Index(rpdata->object_instance);
-                for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-                    /* FIXME: check if we have room before adding it to APDU */
-                    present_value = (BACNET_BINARY_PV) BO_Descr[object_index].Present_Value[i];
-                    if (present_value == BINARY_NULL) {
-                        len = encode_application_null(&apdu[apdu_len]);
-                    } else {
-                        len =
-                            encode_application_enumerated(&apdu[apdu_len],
-                            present_value);
-                    }
-                    /* add it if we have room */
-                    if ((apdu_len + len) < MAX_APDU)
-                        apdu_len += len;
-                    else {
-                        rpdata->error_class = ERROR_CLASS_SERVICES;
-                        rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                        apdu_len = BACNET_STATUS_ERROR;
-                        break;
-                    }
-                }
-            } else {
-                object_index =
-                    Binary_Output_Instance_To_Index(rpdata->object_instance);
-                if (rpdata->array_index <= BACNET_MAX_PRIORITY) {
-                    present_value = (BACNET_BINARY_PV)
-                        BO_Descr[object_index].Present_Value[rpdata->array_index -
-                        1];
-                    if (present_value == BINARY_NULL) {
-                        apdu_len = encode_application_null(&apdu[apdu_len]);
-                    } else {
-                        apdu_len =
-                            encode_application_enumerated(&apdu[apdu_len],
-                            present_value);
-                    }
-                } else {
-                    rpdata->error_class = ERROR_CLASS_PROPERTY;
-                    rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                    apdu_len = BACNET_STATUS_ERROR;
-                }
-            }
-            break;
-        case PROP_RELINQUISH_DEFAULT:
-            present_value = RELINQUISH_DEFAULT;
-            apdu_len = encode_application_enumerated(&apdu[0], present_value);
-            break;
-        case PROP_ACTIVE_TEXT:
-//            characterstring_init_ansi(&char_string, "on");
-//            apdu_len =
-//                encode_application_character_string(&apdu[0], &char_string);
-//            break;
-        case PROP_INACTIVE_TEXT:
-//            characterstring_init_ansi(&char_string, "off");
-//            apdu_len =
-//                encode_application_character_string(&apdu[0], &char_string);
-//            break;
-        default:
-            rpdata->error_class = ERROR_CLASS_PROPERTY;
-            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            apdu_len = BACNET_STATUS_ERROR;
-            break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->object_property != PROP_PRIORITY_ARRAY) &&
-        (rpdata->array_index != BACNET_ARRAY_ALL)) {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+    return object_read_property(&Binary_Output_Class, rpdata);
 }
 
 /* returns true if successful */
 bool Binary_Output_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
 {
-    bool status = false;        /* return value */
-    unsigned int priority = 0;
-    BACNET_BINARY_PV level = BINARY_NULL;
-    int len = 0;
-    BACNET_APPLICATION_DATA_VALUE value;
-		unsigned object_index = 0;
-
-    /* decode the some of the request */
-    len =
-        bacapp_decode_application_data(wp_data->application_data,
-        wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0)
-		{
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-        return false;
-    }
-    if ((wp_data->object_property != PROP_PRIORITY_ARRAY) &&
-        (wp_data->array_index != BACNET_ARRAY_ALL))
-		{
-        /*  only array properties can have array options */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        return false;
-    }
-		
-		object_index = Binary_Output_Instance_To_Index(wp_data->object_instance);
-		
-    switch (wp_data->object_property)
-		{
-        case PROP_PRESENT_VALUE:
-						priority = wp_data->priority;
-            status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED, &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                /* Command priority 6 is reserved for use by Minimum On/Off
-                   algorithm and may not be used for other purposes in any
-                   object. */
-                if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-                    (priority != 6 /* reserved */ ) &&
-                    (value.type.Enumerated <= MAX_BINARY_PV)) {
-                    level = (BACNET_BINARY_PV) value.type.Enumerated;
-                    status = Binary_Output_Present_Value_Set(wp_data->object_instance, level, priority);
-                } else if (priority == 6) {
-                    /* Command priority 6 is reserved for use by Minimum On/Off
-                       algorithm and may not be used for other purposes in any
-                       object. */
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                } else {
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                }
-            } else {
-                status =
-                    WPValidateArgType(&value, BACNET_APPLICATION_TAG_NULL,
-                    &wp_data->error_class, &wp_data->error_code);
-                if (status) {
-                    level = BINARY_NULL;
-                    priority = wp_data->priority;
-                    if (priority && (priority <= BACNET_MAX_PRIORITY)) {
-                        status = Binary_Output_Present_Value_Set(wp_data->object_instance, level, priority);
-                    } else if (priority == 6) {
-                        status = false;
-                        /* Command priority 6 is reserved for use by Minimum On/Off
-                           algorithm and may not be used for other purposes in any
-                           object. */
-                        wp_data->error_class = ERROR_CLASS_PROPERTY;
-                        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                    } else {
-                        status = false;
-                        wp_data->error_class = ERROR_CLASS_PROPERTY;
-                        wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
-                    }
-                }
-            }
-            break;
-        case PROP_OUT_OF_SERVICE:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_BOOLEAN,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                Binary_Output_Out_Of_Service_Set(wp_data->object_instance,
-                    value.type.Boolean);
-            }
-            break;
-        case PROP_POLARITY:
-            status =
-                WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED,
-                &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-                if (value.type.Enumerated < MAX_POLARITY) {
-                    Binary_Output_Polarity_Set(wp_data->object_instance,
-                        (BACNET_POLARITY) value.type.Enumerated);
-                } else {
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                }
-            }
-            break;
-        case PROP_OBJECT_IDENTIFIER:
-        case PROP_OBJECT_NAME:
-        case PROP_OBJECT_TYPE:
-        case PROP_STATUS_FLAGS:
-        case PROP_RELIABILITY:
-        case PROP_EVENT_STATE:
-        case PROP_PRIORITY_ARRAY:
-        case PROP_RELINQUISH_DEFAULT:
-        case PROP_ACTIVE_TEXT:
-        case PROP_INACTIVE_TEXT:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-            break;
-        default:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            break;
-    }
-    /* not using len at this time */
-    len = len;
-						
-		if(BO_Descr[object_index].write_callback)
-		{
-		  uint8_t id = bacQueue.call(BO_Descr[object_index].write_callback, 
-                                 (uint32_t)wp_data->object_property, 
-                                 (bool)    value.type.Boolean);
-      
-      id += id;
-		  
-		  if(id > 0) { EVRECORD2(BACNET_EVQ_BO_WRCB_CALLED, id, 0); }
-		  else       { EVRECORD2(BACNET_EVQ_BO_WRCB_FAILED, id, 0); }
-		}
-		
-    return status;
+    return object_write_property(&Binary_Output_Class, wp_data);
 }
 
 void Binary_Output_Init(void)
 {
-    unsigned i, j;
-
-    /* initialize all the analog output priority arrays to NULL */
-    for (i = 0; i < Binary_Output_Count(); i++)
+    unsigned i;
+
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_BINARY_OUTPUTS = 0;
+    while (BO_Descr[NUM_BINARY_OUTPUTS].Object_Instance <= BACNET_MAX_INSTANCE)
+        NUM_BINARY_OUTPUTS++;
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&BO_Index, NUM_BINARY_OUTPUTS, NUM_BINARY_OUTPUTS,
+            Binary_Output_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_BINARY_OUTPUT,
+            NUM_BINARY_OUTPUTS); }
+
+    /* initialize all the binary output priority arrays to NULL */
+    for (i = 0; i < NUM_BINARY_OUTPUTS; i++)
 		{
         Binary_Output_Out_Of_Service_Set(i, false);
-        for (j = 0; j < BACNET_MAX_PRIORITY; j++)
-				{ BO_Descr[i].Present_Value[j] = BINARY_NULL; }
+        object_command_init(&BO_Descr[i]);
+        BO_Descr[i].Changed = false;
     }
 
     return;
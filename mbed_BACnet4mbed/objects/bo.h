@@ -48,8 +48,13 @@ extern "C" {
 			bo_callback_wr write_callback;
 			unsigned Event_State:3;
 			uint8_t Present_Value[16];
+			/* see objcommand.h */
+			uint16_t Priority_Active;
+			uint8_t Relinquish_Default;
+			uint8_t Effective_Value;
 			BACNET_RELIABILITY Reliability;
 			bool Out_Of_Service;
+			bool Changed;
 		} BINARY_OUTPUT_DESCR;
 		
     void Binary_Output_Property_Lists(
@@ -32,6 +32,10 @@
 #include "bacdcode.h"
 #include "bacenum.h"
 #include "config_bacnet.h"     /* the custom stuff */
+#include "objindex.h"
+#include "objpool.h"
+#include "objengine.h"
+#include "objcommand.h"
 #include "bv.h"
 #include "handlers.h"
 #include "mbed.h"
@@ -40,70 +44,353 @@
 
 extern EventQueue bacQueue;
 
-
-#define RELINQUISH_DEFAULT BINARY_INACTIVE
-
 extern BINARY_VALUE_DESCR BV_Descr[];
 
 uint32_t NUM_BINARY_VALUES;
+/* instance number to BV_Descr[] index */
+static OBJECT_INDEX BV_Index;
+/* BV_Descr[] are followed by the objects created at runtime */
+static unsigned BV_Static_Count;
+
+typedef struct binary_value_object {
+    BINARY_VALUE_DESCR Descr;
+    char Name[MAX_CREATED_OBJECT_NAME_LEN + 1];
+} BINARY_VALUE_OBJECT;
+
+static BINARY_VALUE_OBJECT BV_Created[MAX_CREATED_OBJECTS];
+static uint16_t BV_Created_Order[MAX_CREATED_OBJECTS];
+static OBJECT_POOL BV_Pool;
+static char BV_No_Description[] = "";
+
+/* the descriptor at an index of the instance index */
+static BINARY_VALUE_DESCR *Binary_Value_Descr(
+    unsigned index)
+{
+    if (index < BV_Static_Count)
+        return &BV_Descr[index];
 
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Binary_Value_Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_POLARITY,
-    PROP_PRIORITY_ARRAY,
-    PROP_RELINQUISH_DEFAULT,
-    -1
-};
+    return (BINARY_VALUE_DESCR *) object_pool_at(&BV_Pool,
+        index - BV_Static_Count);
+}
+
+/* the descriptor of an instance, NULL if there is none */
+static BINARY_VALUE_DESCR *Binary_Value_Object(uint32_t object_instance)
+{
+    unsigned index = 0;
+
+    if (object_index_find(&BV_Index, object_instance, &index))
+        return Binary_Value_Descr(index);
+
+    return NULL;
+}
+
+static void Binary_Value_Read_Notify(BINARY_VALUE_DESCR *object,
+                                     BACNET_PROPERTY_ID  object_property)
+{
+    if (object->read_callback) {
+        uint8_t id = bacQueue.call(object->read_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_BV_RDCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_BV_RDCB_FAILED, id, 0); }
+    }
+}
+
+static void Binary_Value_Write_Notify(BINARY_VALUE_DESCR            *object,
+                                      BACNET_PROPERTY_ID             object_property,
+                                      BACNET_APPLICATION_DATA_VALUE *value)
+{
+    (void) value;
+    if (object->write_callback) {
+        uint8_t id = bacQueue.call(object->write_callback,
+            (uint32_t) object_property);
+
+        if (id > 0)
+        { EVRECORD2(BACNET_EVQ_BV_WRCB_CALLED, id, 0); }
+        else
+        { EVRECORD2(BACNET_EVQ_BV_WRCB_FAILED, id, 0); }
+    }
+}
+
+static int Binary_Value_Read_Present_Value(BINARY_VALUE_DESCR        *object,
+                                           BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Effective_Value);
+}
+
+static bool Binary_Value_Write_Present_Value(BINARY_VALUE_DESCR            *object,
+                                             BACNET_WRITE_PROPERTY_DATA    *wp_data,
+                                             BACNET_APPLICATION_DATA_VALUE *value)
+{
+    BACNET_BINARY_PV level = BINARY_NULL;
+
+    if (value->tag != BACNET_APPLICATION_TAG_NULL) {
+        if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_ENUMERATED,
+                &wp_data->error_class, &wp_data->error_code))
+            return false;
+        if (value->type.Enumerated > MAX_BINARY_PV)
+            return object_write_value_out_of_range(wp_data);
+        level = (BACNET_BINARY_PV) value->type.Enumerated;
+    }
+    if (object->PV_WriteProtected) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+    if (!object_write_priority_valid(wp_data))
+        return false;
+
+    return Binary_Value_Present_Value_Set(wp_data->object_instance, level,
+        wp_data->priority);
+}
 
-static const int Binary_Value_Properties_Optional[] = {
-    PROP_DESCRIPTION,
-    -1
+static int Binary_Value_Encode_Priority(BINARY_VALUE_DESCR *object,
+                                        unsigned            element,
+                                        uint8_t            *apdu)
+{
+    if (!object_command_active(object, element + 1))
+        return encode_application_null(&apdu[0]);
+
+    return encode_application_enumerated(&apdu[0],
+        object->Present_Value[element]);
+}
+
+static int Binary_Value_Read_Priority_Array(BINARY_VALUE_DESCR        *object,
+                                            BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return object_read_array(object, rpdata, BACNET_MAX_PRIORITY,
+        Binary_Value_Encode_Priority);
+}
+
+static int Binary_Value_Read_Relinquish_Default(BINARY_VALUE_DESCR        *object,
+                                                BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Relinquish_Default);
+}
+
+/* only the objects created at runtime have a buffer for a new name */
+static bool Binary_Value_Write_Object_Name(
+    BINARY_VALUE_DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!object_pool_owns(&BV_Pool, object)) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+
+    return object_write_name(wp_data, value,
+        ((BINARY_VALUE_OBJECT *) object)->Name, sizeof(((BINARY_VALUE_OBJECT *) object)->Name));
+}
+
+/* The properties of the Binary Value object type, the ReadProperty,
+   WriteProperty and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<BINARY_VALUE_DESCR>
+    Binary_Value_Properties[] = {
+    {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+        object_read_object_identifier<BINARY_VALUE_DESCR>, NULL},
+    {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+        object_read_string<BINARY_VALUE_DESCR,
+            &BINARY_VALUE_DESCR::Object_Name>,
+        Binary_Value_Write_Object_Name},
+    {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+        object_read_object_type<BINARY_VALUE_DESCR>, NULL},
+    {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        Binary_Value_Read_Present_Value,
+        Binary_Value_Write_Present_Value},
+    {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+        object_read_status_flags<BINARY_VALUE_DESCR>, NULL},
+    {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+        object_read_event_state<BINARY_VALUE_DESCR>, NULL},
+    {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+        object_read_out_of_service<BINARY_VALUE_DESCR>,
+        object_write_out_of_service<BINARY_VALUE_DESCR>},
+    {PROP_POLARITY, OBJ_PROP_REQUIRED,
+        object_read_polarity<BINARY_VALUE_DESCR>, NULL},
+    {PROP_PRIORITY_ARRAY, OBJ_PROP_REQUIRED | OBJ_PROP_ARRAY,
+        Binary_Value_Read_Priority_Array, NULL},
+    {PROP_RELINQUISH_DEFAULT, OBJ_PROP_REQUIRED,
+        Binary_Value_Read_Relinquish_Default, NULL},
+    {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+        object_read_string<BINARY_VALUE_DESCR,
+            &BINARY_VALUE_DESCR::Object_Description>, NULL},
 };
 
-static const int Binary_Value_Properties_Proprietary[] = {
-    -1
+static int Binary_Value_Property_List[
+    OBJ_PROPERTY_COUNT(Binary_Value_Properties) + 3];
+static uint8_t Binary_Value_Property_Order[
+    OBJ_PROPERTY_COUNT(Binary_Value_Properties) + 1];
+
+static const BACnet_Object_Class<BINARY_VALUE_DESCR> Binary_Value_Class = {
+    OBJECT_BINARY_VALUE,
+    Binary_Value_Properties,
+    OBJ_PROPERTY_COUNT(Binary_Value_Properties),
+    Binary_Value_Property_List,
+    Binary_Value_Property_Order,
+    Binary_Value_Object,
+    Binary_Value_Read_Notify,
+    Binary_Value_Write_Notify
 };
 
-void Binary_Value_Property_Lists(
-    const int **pRequired,
-    const int **pOptional,
-    const int **pProprietary)
+void Binary_Value_Property_Lists(const int **pRequired,
+                                 const int **pOptional,
+                                 const int **pProprietary)
 {
-    if (pRequired)
-        *pRequired = Binary_Value_Properties_Required;
-    if (pOptional)
-        *pOptional = Binary_Value_Properties_Optional;
-    if (pProprietary)
-        *pProprietary = Binary_Value_Properties_Proprietary;
-
-    return;
+    object_property_lists(&Binary_Value_Class, pRequired, pOptional,
+        pProprietary);
 }
 
 void Binary_Value_Init(
     void)
 {
-     unsigned i, j;
+     unsigned i;
 
     
-    for (i = 0; i < Binary_Value_Count(); i++) {
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_BINARY_VALUES = 0;
+    while (BV_Descr[NUM_BINARY_VALUES].Object_Instance <= BACNET_MAX_INSTANCE)
+        NUM_BINARY_VALUES++;
+    BV_Static_Count = NUM_BINARY_VALUES;
+    object_pool_init(&BV_Pool, BV_Created, sizeof(BINARY_VALUE_OBJECT),
+        BV_Created_Order, MAX_CREATED_OBJECTS);
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&BV_Index, NUM_BINARY_VALUES + MAX_CREATED_OBJECTS,
+            NUM_BINARY_VALUES, Binary_Value_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_BINARY_VALUE,
+            NUM_BINARY_VALUES); }
+
+    for (i = 0; i < NUM_BINARY_VALUES; i++) {
 				BV_Descr[i].Event_State = EVENT_STATE_NORMAL;
 				BV_Descr[i].Out_Of_Service = false;
 				BV_Descr[i].Reliability = RELIABILITY_NO_FAULT_DETECTED;
 				BV_Descr[i].Changed = false;
 			/* initialize all the binary value priority arrays to NULL */
-        for (j = 0; j < BACNET_MAX_PRIORITY; j++) {
-            BV_Descr[i].Present_Value[j] = BINARY_NULL;
-        }
+        object_command_init(&BV_Descr[i]);
     }
 }
 
+/** Creates an object with default values, e.g. for CreateObject.
+ * @param object_instance [in] The instance of the new object.
+ * @return true if the object was created, false if the instance exists
+ *         or MAX_CREATED_OBJECTS are in use.
+ */
+bool Binary_Value_Create(
+    uint32_t object_instance)
+{
+    BINARY_VALUE_OBJECT *object = NULL;
+    BINARY_VALUE_DESCR *descr = NULL;
+
+    if ((object_instance > BACNET_MAX_INSTANCE) ||
+        Binary_Value_Valid_Instance(object_instance))
+        return false;
+    object = (BINARY_VALUE_OBJECT *) object_pool_alloc(&BV_Pool);
+    if (!object)
+        return false;
+    snprintf(object->Name, sizeof(object->Name), "BV_%lu",
+        (unsigned long) object_instance);
+    descr = &object->Descr;
+    descr->Object_Instance = object_instance;
+    descr->Object_Name = object->Name;
+    descr->Object_Description = BV_No_Description;
+    descr->Relinquish_Default = BINARY_INACTIVE;
+    object_command_init(descr);
+    descr->Polarity = POLARITY_NORMAL;
+    descr->Event_State = EVENT_STATE_NORMAL;
+    descr->Reliability = RELIABILITY_NO_FAULT_DETECTED;
+    /* lookups by instance find the object only once it is filled in */
+    core_util_critical_section_enter();
+    if (!object_index_add(&BV_Index, object_instance, NUM_BINARY_VALUES)) {
+        core_util_critical_section_exit();
+        object_pool_free(&BV_Pool, object);
+        return false;
+    }
+    NUM_BINARY_VALUES++;
+    core_util_critical_section_exit();
+    Device_Object_Name_Index_Add(OBJECT_BINARY_VALUE, object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_ADDED, OBJECT_BINARY_VALUE,
+        object_instance);
+
+    return true;
+}
+
+/** Deletes an object created at runtime, those of BV_Descr[] stay.
+ * The last created object takes over the position of the deleted one.
+ * @param object_instance [in] The instance of the object.
+ * @return true if the object was deleted.
+ */
+bool Binary_Value_Delete(
+    uint32_t object_instance)
+{
+    BINARY_VALUE_DESCR *object = Binary_Value_Object(object_instance);
+    BINARY_VALUE_DESCR *last = NULL;
+    unsigned position = 0;
+
+    if (!object || !object_pool_owns(&BV_Pool, object))
+        return false;
+    position = object_pool_position(&BV_Pool, object);
+    last = (BINARY_VALUE_DESCR *) object_pool_at(&BV_Pool,
+        object_pool_count(&BV_Pool) - 1);
+    Device_Object_Name_Index_Remove(OBJECT_BINARY_VALUE, object_instance);
+    /* the application thread and the COV ticker look objects up by
+       instance, they must not see the index half moved */
+    core_util_critical_section_enter();
+    object_index_remove(&BV_Index, object_instance);
+    object_pool_free(&BV_Pool, object);
+    if (last != object) {
+        object_index_remove(&BV_Index, last->Object_Instance);
+        object_index_add(&BV_Index, last->Object_Instance,
+            BV_Static_Count + position);
+    }
+    NUM_BINARY_VALUES--;
+    core_util_critical_section_exit();
+    Device_Object_Changed(OBJECT_CHANGE_REMOVED, OBJECT_BINARY_VALUE,
+        object_instance);
+
+    return true;
+}
+
+/* deletes all objects created at runtime */
+void Binary_Value_Cleanup(
+    void)
+{
+    while (object_pool_count(&BV_Pool)) {
+        BINARY_VALUE_DESCR *object =
+            (BINARY_VALUE_DESCR *) object_pool_at(&BV_Pool, 0);
+
+        Binary_Value_Delete(object->Object_Instance);
+    }
+}
+
+/** Renames an object created at runtime, the names of BV_Descr[]
+ *  are fixed.
+ * @param object_instance [in] The instance of the object.
+ * @param new_name [in] The new name, truncated to
+ *        MAX_CREATED_OBJECT_NAME_LEN characters.
+ * @return true if the object was renamed.
+ */
+bool Binary_Value_Name_Set(
+    uint32_t object_instance,
+    char *new_name)
+{
+    BINARY_VALUE_DESCR *object = Binary_Value_Object(object_instance);
+
+    if (!object || !new_name || !object_pool_owns(&BV_Pool, object))
+        return false;
+    Device_Object_Name_Index_Remove(OBJECT_BINARY_VALUE, object_instance);
+    snprintf(((BINARY_VALUE_OBJECT *) object)->Name,
+        sizeof(((BINARY_VALUE_OBJECT *) object)->Name), "%s", new_name);
+    Device_Object_Name_Index_Add(OBJECT_BINARY_VALUE, object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_RENAMED, OBJECT_BINARY_VALUE,
+        object_instance);
+
+    return true;
+}
+
 /* we simply have 0-n object instances. */
 bool Binary_Value_Valid_Instance(
     uint32_t object_instance)
@@ -121,20 +408,14 @@ bool Binary_Value_Valid_Instance(
 unsigned Binary_Value_Count(
     void)
 {
-	uint32_t i=0;
-	
-	while(BV_Descr[i].Object_Instance <= BACNET_MAX_INSTANCE)
-		i++;
-	
-	NUM_BINARY_VALUES = i;
-  return i;
+    return NUM_BINARY_VALUES;
 }
 
 /* we simply have 0-n object instances. */
 uint32_t Binary_Value_Index_To_Instance(
     unsigned index)
 {
-    return BV_Descr[index].Object_Instance;
+    return Binary_Value_Descr(index)->Object_Instance;
 }
 
 /* we simply have 0-n object instances.  */
@@ -143,108 +424,71 @@ unsigned Binary_Value_Instance_To_Index(
 {
     unsigned index = 0;
 
-    for(index=0; index<NUM_BINARY_VALUES; index++)
-		{
-			if(BV_Descr[index].Object_Instance == object_instance)
-				return index;
-		}
+    if (object_index_find(&BV_Index, object_instance, &index))
+        return index;
 
-    return index;
+    return NUM_BINARY_VALUES;
 }
 
 BACNET_BINARY_PV Binary_Value_Present_Value(
     uint32_t object_instance)
 {
-	BACNET_BINARY_PV value = RELINQUISH_DEFAULT;
-	BACNET_BINARY_PV current_value = RELINQUISH_DEFAULT;
-	unsigned i = 0;
-	unsigned index = 0;
-	
-	index = Binary_Value_Instance_To_Index(object_instance);
-	
-	if (index < NUM_BINARY_VALUES) {
-			for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-					current_value = (BACNET_BINARY_PV) BV_Descr[index].Present_Value[i];
-					if (current_value != BINARY_NULL) {
-							value = (BACNET_BINARY_PV) BV_Descr[index].Present_Value[i];
-							break;
-					}
-			}
-	}
+    BINARY_VALUE_DESCR *object = Binary_Value_Object(object_instance);
+
+    if (object)
+        return (BACNET_BINARY_PV) object->Effective_Value;
 
-	return value;
+    return BINARY_INACTIVE;
 }
 
+/* a change of the present value is reported by COV */
+static void Binary_Value_Changed(
+    BINARY_VALUE_DESCR * object)
+{
+    object->Changed = true;
+    handler_cov_object_changed(OBJECT_BINARY_VALUE, object->Object_Instance);
+}
+
+/* a value of BINARY_NULL relinquishes the priority */
 bool Binary_Value_Present_Value_Set(
         uint32_t object_instance,
         BACNET_BINARY_PV value,
         unsigned priority)
 {
-		bool status = false;
-		BACNET_BINARY_PV current_value;
-		uint32_t index;
+    BINARY_VALUE_DESCR *object = Binary_Value_Object(object_instance);
 
-		index = Binary_Value_Instance_To_Index(object_instance);
-		
-		if (index < NUM_BINARY_VALUES) {
-			if (priority <= BACNET_MAX_PRIORITY) {
-				
-				current_value = Binary_Value_Present_Value(object_instance);
-				
-				if (current_value != value)
-					BV_Descr[index].Changed = true;
-				
-				BV_Descr[index].Present_Value[priority-1] = value;
-				status = true;
-			}
-		}
+    if (!object)
+        return false;
+    if (value == BINARY_NULL)
+        return object_command_relinquish(object, priority,
+            Binary_Value_Changed);
 
-		return status;
+    return object_command_set(object, priority, (uint8_t) value,
+        Binary_Value_Changed);
+}
+
+bool Binary_Value_Present_Value_Relinquish(
+    uint32_t object_instance,
+    unsigned priority)
+{
+    BINARY_VALUE_DESCR *object = Binary_Value_Object(object_instance);
+
+    if (object)
+        return object_command_relinquish(object, priority,
+            Binary_Value_Changed);
+
+    return false;
 }
 
 bool Binary_Value_Encode_Value_List(
 	uint32_t object_instance,
 	BACNET_PROPERTY_VALUE * value_list)
 {
-	bool status = false;
-
-	if (value_list) {
-			value_list->propertyIdentifier = PROP_PRESENT_VALUE;
-			value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-			value_list->value.context_specific = false;
-			value_list->value.tag = BACNET_APPLICATION_TAG_ENUMERATED;
-			value_list->value.next = NULL;
-			value_list->value.type.Enumerated =
-					Binary_Value_Present_Value(object_instance);
-			value_list->priority = BACNET_NO_PRIORITY;
-			value_list = value_list->next;
-	}
-	if (value_list) {
-			value_list->propertyIdentifier = PROP_STATUS_FLAGS;
-			value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-			value_list->value.context_specific = false;
-			value_list->value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
-			value_list->value.next = NULL;
-			bitstring_init(&value_list->value.type.Bit_String);
-			bitstring_set_bit(&value_list->value.type.Bit_String,
-					STATUS_FLAG_IN_ALARM, false);
-			bitstring_set_bit(&value_list->value.type.Bit_String,
-					STATUS_FLAG_FAULT, false);
-			bitstring_set_bit(&value_list->value.type.Bit_String,
-					STATUS_FLAG_OVERRIDDEN, false);
-			if (Binary_Value_Out_Of_Service(object_instance)) {
-					bitstring_set_bit(&value_list->value.type.Bit_String,
-							STATUS_FLAG_OUT_OF_SERVICE, true);
-			} else {
-					bitstring_set_bit(&value_list->value.type.Bit_String,
-							STATUS_FLAG_OUT_OF_SERVICE, false);
-			}
-			value_list->priority = BACNET_NO_PRIORITY;
-			value_list->next = NULL;
-	}
-	status = Binary_Value_Change_Of_Value(object_instance);
+	if (!object_encode_value_list(&Binary_Value_Class, object_instance,
+	        value_list))
+		return false;
 
-	return status;	
+	return Binary_Value_Change_Of_Value(object_instance);
 }
 
 bool Binary_Value_Change_Of_Value(
@@ -254,7 +498,7 @@ bool Binary_Value_Change_Of_Value(
 
 	index = Binary_Value_Instance_To_Index(object_instance);
 	if (index < NUM_BINARY_VALUES) {
-		return BV_Descr[index].Changed;
+		return Binary_Value_Descr(index)->Changed;
 	}
 	
 	return false;	
@@ -267,7 +511,7 @@ void Binary_Value_Change_Of_Value_Clear(
 
     index = Binary_Value_Instance_To_Index(object_instance);
     if (index < NUM_BINARY_VALUES) {
-			BV_Descr[index].Changed = false;
+			Binary_Value_Descr(index)->Changed = false;
 		}
 }
 		
@@ -280,7 +524,7 @@ bool Binary_Value_Out_Of_Service(
     index = Binary_Value_Instance_To_Index(object_instance);
 	
     if (index < NUM_BINARY_VALUES) {
-        flag = BV_Descr[index].Out_Of_Service;
+        flag = Binary_Value_Descr(index)->Out_Of_Service;
     }
 
     return flag;
@@ -295,7 +539,7 @@ void Binary_Value_Out_Of_Service_Set(
 		index = Binary_Value_Instance_To_Index(object_instance);
 
 		if (index < NUM_BINARY_VALUES) {
-				BV_Descr[index].Out_Of_Service = flag;
+				Binary_Value_Descr(index)->Out_Of_Service = flag;
 		}
 }
 BACNET_POLARITY Binary_Value_Polarity(
@@ -307,7 +551,7 @@ BACNET_POLARITY Binary_Value_Polarity(
 	index = Binary_Value_Instance_To_Index(object_instance);
 
 	if (index < NUM_BINARY_VALUES) {
-			polarity = BV_Descr[index].Polarity;
+			polarity = Binary_Value_Descr(index)->Polarity;
 	}
 
 	return polarity;
@@ -323,8 +567,8 @@ bool Binary_Value_Object_Name(
 	
 		index = Binary_Value_Instance_To_Index(object_instance);
 	
-    if (object_instance < NUM_BINARY_VALUES) {
-        status = characterstring_init_ansi(object_name, BV_Descr[index].Object_Name);
+    if (index < NUM_BINARY_VALUES) {
+        status = characterstring_init_ansi(object_name, Binary_Value_Descr(index)->Object_Name);
     }
 
     return status;
@@ -339,9 +583,9 @@ bool Binary_Value_Description(
   
   index = Binary_Value_Instance_To_Index(object_instance);
   
-  if (object_instance < NUM_BINARY_VALUES)
+  if (index < NUM_BINARY_VALUES)
   {
-    status = characterstring_init_ansi(description, BV_Descr[index].Object_Description);
+    status = characterstring_init_ansi(description, Binary_Value_Descr(index)->Object_Description);
   }
 
   return status;
@@ -349,288 +593,13 @@ bool Binary_Value_Description(
 
 
 /* return apdu len, or -1 on error */
-int Binary_Value_Read_Property(
-    BACNET_READ_PROPERTY_DATA * rpdata)
-{
-    int len = 0;
-    int apdu_len = 0;   /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    BACNET_BINARY_PV present_value = BINARY_INACTIVE;
-    BACNET_POLARITY polarity = POLARITY_NORMAL;
-    unsigned object_index = 0;
-    unsigned i = 0;
-
-    uint8_t *apdu = NULL;
-
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
-        return 0;
-    }
-		
-		object_index = Binary_Value_Instance_To_Index(rpdata->object_instance);
-				
-		if(BV_Descr[object_index].read_callback)
-		{
-		  uint8_t id = bacQueue.call(BV_Descr[object_index].read_callback, (uint32_t)rpdata->object_property);
-		  
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_BV_RDCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_BV_RDCB_FAILED, id, 0); }
-		}
-		
-    apdu = rpdata->application_data;
-    switch (rpdata->object_property) {
-        case PROP_OBJECT_IDENTIFIER:
-            apdu_len =
-                encode_application_object_id(&apdu[0], OBJECT_BINARY_VALUE,
-                rpdata->object_instance);
-            break;
-            /* note: Name and Description don't have to be the same.
-               You could make Description writable and different */
-        case PROP_OBJECT_NAME:
-            Binary_Value_Object_Name(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_DESCRIPTION:
-            Binary_Value_Description(rpdata->object_instance, &char_string);
-            apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
-            break;
-        case PROP_OBJECT_TYPE:
-            apdu_len =
-                encode_application_enumerated(&apdu[0], OBJECT_BINARY_VALUE);
-            break;
-        case PROP_PRESENT_VALUE:
-            present_value =
-                Binary_Value_Present_Value(rpdata->object_instance);
-            apdu_len = encode_application_enumerated(&apdu[0], present_value);
-            break;
-        case PROP_STATUS_FLAGS:
-            /* note: see the details in the standard on how to use these */
-            bitstring_init(&bit_string);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE, false);
-            apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-            break;
-        case PROP_EVENT_STATE:
-            /* note: see the details in the standard on how to use this */
-            apdu_len =
-                encode_application_enumerated(&apdu[0], EVENT_STATE_NORMAL);
-            break;
-        case PROP_OUT_OF_SERVICE:
-            apdu_len = encode_application_boolean(&apdu[0], Binary_Value_Out_Of_Service(rpdata->object_instance));
-            break;
-				case PROP_PRIORITY_ARRAY:
-            /* Array element zero is the number of elements in the array */
-            if (rpdata->array_index == 0)
-                apdu_len =
-                    encode_application_unsigned(&apdu[0], BACNET_MAX_PRIORITY);
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            else if (rpdata->array_index == BACNET_ARRAY_ALL) {
-                object_index =
-                    Binary_Value_Instance_To_Index(rpdata->object_instance);
-                for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
-                    /* FIXME: check if we have room before adding it to APDU */
-                    present_value = (BACNET_BINARY_PV) BV_Descr[object_index].Present_Value[i];
-                    if (present_value == BINARY_NULL) {
-                        len = encode_application_null(&apdu[apdu_len]);
-                    } else {
-                        len =
-                            encode_application_enumerated(&apdu[apdu_len],
-                            present_value);
-                    }
-                    /* add it if we have room */
-                    if ((apdu_len + len) < MAX_APDU)
-                        apdu_len += len;
-                    else {
-                        rpdata->error_class = ERROR_CLASS_SERVICES;
-                        rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                        apdu_len = BACNET_STATUS_ERROR;
-                        break;
-                    }
-                }
-            } else {
-                object_index =
-                    Binary_Value_Instance_To_Index(rpdata->object_instance);
-                if (rpdata->array_index <= BACNET_MAX_PRIORITY) {
-                    present_value = (BACNET_BINARY_PV)
-                        BV_Descr[object_index].Present_Value[rpdata->array_index -
-                        1];
-                    if (present_value == BINARY_NULL) {
-                        apdu_len = encode_application_null(&apdu[apdu_len]);
-                    } else {
-                        apdu_len =
-                            encode_application_enumerated(&apdu[apdu_len],
-                            present_value);
-                    }
-                } else {
-                    rpdata->error_class = ERROR_CLASS_PROPERTY;
-                    rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                    apdu_len = BACNET_STATUS_ERROR;
-                }
-            }
-            break;
-        case PROP_RELINQUISH_DEFAULT:
-            present_value = RELINQUISH_DEFAULT;
-            apdu_len = encode_application_enumerated(&apdu[0], present_value);
-            break;
-        case PROP_POLARITY:
-            polarity = Binary_Value_Polarity(rpdata->object_instance);
-            apdu_len = encode_application_enumerated(&apdu[0], polarity);
-            break;
-        default:
-            rpdata->error_class = ERROR_CLASS_PROPERTY;
-            rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            apdu_len = BACNET_STATUS_ERROR;
-            break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->array_index != BACNET_ARRAY_ALL)) {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+int Binary_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return object_read_property(&Binary_Value_Class, rpdata);
 }
 
 /* returns true if successful */
-bool Binary_Value_Write_Property(
-    BACNET_WRITE_PROPERTY_DATA * wp_data)
+bool Binary_Value_Write_Property(BACNET_WRITE_PROPERTY_DATA *wp_data)
 {
-    bool status = false;        /* return value */
-    unsigned int object_index = 0;
-    unsigned int priority = 0;
-    BACNET_BINARY_PV level = BINARY_NULL;
-    int len = 0;
-    BACNET_APPLICATION_DATA_VALUE value;
-
-    if (!Binary_Value_Valid_Instance(wp_data->object_instance)) {
-        wp_data->error_class = ERROR_CLASS_OBJECT;
-        wp_data->error_code = ERROR_CODE_UNKNOWN_OBJECT;
-        return false;
-    }
-    /* decode the some of the request */
-    len =
-        bacapp_decode_application_data(wp_data->application_data,
-        wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0) {
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-        return false;
-    }
-    if ((wp_data->object_property != PROP_PRIORITY_ARRAY) &&
-        (wp_data->array_index != BACNET_ARRAY_ALL)) {
-        /*  only array properties can have array options */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        return false;
-    }
-		
-		object_index = Binary_Value_Instance_To_Index(wp_data->object_instance);
-		
-    switch (wp_data->object_property) {
-        case PROP_PRESENT_VALUE:
-						priority = wp_data->priority;
-            status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_ENUMERATED, &wp_data->error_class, &wp_data->error_code);
-            if (status) {
-              if(BV_Descr[object_index].PV_WriteProtected)
-              {
-                status = false;
-                wp_data->error_class = ERROR_CLASS_PROPERTY;
-                wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-              }
-              else
-              {
-                /* Command priority 6 is reserved for use by Minimum On/Off
-                   algorithm and may not be used for other purposes in any
-                   object. */
-                if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-                    (priority != 6 /* reserved */ ) &&
-                    (value.type.Enumerated <= MAX_BINARY_PV)) {
-                    level = (BACNET_BINARY_PV) value.type.Enumerated;
-                    status = Binary_Value_Present_Value_Set(wp_data->object_instance, level, priority);
-                } else if (priority == 6) {
-                    /* Command priority 6 is reserved for use by Minimum On/Off
-                       algorithm and may not be used for other purposes in any
-                       object. */
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                } else {
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-                }
-              }
-            } else {
-                status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_NULL, &wp_data->error_class, &wp_data->error_code);
-                if (status) {
-                    level = BINARY_NULL;
-                    if (priority && (priority <= BACNET_MAX_PRIORITY)) {
-                        status = Binary_Value_Present_Value_Set(wp_data->object_instance, level, priority);
-                    } else if (priority == 6) {
-                        status = false;
-                        /* Command priority 6 is reserved for use by Minimum On/Off
-                           algorithm and may not be used for other purposes in any
-                           object. */
-                        wp_data->error_class = ERROR_CLASS_PROPERTY;
-                        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                    } else {
-                        status = false;
-                        wp_data->error_class = ERROR_CLASS_PROPERTY;
-                        wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
-                    }
-                }
-            }
-            break;
-        case PROP_OUT_OF_SERVICE:
-#if 1
-            if (value.tag == BACNET_APPLICATION_TAG_BOOLEAN) {
-                object_index =
-                    Binary_Value_Instance_To_Index(wp_data->object_instance);
-                BV_Descr[object_index].Out_Of_Service = value.type.Boolean;
-                status = true;
-            } else {
-                wp_data->error_class = ERROR_CLASS_PROPERTY;
-                wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
-            }
-            break;
-#endif
-        case PROP_OBJECT_IDENTIFIER:
-        case PROP_OBJECT_NAME:
-        case PROP_DESCRIPTION:
-        case PROP_OBJECT_TYPE:
-        case PROP_STATUS_FLAGS:
-        case PROP_EVENT_STATE:
-        case PROP_PRIORITY_ARRAY:
-        case PROP_RELINQUISH_DEFAULT:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-            break;
-        default:
-            wp_data->error_class = ERROR_CLASS_PROPERTY;
-            wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-            break;
-    }
-				
-		if(BV_Descr[object_index].write_callback)
-		{
-		  uint8_t id = bacQueue.call(BV_Descr[object_index].write_callback, (uint32_t)wp_data->object_property);
-		  
-		  if(id > 0)
-		  { EVRECORD2(BACNET_EVQ_BV_WRCB_CALLED, id, 0); }
-		  else
-		  { EVRECORD2(BACNET_EVQ_BV_WRCB_FAILED, id, 0); }
-		}
-		
-    return status;
+    return object_write_property(&Binary_Value_Class, wp_data);
 }
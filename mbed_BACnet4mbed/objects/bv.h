@@ -47,6 +47,10 @@ extern "C" {
 		bv_callback write_callback;
 		unsigned Event_State:3;
 		uint8_t Present_Value[16];
+		/* see objcommand.h */
+		uint16_t Priority_Active;
+		uint8_t Relinquish_Default;
+		uint8_t Effective_Value;
 		BACNET_RELIABILITY Reliability;
 		bool Out_Of_Service;
 		bool Changed;
@@ -105,6 +109,9 @@ extern "C" {
         uint32_t object_instance,
         BACNET_BINARY_PV value,
 		    unsigned priority);
+    bool Binary_Value_Present_Value_Relinquish(
+        uint32_t object_instance,
+        unsigned priority);
 
     bool Binary_Value_Out_Of_Service(
         uint32_t object_instance);
@@ -37,6 +37,9 @@
 //#include "rs485.h"
 #include "version_bacnet.h"
 #include "handlers.h"
+#include "objname.h"
+#include "objpool.h"
+#include "revstore.h"
 /* objects */
 #include "device_obj.h"
 #include "bo.h"
@@ -46,6 +49,7 @@
 #include "ai.h"
 #include "av.h"
 #include "msv.h"
+#include "objengine.h"
 #include "mbed.h"
 
 #include "valid_ip4.h"
@@ -53,6 +57,8 @@
 #include "EvRec_BACnet4mbed.h"
 
 extern DEVICE_OBJECT_DESCR Device_Descr;
+/* object name hash to object identifier, built by Device_Init() */
+static OBJECT_NAME_INDEX Object_Name_Index;
 extern EventQueue bacQueue;
 
 /* forward prototype */
@@ -61,23 +67,7 @@ int Device_Read_Property_Local(
 bool Device_Write_Property_Local(
     BACNET_WRITE_PROPERTY_DATA * wp_data);
 
-static struct my_object_functions {
-    BACNET_OBJECT_TYPE Object_Type;
-    object_init_function Object_Init;
-    object_count_function Object_Count;
-    object_index_to_instance_function Object_Index_To_Instance;
-    object_valid_instance_function Object_Valid_Instance;
-    object_name_function Object_Name;
-    read_property_function Object_Read_Property;
-    write_property_function Object_Write_Property;
-    rpm_property_lists_function Object_RPM_List;
-    rr_info_function Object_RR_Info;
-    object_iterate_function Object_Iterator;
-    object_value_list_function Object_Value_List;
-    object_cov_function Object_COV;
-    object_cov_clear_function Object_COV_Clear;
-    object_intrinsic_reporting_function Object_Intrinsic_Reporting;
-} Object_Table[] = {
+static object_functions_t Object_Table[] = {
     {OBJECT_DEVICE,
 				NULL,    /* don't init - recursive! */
 				Device_Count,
@@ -92,6 +82,8 @@ static struct my_object_functions {
 				NULL, 
 				NULL, 
 				NULL, 
+				NULL,
+				NULL,
 				NULL}, 
 		{OBJECT_BINARY_OUTPUT, 
 				Binary_Output_Init, 
@@ -104,9 +96,11 @@ static struct my_object_functions {
 				Binary_Output_Property_Lists,
 				NULL, 
 				NULL, 
-				NULL, 
-				NULL, 
-				NULL, 
+				Binary_Output_Encode_Value_List,
+				Binary_Output_Change_Of_Value,
+				Binary_Output_Change_Of_Value_Clear,
+				NULL,
+				NULL,
 				NULL}, 
 		{OBJECT_BINARY_INPUT, 
 				Binary_Input_Init, 
@@ -122,7 +116,9 @@ static struct my_object_functions {
 				Binary_Input_Encode_Value_List,
 				Binary_Input_Change_Of_Value,
 				Binary_Input_Change_Of_Value_Clear,
-				NULL /* Intrinsic Reporting */ },	
+				NULL /* Intrinsic Reporting */,
+				NULL,
+				NULL},	
 		{OBJECT_BINARY_VALUE, 
 				Binary_Value_Init, 
 				Binary_Value_Count,
@@ -137,7 +133,9 @@ static struct my_object_functions {
 				Binary_Value_Encode_Value_List, 
 				Binary_Value_Change_Of_Value, 
 				Binary_Value_Change_Of_Value_Clear, 
-				NULL},
+				NULL,
+				Binary_Value_Create,
+				Binary_Value_Delete},
 		{OBJECT_ANALOG_OUTPUT,
 				Analog_Output_Init, 
 				Analog_Output_Count,
@@ -149,9 +147,11 @@ static struct my_object_functions {
 				Analog_Output_Property_Lists,
 				NULL, 
 				NULL, 
+				Analog_Output_Encode_Value_List,
+				Analog_Output_Change_Of_Value,
+				Analog_Output_Change_Of_Value_Clear,
 				NULL,
 				NULL,
-				NULL, 
 				NULL},		
 		{OBJECT_ANALOG_INPUT,
 				Analog_Input_Init, 
@@ -167,7 +167,9 @@ static struct my_object_functions {
 				Analog_Input_Encode_Value_List,
 				Analog_Input_Change_Of_Value,
 				Analog_Input_Change_Of_Value_Clear,
-				NULL},
+				NULL,
+				Analog_Input_Create,
+				Analog_Input_Delete},
 		{OBJECT_ANALOG_VALUE,
 				Analog_Value_Init,
 				Analog_Value_Count,
@@ -182,7 +184,9 @@ static struct my_object_functions {
 				Analog_Value_Encode_Value_List,
 				Analog_Value_Change_Of_Value,
 				Analog_Value_Change_Of_Value_Clear, 
-				NULL},
+				NULL,
+				Analog_Value_Create,
+				Analog_Value_Delete},
 		{OBJECT_MULTI_STATE_VALUE, 
 				Multistate_Value_Init, 
 				Multistate_Value_Count,
@@ -197,6 +201,8 @@ static struct my_object_functions {
 				Multistate_Value_Encode_Value_List,
 				Multistate_Value_Change_Of_Value,
 				Multistate_Value_Change_Of_Value_Clear,
+				NULL,
+				NULL,
 				NULL},
 		{MAX_BACNET_OBJECT_TYPE,
 				NULL /* Init */ ,
@@ -212,14 +218,42 @@ static struct my_object_functions {
 				NULL /* Value_Lists */ ,
 				NULL /* COV */ ,
 				NULL /* COV Clear */ ,
-        NULL /* Intrinsic Reporting */ }
+        NULL /* Intrinsic Reporting */,
+				NULL /* Create */ ,
+				NULL /* Delete */ }
 };
 
+/* the object types of the device in object list order, Object_Table[]
+   followed by the types registered at runtime */
+static object_functions_t *Object_Types[(sizeof(Object_Table) /
+        sizeof(Object_Table[0])) - 1 + MAX_REGISTERED_OBJECT_TYPES];
+static unsigned Object_Type_Count;
+/* set once Device_Init() has initialized the objects */
+static bool Device_Initialized;
+/* the functions of an object type by BACNET_OBJECT_TYPE, NULL if the
+   type is not supported; proprietary types are looked up in the list */
+static object_functions_t *Object_Type_Functions[MAX_ASHRAE_OBJECT_TYPE];
+
 /* note: you really only need to define variables for
    properties that are writable or that may change.
    The properties that are constant can be hard coded
    into the read-property encoding. */
 static uint32_t Database_Revision;
+/* The revisions are stored ahead of use: the stored revision is the
+   first one the device may use after a restart, and it is moved on
+   DATABASE_REVISION_STORE_STEP revisions at a time before a revision
+   beyond it is used, so not every change writes to the flash. */
+#ifndef DATABASE_REVISION_STORE_STEP
+#define DATABASE_REVISION_STORE_STEP 16
+#endif
+#if (DATABASE_REVISION_STORE_STEP < 1)
+#error "DATABASE_REVISION_STORE_STEP must be 1 or more"
+#endif
+static uint32_t Database_Revision_Stored;
+/* the object list and name changes behind Database_Revision */
+static OBJECT_JOURNAL Object_Journal;
+/* number of objects in the object list */
+static unsigned Object_List_Count;
 static BACNET_REINITIALIZED_STATE Reinitialize_State = BACNET_REINIT_IDLE;
 
 /* These three arrays are used by the ReadPropertyMultiple handler */
@@ -259,29 +293,31 @@ static const int Device_Properties_Proprietary[] = {
 		PROP_GATEWAY_NMASK,		// DiestelGateway Netmask
 		PROP_GATEWAY_GW,			// DiestelGateway Gateway
 		PROP_GATEWAY_DHCP,		// DiestelGateway DHCP setting
+		PROP_OBJECT_CHANGES_BASE,
+		PROP_OBJECT_CHANGES,
     -1
 };
 
-static struct my_object_functions *Device_Objects_Find_Functions(
+static object_functions_t *Device_Objects_Find_Functions(
     BACNET_OBJECT_TYPE Object_Type)
 {
-    struct my_object_functions *pObject = NULL;
+    unsigned i = 0;
 
-    pObject = &Object_Table[0];
-    while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
-        /* handle each object type */
-        if (pObject->Object_Type == Object_Type) {
-            return (pObject);
+    if ((unsigned) Object_Type < MAX_ASHRAE_OBJECT_TYPE) {
+        return Object_Type_Functions[Object_Type];
+    }
+    /* proprietary object types are not in the dispatch table */
+    for (i = 0; i < Object_Type_Count; i++) {
+        if (Object_Types[i]->Object_Type == Object_Type) {
+            return Object_Types[i];
         }
-
-        pObject++;
     }
 
     return (NULL);
 }
 
 static int Read_Property_Common(
-    struct my_object_functions *pObject,
+    object_functions_t *pObject,
     BACNET_READ_PROPERTY_DATA * rpdata)
 {
     int apdu_len = BACNET_STATUS_ERROR;
@@ -356,7 +392,7 @@ int Device_Read_Property(
     BACNET_READ_PROPERTY_DATA * rpdata)
 {
     int apdu_len = BACNET_STATUS_ERROR;
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     /* initialize the default return values */
     pObject = Device_Objects_Find_Functions(rpdata->object_type);
@@ -380,7 +416,7 @@ bool Device_Write_Property(
     BACNET_WRITE_PROPERTY_DATA * wp_data)
 {
     bool status = false;
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     /* initialize the default return values */
     pObject = Device_Objects_Find_Functions(wp_data->object_type);
@@ -389,6 +425,11 @@ bool Device_Write_Property(
             pObject->Object_Valid_Instance(wp_data->object_instance)) {
             if (pObject->Object_Write_Property) {
                 status = pObject->Object_Write_Property(wp_data);
+                if (status) {
+                    /* properties monitored by SubscribeCOVProperty */
+                    handler_cov_object_written(wp_data->object_type,
+                        wp_data->object_instance);
+                }
             } else {
                 wp_data->error_class = ERROR_CLASS_PROPERTY;
                 wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
@@ -414,7 +455,7 @@ bool Device_Value_List_Supported(
     BACNET_OBJECT_TYPE object_type)
 {
     bool status = false;
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     pObject = Device_Objects_Find_Functions(object_type);
     if (pObject != NULL) {
@@ -440,7 +481,7 @@ bool Device_Encode_Value_List(
     BACNET_PROPERTY_VALUE * value_list)
 {
     bool status = false;        /* Ever the pessamist! */
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     pObject = Device_Objects_Find_Functions(object_type);
     if (pObject != NULL) {
@@ -467,7 +508,7 @@ bool Device_COV(
 	uint32_t object_instance)
 {
 	bool status = false;
-	struct my_object_functions *pObject = NULL;
+	object_functions_t *pObject = NULL;
 
 	pObject = Device_Objects_Find_Functions(object_type);
 	if (pObject != NULL) {
@@ -491,7 +532,7 @@ void Device_COV_Clear(
 	BACNET_OBJECT_TYPE object_type,
 	uint32_t object_instance)
 {
-	struct my_object_functions *pObject = NULL;
+	object_functions_t *pObject = NULL;
 
 	pObject = Device_Objects_Find_Functions(object_type);
 	if (pObject != NULL) {
@@ -524,7 +565,7 @@ void Device_Objects_Property_List(
     BACNET_OBJECT_TYPE object_type,
     struct special_property_list_t *pPropertyList)
 {
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     pPropertyList->Required.pList = NULL;
     pPropertyList->Optional.pList = NULL;
@@ -592,8 +633,13 @@ bool Device_Set_Object_Instance_Number(
 
     if (object_id <= BACNET_MAX_INSTANCE) {
         /* Make the change and update the database revision */
+        Device_Object_Name_Index_Remove(OBJECT_DEVICE,
+            Device_Descr.object_instance);
+        Device_Object_Changed(OBJECT_CHANGE_REMOVED, OBJECT_DEVICE,
+            Device_Descr.object_instance);
         Device_Descr.object_instance = object_id;
-        Device_Inc_Database_Revision();
+        Device_Object_Name_Index_Add(OBJECT_DEVICE, object_id);
+        Device_Object_Changed(OBJECT_CHANGE_ADDED, OBJECT_DEVICE, object_id);
     } else
         status = false;
 
@@ -620,8 +666,13 @@ bool Device_Set_Object_Name(
 
     if (!characterstring_ansi_same(object_name, Device_Descr.object_name)) {
         /* Make the change and update the database revision */
+        Device_Object_Name_Index_Remove(OBJECT_DEVICE,
+            Device_Descr.object_instance);
         status = characterstring_ansi_copy(Device_Descr.object_name, MAX_DEV_NAME_LEN, object_name);
-        Device_Inc_Database_Revision();
+        Device_Object_Name_Index_Add(OBJECT_DEVICE,
+            Device_Descr.object_instance);
+        Device_Object_Changed(OBJECT_CHANGE_RENAMED, OBJECT_DEVICE,
+            Device_Descr.object_instance);
     }
 
     return status;
@@ -655,22 +706,181 @@ BACNET_REINITIALIZED_STATE Device_Reinitialized_State(
     return Reinitialize_State;
 }
 
-void Device_Init(
-    object_functions_t * object_table)
+/* hash of the current name of an object, false if it has no name */
+static bool Device_Object_Name_Hash(
+    int object_type,
+    uint32_t object_instance,
+    uint32_t * hash)
+{
+    object_functions_t *pObject = NULL;
+    BACNET_CHARACTER_STRING object_name;
+
+    pObject = Device_Objects_Find_Functions((BACNET_OBJECT_TYPE) object_type);
+    if ((pObject == NULL) || (pObject->Object_Name == NULL) ||
+        !pObject->Object_Name(object_instance, &object_name)) {
+        return false;
+    }
+    *hash =
+        object_name_hash(characterstring_value(&object_name),
+        characterstring_length(&object_name));
+
+    return true;
+}
+
+/** Adds the current name of an object to the name index.
+ * Called once an object exists or after its name has been changed.
+ * @param object_type [in] The object type.
+ * @param object_instance [in] The object instance.
+ */
+void Device_Object_Name_Index_Add(
+    int object_type,
+    uint32_t object_instance)
+{
+    uint32_t hash = 0;
+
+    if (Device_Object_Name_Hash(object_type, object_instance, &hash)) {
+        object_name_index_add(&Object_Name_Index, hash, object_type,
+            object_instance);
+    }
+}
+
+/** Removes the current name of an object from the name index.
+ * Called before an object is deleted or its name is changed.
+ * @param object_type [in] The object type.
+ * @param object_instance [in] The object instance.
+ */
+void Device_Object_Name_Index_Remove(
+    int object_type,
+    uint32_t object_instance)
 {
-    struct my_object_functions *pObject = NULL;
+    uint32_t hash = 0;
+
+    if (Device_Object_Name_Hash(object_type, object_instance, &hash)) {
+        object_name_index_remove(&Object_Name_Index, hash, object_type,
+            object_instance);
+    }
+}
 
-    /* we don't use the object table passed in
-       since there is extra stuff we don't need in there. */
-    (void) object_table;
-    /* our local object table */
+/* indexes the names of all objects, with room for the objects that
+   can still be created at runtime */
+static void Device_Object_Name_Index_Build(
+    void)
+{
+    object_functions_t *pObject = NULL;
+    unsigned capacity = Object_List_Count;
+    unsigned i = 0;
+    int type = 0;
+    uint32_t instance = 0;
+
+    for (i = 0; i < Object_Type_Count; i++) {
+        pObject = Object_Types[i];
+        if (pObject->Object_Create) {
+            capacity += MAX_CREATED_OBJECTS;
+        }
+    }
+    if (!object_name_index_init(&Object_Name_Index, capacity)) {
+        return;
+    }
+    for (i = 1; i <= Object_List_Count; i++) {
+        if (Device_Object_List_Identifier(i, &type, &instance)) {
+            Device_Object_Name_Index_Add(type, instance);
+        }
+    }
+}
+
+/* fills the dispatch table with the types of Object_Table[], once */
+static void Device_Object_Types_Init(
+    void)
+{
+    object_functions_t *pObject = NULL;
+
+    if (Object_Type_Count) {
+        return;
+    }
     pObject = &Object_Table[0];
     while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
+        Object_Types[Object_Type_Count++] = pObject;
+        if ((unsigned) pObject->Object_Type < MAX_ASHRAE_OBJECT_TYPE) {
+            Object_Type_Functions[pObject->Object_Type] = pObject;
+        }
+        pObject++;
+    }
+}
+
+/** Adds an object type to the device, or replaces the functions of a
+ * type the device already has.
+ * The functions are not copied, they must stay valid. Once the device
+ * is initialized, the objects of the type are initialized and added to
+ * the object list right away.
+ * @param functions [in] The functions of the object type.
+ * @return true if registered, false if MAX_REGISTERED_OBJECT_TYPES
+ *         types have been added already.
+ */
+bool Device_Object_Type_Register(
+    object_functions_t * functions)
+{
+    object_functions_t *pObject = NULL;
+    unsigned i = 0;
+
+    if (!functions || (functions->Object_Type >= MAX_BACNET_OBJECT_TYPE)) {
+        return false;
+    }
+    Device_Object_Types_Init();
+    pObject = Device_Objects_Find_Functions(functions->Object_Type);
+    if (pObject) {
+        while (Object_Types[i] != pObject) {
+            i++;
+        }
+    } else if (Object_Type_Count <
+        (sizeof(Object_Types) / sizeof(Object_Types[0]))) {
+        i = Object_Type_Count++;
+    } else {
+        return false;
+    }
+    Object_Types[i] = functions;
+    if ((unsigned) functions->Object_Type < MAX_ASHRAE_OBJECT_TYPE) {
+        Object_Type_Functions[functions->Object_Type] = functions;
+    }
+    if (Device_Initialized) {
+        if (functions->Object_Init) {
+            functions->Object_Init();
+        }
+        Device_Object_List_Changed();
+        Device_Object_Name_Index_Build();
+        Device_Inc_Database_Revision();
+        /* the objects of the type are not journaled one by one, so
+           clients with an older revision have to read them all */
+        object_journal_init(&Object_Journal, Database_Revision);
+    }
+
+    return true;
+}
+
+void Device_Init(
+    object_functions_t * object_table)
+{
+    object_functions_t *pObject = NULL;
+    unsigned i = 0;
+
+    /* go on from the revisions used before the restart */
+    if (revision_store_load(&Database_Revision_Stored))
+        Database_Revision = Database_Revision_Stored;
+    Database_Revision_Stored = Database_Revision;
+    /* our local object table, then the extra object types passed in */
+    Device_Object_Types_Init();
+    if (object_table) {
+        for (i = 0; object_table[i].Object_Type < MAX_BACNET_OBJECT_TYPE;
+            i++) {
+            Device_Object_Type_Register(&object_table[i]);
+        }
+    }
+    for (i = 0; i < Object_Type_Count; i++) {
+        pObject = Object_Types[i];
         if (pObject->Object_Init) {
             pObject->Object_Init();
         }
-        pObject++;
     }
+    Device_Object_List_Changed();
     dcc_set_status_duration(COMMUNICATION_ENABLE, 0);
 		
     if (Device_Descr.object_instance >= BACNET_MAX_INSTANCE) {
@@ -685,6 +895,9 @@ void Device_Init(
 		Device_Set_Location(BACNET_LOCATION);
 		Device_Set_Application_Software_Version(BACNET_APPLICATION_VER);
 		Device_Set_System_Status(STATUS_OPERATIONAL, false);
+		Device_Object_Name_Index_Build();
+		object_journal_init(&Object_Journal, Database_Revision);
+		Device_Initialized = true;
 }
 
 /* methods to manipulate the data */
@@ -748,27 +961,60 @@ uint32_t Device_Database_Revision(
 void Device_Inc_Database_Revision(
     void)
 {
-    Database_Revision++;
+    uint32_t revision = Database_Revision + 1;
+
+    if ((revision >= Database_Revision_Stored) &&
+        revision_store_save(revision + DATABASE_REVISION_STORE_STEP))
+        Database_Revision_Stored = revision + DATABASE_REVISION_STORE_STEP;
+    Database_Revision = revision;
+}
+
+/** Records that an object was added, removed or renamed.
+ * The Database_Revision is incremented and the change is journaled, so
+ * clients can read what changed since the revision they cached, see
+ * PROP_OBJECT_CHANGES. The object list is counted again for added and
+ * removed objects.
+ * @param change [in] What happened to the object.
+ * @param object_type [in] The object type.
+ * @param object_instance [in] The object instance.
+ */
+void Device_Object_Changed(
+    OBJECT_CHANGE change,
+    int object_type,
+    uint32_t object_instance)
+{
+    if (change != OBJECT_CHANGE_RENAMED) {
+        Device_Object_List_Changed();
+    }
+    Device_Inc_Database_Revision();
+    object_journal_add(&Object_Journal, Database_Revision, change,
+        object_type, object_instance);
 }
 
 /* Since many network clients depend on the object list */
 /* for discovery, it must be consistent! */
 unsigned Device_Object_List_Count(
     void)
+{
+    return Object_List_Count;
+}
+
+/* The object modules keep their own count, this sums them up again
+   after objects have been initialized, created or deleted. */
+void Device_Object_List_Changed(
+    void)
 {
     unsigned count = 0; /* number of objects */
-    struct my_object_functions *pObject = NULL;
+    unsigned i = 0;
+    object_functions_t *pObject = NULL;
 
-    /* initialize the default return values */
-    pObject = &Object_Table[0];
-    while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
+    for (i = 0; i < Object_Type_Count; i++) {
+        pObject = Object_Types[i];
         if (pObject->Object_Count) {
             count += pObject->Object_Count();
         }
-        pObject++;
     }
-
-    return count;
+    Object_List_Count = count;
 }
 
 bool Device_Object_List_Identifier(
@@ -779,7 +1025,8 @@ bool Device_Object_List_Identifier(
     bool status = false;
     unsigned count = 0;
     unsigned object_index = 0;
-    struct my_object_functions *pObject = NULL;
+    unsigned i = 0;
+    object_functions_t *pObject = NULL;
 
     /* array index zero is length - so invalid */
     if (array_index == 0) {
@@ -787,8 +1034,8 @@ bool Device_Object_List_Identifier(
     }
     object_index = array_index - 1;
     /* initialize the default return values */
-    pObject = &Object_Table[0];
-    while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
+    for (i = 0; i < Object_Type_Count; i++) {
+        pObject = Object_Types[i];
         if (pObject->Object_Count && pObject->Object_Index_To_Instance) {
             object_index -= count;
             count = pObject->Object_Count();
@@ -799,7 +1046,6 @@ bool Device_Object_List_Identifier(
                 break;
             }
         }
-        pObject++;
     }
 
     return status;
@@ -814,28 +1060,51 @@ bool Device_Valid_Object_Name(
     int type = 0;
     uint32_t instance;
     unsigned max_objects = 0, i = 0;
+    unsigned cursor = 0;
+    uint32_t hash = 0;
     bool check_id = false;
     BACNET_CHARACTER_STRING object_name2;
-    struct my_object_functions *pObject = NULL;
-
-    max_objects = Device_Object_List_Count();
-    for (i = 1; i <= max_objects; i++) {
-        check_id = Device_Object_List_Identifier(i, &type, &instance);
-        if (check_id) {
+    object_functions_t *pObject = NULL;
+
+    if (Object_Name_Index.slots && !Object_Name_Index.incomplete) {
+        /* only the objects with the same name hash are compared */
+        hash =
+            object_name_hash(characterstring_value(object_name1),
+            characterstring_length(object_name1));
+        while (object_name_index_next(&Object_Name_Index, hash, &cursor,
+                &type, &instance)) {
             pObject = Device_Objects_Find_Functions((BACNET_OBJECT_TYPE) type);
             if ((pObject != NULL) && (pObject->Object_Name != NULL) &&
                 (pObject->Object_Name(instance, &object_name2) &&
                     characterstring_same(object_name1, &object_name2))) {
                 found = true;
-                if (object_type) {
-                    *object_type = type;
-                }
-                if (object_instance) {
-                    *object_instance = instance;
-                }
                 break;
             }
         }
+    } else {
+        /* before Device_Init() or out of memory: compare all names */
+        max_objects = Device_Object_List_Count();
+        for (i = 1; i <= max_objects; i++) {
+            check_id = Device_Object_List_Identifier(i, &type, &instance);
+            if (check_id) {
+                pObject =
+                    Device_Objects_Find_Functions((BACNET_OBJECT_TYPE) type);
+                if ((pObject != NULL) && (pObject->Object_Name != NULL) &&
+                    (pObject->Object_Name(instance, &object_name2) &&
+                        characterstring_same(object_name1, &object_name2))) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+    if (found) {
+        if (object_type) {
+            *object_type = type;
+        }
+        if (object_instance) {
+            *object_instance = instance;
+        }
     }
 
     return found;
@@ -846,7 +1115,7 @@ bool Device_Valid_Object_Id(
     uint32_t object_instance)
 {
     bool status = false;        /* return value */
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     pObject = Device_Objects_Find_Functions((BACNET_OBJECT_TYPE) object_type);
     if ((pObject != NULL) && (pObject->Object_Valid_Instance != NULL)) {
@@ -856,12 +1125,123 @@ bool Device_Valid_Object_Id(
     return status;
 }
 
+/** Creates an object as requested by a CreateObject service request.
+ * The new object is initialized with its defaults and then each of the
+ * initial values is written to it; if any of them fails, the object is
+ * deleted again and the failing element is reported.
+ * @ingroup OMCO
+ * @param data [in,out] The decoded request; on success the instance of the
+ *                      new object, otherwise the error and failed element.
+ * @return True if the object was created.
+ */
+bool Device_Create_Object(
+    BACNET_CREATE_OBJECT_DATA * data)
+{
+    object_functions_t *pObject = NULL;
+    BACNET_WRITE_PROPERTY_DATA wp_data;
+    uint8_t *apdu = NULL;
+    unsigned apdu_len = 0;
+    uint32_t instance = 0;
+    uint32_t element = 0;
+    int len = 0;
+
+    pObject = Device_Objects_Find_Functions(data->object_type);
+    if (!pObject) {
+        data->error_class = ERROR_CLASS_OBJECT;
+        data->error_code = ERROR_CODE_UNSUPPORTED_OBJECT_TYPE;
+        return false;
+    }
+    if (!pObject->Object_Create) {
+        data->error_class = ERROR_CLASS_OBJECT;
+        data->error_code = ERROR_CODE_DYNAMIC_CREATION_NOT_SUPPORTED;
+        return false;
+    }
+    instance = data->object_instance;
+    if (instance == CREATE_OBJECT_ANY_INSTANCE) {
+        /* the lowest free instance */
+        for (instance = 0; instance < BACNET_MAX_INSTANCE; instance++) {
+            if (!pObject->Object_Valid_Instance(instance))
+                break;
+        }
+    } else if (pObject->Object_Valid_Instance(instance)) {
+        data->error_class = ERROR_CLASS_OBJECT;
+        data->error_code = ERROR_CODE_OBJECT_IDENTIFIER_ALREADY_EXISTS;
+        return false;
+    }
+    if ((instance >= BACNET_MAX_INSTANCE) || !pObject->Object_Create(instance)) {
+        data->error_class = ERROR_CLASS_RESOURCES;
+        data->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
+        return false;
+    }
+    wp_data.object_type = data->object_type;
+    wp_data.object_instance = instance;
+    apdu = data->initial_values;
+    apdu_len = data->initial_values_len;
+    while (apdu_len) {
+        element++;
+        len = create_object_decode_initial_value(apdu, apdu_len, &wp_data);
+        if (len <= 0) {
+            wp_data.error_class = ERROR_CLASS_SERVICES;
+            wp_data.error_code = ERROR_CODE_INVALID_TAG;
+        } else if (pObject->Object_Write_Property) {
+            if (pObject->Object_Write_Property(&wp_data)) {
+                apdu += len;
+                apdu_len -= len;
+                continue;
+            }
+        } else {
+            wp_data.error_class = ERROR_CLASS_PROPERTY;
+            wp_data.error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        }
+        /* the object is created with all of its initial values or not at all */
+        data->error_class = wp_data.error_class;
+        data->error_code = wp_data.error_code;
+        data->first_failed_element = element;
+        pObject->Object_Delete(instance);
+        return false;
+    }
+    data->object_instance = instance;
+
+    return true;
+}
+
+/** Deletes an object as requested by a DeleteObject service request.
+ * Only objects of a type that supports it and that were created at
+ * runtime can be deleted.
+ * @ingroup OMDO
+ * @param data [in,out] The decoded request; the error if it fails.
+ * @return True if the object was deleted.
+ */
+bool Device_Delete_Object(
+    BACNET_DELETE_OBJECT_DATA * data)
+{
+    object_functions_t *pObject = NULL;
+
+    pObject = Device_Objects_Find_Functions(data->object_type);
+    if (!pObject || !pObject->Object_Valid_Instance ||
+        !pObject->Object_Valid_Instance(data->object_instance)) {
+        data->error_class = ERROR_CLASS_OBJECT;
+        data->error_code = ERROR_CODE_UNKNOWN_OBJECT;
+        return false;
+    }
+    if (!pObject->Object_Delete ||
+        !pObject->Object_Delete(data->object_instance)) {
+        data->error_class = ERROR_CLASS_OBJECT;
+        data->error_code = ERROR_CODE_OBJECT_DELETION_NOT_PERMITTED;
+        return false;
+    }
+    /* cancel the COV subscriptions of the object */
+    handler_cov_object_deleted(data->object_type, data->object_instance);
+
+    return true;
+}
+
 bool Device_Object_Name_Copy(
     BACNET_OBJECT_TYPE object_type,
     uint32_t object_instance,
     BACNET_CHARACTER_STRING * object_name)
 {
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
     bool found = false;
 
     pObject = Device_Objects_Find_Functions(object_type);
@@ -961,6 +1341,28 @@ bool Device_Set_DHCP_Setting(bool dhcp)
 	return true;
 }
 
+/* an element of PROP_OBJECT_CHANGES: the revision after the change,
+   what changed and the object, oldest change first */
+static int Device_Object_Change_Encode(
+    OBJECT_JOURNAL * journal,
+    unsigned element,
+    uint8_t * apdu)
+{
+    OBJECT_JOURNAL_ENTRY entry;
+    int len = 0;
+
+    if (!object_journal_entry(journal, element, &entry)) {
+        return 0;
+    }
+    len = encode_application_unsigned(&apdu[0], entry.revision);
+    len += encode_application_enumerated(&apdu[len], entry.change);
+    len +=
+        encode_application_object_id(&apdu[len], entry.type,
+        entry.instance);
+
+    return len;
+}
+
 /* return the length of the apdu encoded or BACNET_STATUS_ERROR for error */
 int Device_Read_Property_Local(
     BACNET_READ_PROPERTY_DATA * rpdata)
@@ -974,7 +1376,7 @@ int Device_Read_Property_Local(
     uint32_t instance = 0;
     unsigned count = 0;
     uint8_t *apdu = NULL;
-    struct my_object_functions *pObject = NULL;
+    object_functions_t *pObject = NULL;
 
     if ((rpdata->application_data == NULL) ||
         (rpdata->application_data_len == 0)) {
@@ -994,19 +1396,19 @@ int Device_Read_Property_Local(
     apdu = rpdata->application_data;
     switch (rpdata->object_property) {
 				case PROP_OBJECT_NAME:
-					Device_Object_Name(Device_Descr.object_instance, &char_string);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                Device_Descr.object_name);
 						break;
         case PROP_DESCRIPTION:
-            characterstring_init_ansi(&char_string, Device_Descr.Description);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                Device_Descr.Description);
             break;
         case PROP_LOCATION:
-            characterstring_init_ansi(&char_string, Device_Descr.Location);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                Device_Descr.Location);
             break;
         case PROP_SYSTEM_STATUS:
             apdu_len =
@@ -1014,27 +1416,27 @@ int Device_Read_Property_Local(
                 Device_System_Status());
             break;
         case PROP_VENDOR_NAME:
-            characterstring_init_ansi(&char_string, Device_Descr.Vendor_Name);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                Device_Descr.Vendor_Name);
             break;
         case PROP_VENDOR_IDENTIFIER:
             apdu_len = encode_application_unsigned(&apdu[0], Device_Vendor_Identifier());
             break;
         case PROP_MODEL_NAME:
-						characterstring_init_ansi(&char_string, Device_Descr.Model_Name);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                Device_Descr.Model_Name);
             break;
         case PROP_FIRMWARE_REVISION:
-            characterstring_init_ansi(&char_string, BACnet_Version);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                BACnet_Version);
             break;
         case PROP_APPLICATION_SOFTWARE_VERSION:
-            characterstring_init_ansi(&char_string, Device_Descr.Application_Software_Version);
             apdu_len =
-                encode_application_character_string(&apdu[0], &char_string);
+                encode_application_ansi_string(&apdu[0],
+                Device_Descr.Application_Software_Version);
             break;
         case PROP_PROTOCOL_VERSION:
             apdu_len =
@@ -1064,13 +1466,11 @@ int Device_Read_Property_Local(
                 bitstring_set_bit(&bit_string, (uint8_t) i, false);
             }
             /* set the object types with objects to supported */
-            i = 0;
-            pObject = &Object_Table[i];
-            while (pObject->Object_Type < MAX_BACNET_OBJECT_TYPE) {
+            for (i = 0; i < Object_Type_Count; i++) {
+                pObject = Object_Types[i];
                 if ((pObject->Object_Count) && (pObject->Object_Count() > 0)) {
                     bitstring_set_bit(&bit_string, pObject->Object_Type, true);
                 }
-                pObject++;
             }
             apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
             break;
@@ -1093,7 +1493,7 @@ int Device_Read_Property_Local(
                         apdu_len += len;
                         /* assume next one is the same size as this one */
                         /* can we all fit into the APDU? */
-                        if ((apdu_len + len) >= MAX_APDU) {
+                        if ((apdu_len + len) >= rpdata->application_data_len) {
                             /* Abort response */
                             rpdata->error_code =
                                 ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -1142,6 +1542,17 @@ int Device_Read_Property_Local(
             apdu_len =
                 encode_application_unsigned(&apdu[0],
                 Device_Database_Revision());
+            break;
+        case PROP_OBJECT_CHANGES_BASE:
+            apdu_len =
+                encode_application_unsigned(&apdu[0],
+                object_journal_base(&Object_Journal));
+            break;
+        case PROP_OBJECT_CHANGES:
+            apdu_len =
+                object_read_array(&Object_Journal, rpdata,
+                object_journal_count(&Object_Journal),
+                Device_Object_Change_Encode);
             break;
 				case PROP_GATEWAY_IP:	// IP address
 						Device_IP_Address(&char_string);
@@ -1160,7 +1571,7 @@ int Device_Read_Property_Local(
 					break;
 				
 				case PROP_ACTIVE_COV_SUBSCRIPTIONS:
-            apdu_len = handler_cov_encode_subscriptions(&apdu[0], MAX_APDU);
+            apdu_len = handler_cov_encode_subscriptions(&apdu[0], rpdata->application_data_len);
             break;
         default:
             rpdata->error_class = ERROR_CLASS_PROPERTY;
@@ -1171,6 +1582,7 @@ int Device_Read_Property_Local(
     
     /*  only array properties can have array options */
     if ((apdu_len >= 0) && (rpdata->object_property != PROP_OBJECT_LIST) &&
+        (rpdata->object_property != PROP_OBJECT_CHANGES) &&
         (rpdata->array_index != BACNET_ARRAY_ALL)) {
         rpdata->error_class = ERROR_CLASS_PROPERTY;
         rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
@@ -1319,6 +1731,8 @@ bool Device_Write_Property_Local(
         case PROP_ACTIVE_COV_SUBSCRIPTIONS:
           
         case PROP_DATABASE_REVISION:
+        case PROP_OBJECT_CHANGES_BASE:
+        case PROP_OBJECT_CHANGES:
             wp_data->error_class = ERROR_CLASS_PROPERTY;
             wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
             break;
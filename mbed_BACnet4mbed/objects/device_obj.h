@@ -38,7 +38,10 @@
 #include "rp.h"
 #include "rpm.h"
 #include "readrange.h"
+#include "create_object.h"
+#include "delete_object.h"
 #include "datalink.h"
+#include "objjournal.h"
 
 /** Called so a BACnet object can perform any necessary initialization.
  * @ingroup ObjHelpers
@@ -139,6 +142,25 @@ typedef void (
     *object_intrinsic_reporting_function) (
     uint32_t object_instance);
 
+/** Creates an object of this type at runtime, with default values.
+ * @ingroup ObjHelpers
+ * @param [in] The instance number of the new object.
+ * @return True if created, false if the instance is in use or there is
+ *         no room for another object of this type.
+ */
+typedef bool(
+    *object_create_function) (
+    uint32_t object_instance);
+
+/** Deletes an object of this type that was created at runtime.
+ * @ingroup ObjHelpers
+ * @param [in] The object instance number to be deleted.
+ * @return True if deleted, false if the object may not be deleted.
+ */
+typedef bool(
+    *object_delete_function) (
+    uint32_t object_instance);
+
 
 /** Defines the group of object helper functions for any supported Object.
  * @ingroup ObjHelpers
@@ -165,8 +187,16 @@ typedef struct object_functions {
     object_cov_function Object_COV;
     object_cov_clear_function Object_COV_Clear;
     object_intrinsic_reporting_function Object_Intrinsic_Reporting;
+    object_create_function Object_Create;
+    object_delete_function Object_Delete;
 } object_functions_t;
 
+/* object types that Device_Object_Type_Register() can add to the
+   built-in ones of device_obj.cpp */
+#ifndef MAX_REGISTERED_OBJECT_TYPES
+#define MAX_REGISTERED_OBJECT_TYPES 2
+#endif
+
 /* String Lengths - excluding any nul terminator */
 #define MAX_DEV_NAME_LEN 32
 #define MAX_DEV_LOC_LEN  64
@@ -244,6 +274,8 @@ extern "C" {
 	
     void Device_Init(
         object_functions_t * object_table);
+    bool Device_Object_Type_Register(
+        object_functions_t * functions);
 
     bool Device_Reinitialize(
         BACNET_REINITIALIZE_DEVICE_DATA * rd_data);
@@ -288,6 +320,8 @@ extern "C" {
         uint32_t object_id);
     unsigned Device_Object_List_Count(
         void);
+    void Device_Object_List_Changed(
+        void);
     bool Device_Object_List_Identifier(
         unsigned array_index,
         int *object_type,
@@ -362,15 +396,31 @@ extern "C" {
         uint32_t revision);
     void Device_Inc_Database_Revision(
         void);
+    void Device_Object_Changed(
+        OBJECT_CHANGE change,
+        int object_type,
+        uint32_t object_instance);
 
     bool Device_Valid_Object_Name(
         BACNET_CHARACTER_STRING * object_name,
         int *object_type,
         uint32_t * object_instance);
+    void Device_Object_Name_Index_Add(
+        int object_type,
+        uint32_t object_instance);
+    void Device_Object_Name_Index_Remove(
+        int object_type,
+        uint32_t object_instance);
     bool Device_Valid_Object_Id(
         int object_type,
         uint32_t object_instance);
 
+    /* CreateObject and DeleteObject services */
+    bool Device_Create_Object(
+        BACNET_CREATE_OBJECT_DATA * data);
+    bool Device_Delete_Object(
+        BACNET_DELETE_OBJECT_DATA * data);
+
     int Device_Read_Property(
         BACNET_READ_PROPERTY_DATA * rpdata);
     bool Device_Write_Property(
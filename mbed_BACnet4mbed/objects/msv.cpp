@@ -33,6 +33,9 @@
 #include "bacenum.h"
 #include "bacapp.h"
 #include "config_bacnet.h" /* the custom stuff */
+#include "objindex.h"
+#include "objengine.h"
+#include "objcommand.h"
 #include "msv.h"
 #include "handlers.h"
 #include "mbed.h"
@@ -41,72 +44,248 @@
 
 extern EventQueue bacQueue;
 
-/* we choose to have a NULL level in our system represented by */
-/* a particular value.  When the priorities are not in use, they */
-/* will be relinquished (i.e. set to the NULL level). */
-#define MSV_LEVEL_NULL NULL
-/* When all the priorities are level null, the present value returns */
-/* the Relinquish Default value */
-#define MSV_RELINQUISH_DEFAULT 0
-
 #define MULTISTATE_MAX_NUMBER_OF_STATES 255
 
 extern MULTISTATE_VALUE_DESCR MSV_Descr[];
 
 uint32_t NUM_MULTISTATE_VALUES;
+/* instance number to MSV_Descr[] index */
+static OBJECT_INDEX MSV_Index;
+
+/* the descriptor of an instance, NULL if there is none */
+static MULTISTATE_VALUE_DESCR *Multistate_Value_Object(
+    uint32_t object_instance)
+{
+    unsigned index = 0;
+
+    if (object_index_find(&MSV_Index, object_instance, &index))
+    {
+        return &MSV_Descr[index];
+    }
+
+    return NULL;
+}
+
+static void Multistate_Value_Read_Notify(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_PROPERTY_ID object_property)
+{
+    if (object->read_callback)
+    {
+        uint8_t id = bacQueue.call(object->read_callback, (uint32_t)object_property);
+
+        if (id > 0)
+        {
+            EVRECORD2(BACNET_EVQ_MSV_RDCB_CALLED, id, 0);
+        }
+        else
+        {
+            EVRECORD2(BACNET_EVQ_MSV_RDCB_FAILED, id, 0);
+        }
+    }
+}
+
+static void Multistate_Value_Write_Notify(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    if (object->write_callback)
+    {
+        /* a relinquish passes the value now in charge */
+        uint8_t level = (value->tag == BACNET_APPLICATION_TAG_NULL) ? object->Effective_Value : (uint8_t)value->type.Unsigned_Int;
+        uint8_t id = bacQueue.call(object->write_callback, (uint32_t)object_property, level);
+
+        if (id > 0)
+        {
+            EVRECORD2(BACNET_EVQ_MSV_WRCB_CALLED, id, 0);
+        }
+        else
+        {
+            EVRECORD2(BACNET_EVQ_MSV_WRCB_FAILED, id, 0);
+        }
+    }
+}
+
+static int Multistate_Value_Read_Present_Value(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_unsigned(&rpdata->application_data[0],
+                                       object->Effective_Value);
+}
+
+static bool Multistate_Value_Write_Present_Value(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_WRITE_PROPERTY_DATA *wp_data,
+    BACNET_APPLICATION_DATA_VALUE *value)
+{
+    if ((value->tag != BACNET_APPLICATION_TAG_NULL) &&
+        !WPValidateArgType(value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
+                           &wp_data->error_class, &wp_data->error_code))
+    {
+        return false;
+    }
+    if (object->PV_WriteProtected)
+    {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+    if (!object_write_priority_valid(wp_data))
+    {
+        return false;
+    }
+    if (value->tag == BACNET_APPLICATION_TAG_NULL)
+    {
+        return Multistate_Value_Present_Value_Relinquish(wp_data->object_instance, wp_data->priority);
+    }
+    /* states are numbered 1 to Number_Of_States */
+    if ((value->type.Unsigned_Int == 0) ||
+        (value->type.Unsigned_Int > object->Number_Of_States))
+    {
+        return object_write_value_out_of_range(wp_data);
+    }
+
+    return Multistate_Value_Present_Value_Set(wp_data->object_instance, value->type.Unsigned_Int, wp_data->priority);
+}
+
+static int Multistate_Value_Read_Number_Of_States(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_unsigned(&rpdata->application_data[0],
+                                       object->Number_Of_States);
+}
+
+static int Multistate_Value_Encode_Priority(
+    MULTISTATE_VALUE_DESCR *object,
+    unsigned element,
+    uint8_t *apdu)
+{
+    if (!object_command_active(object, element + 1))
+    {
+        return encode_application_null(&apdu[0]);
+    }
+
+    return encode_application_unsigned(&apdu[0], object->Present_Value[element]);
+}
+
+static int Multistate_Value_Read_Priority_Array(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return object_read_array(object, rpdata, BACNET_MAX_PRIORITY,
+                             Multistate_Value_Encode_Priority);
+}
+
+static int Multistate_Value_Read_Relinquish_Default(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return encode_application_unsigned(&rpdata->application_data[0],
+                                       object->Relinquish_Default);
+}
 
-/* These three arrays are used by the ReadPropertyMultiple handler */
-static const int Properties_Required[] = {
-    PROP_OBJECT_IDENTIFIER,
-    PROP_OBJECT_NAME,
-    PROP_OBJECT_TYPE,
-    PROP_PRESENT_VALUE,
-    PROP_STATUS_FLAGS,
-    PROP_EVENT_STATE,
-    PROP_OUT_OF_SERVICE,
-    PROP_NUMBER_OF_STATES,
-    PROP_PRIORITY_ARRAY,
-    PROP_RELINQUISH_DEFAULT,
-    -1};
-
-static const int Properties_Optional[] = {
-    PROP_DESCRIPTION,
-    PROP_STATE_TEXT,
-    -1};
-
-static const int Properties_Proprietary[] = {
-    -1};
+static int Multistate_Value_Encode_State_Text(
+    MULTISTATE_VALUE_DESCR *object,
+    unsigned element,
+    uint8_t *apdu)
+{
+    return encode_application_ansi_string(&apdu[0],
+        object->State_Texts[element]);
+}
+
+static int Multistate_Value_Read_State_Text(
+    MULTISTATE_VALUE_DESCR *object,
+    BACNET_READ_PROPERTY_DATA *rpdata)
+{
+    return object_read_array(object, rpdata, object->Number_Of_States,
+                             Multistate_Value_Encode_State_Text);
+}
+
+/* The properties of the Multi-state Value object type, the ReadProperty,
+   WriteProperty and ReadPropertyMultiple handlers are built from it */
+static const BACnet_Object_Property<MULTISTATE_VALUE_DESCR>
+    Multistate_Value_Properties[] = {
+        {PROP_OBJECT_IDENTIFIER, OBJ_PROP_REQUIRED,
+         object_read_object_identifier<MULTISTATE_VALUE_DESCR>, NULL},
+        {PROP_OBJECT_NAME, OBJ_PROP_REQUIRED,
+         object_read_string<MULTISTATE_VALUE_DESCR,
+                            &MULTISTATE_VALUE_DESCR::Object_Name>, NULL},
+        {PROP_OBJECT_TYPE, OBJ_PROP_REQUIRED,
+         object_read_object_type<MULTISTATE_VALUE_DESCR>, NULL},
+        {PROP_PRESENT_VALUE, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+         Multistate_Value_Read_Present_Value,
+         Multistate_Value_Write_Present_Value},
+        {PROP_STATUS_FLAGS, OBJ_PROP_REQUIRED | OBJ_PROP_COV,
+         object_read_status_flags<MULTISTATE_VALUE_DESCR>, NULL},
+        {PROP_EVENT_STATE, OBJ_PROP_REQUIRED,
+         object_read_event_state<MULTISTATE_VALUE_DESCR>, NULL},
+        {PROP_OUT_OF_SERVICE, OBJ_PROP_REQUIRED,
+         object_read_out_of_service<MULTISTATE_VALUE_DESCR>,
+         object_write_out_of_service<MULTISTATE_VALUE_DESCR>},
+        {PROP_NUMBER_OF_STATES, OBJ_PROP_REQUIRED,
+         Multistate_Value_Read_Number_Of_States, NULL},
+        {PROP_PRIORITY_ARRAY, OBJ_PROP_REQUIRED | OBJ_PROP_ARRAY,
+         Multistate_Value_Read_Priority_Array, NULL},
+        {PROP_RELINQUISH_DEFAULT, OBJ_PROP_REQUIRED,
+         Multistate_Value_Read_Relinquish_Default, NULL},
+        {PROP_DESCRIPTION, OBJ_PROP_OPTIONAL,
+         object_read_string<MULTISTATE_VALUE_DESCR,
+                            &MULTISTATE_VALUE_DESCR::Object_Description>, NULL},
+        {PROP_STATE_TEXT, OBJ_PROP_OPTIONAL | OBJ_PROP_ARRAY,
+         Multistate_Value_Read_State_Text, NULL},
+};
+
+static int Multistate_Value_Property_List[OBJ_PROPERTY_COUNT(Multistate_Value_Properties) + 3];
+static uint8_t Multistate_Value_Property_Order[
+    OBJ_PROPERTY_COUNT(Multistate_Value_Properties) + 1];
+
+static const BACnet_Object_Class<MULTISTATE_VALUE_DESCR> Multistate_Value_Class = {
+    OBJECT_MULTI_STATE_VALUE,
+    Multistate_Value_Properties,
+    OBJ_PROPERTY_COUNT(Multistate_Value_Properties),
+    Multistate_Value_Property_List,
+    Multistate_Value_Property_Order,
+    Multistate_Value_Object,
+    Multistate_Value_Read_Notify,
+    Multistate_Value_Write_Notify};
 
 void Multistate_Value_Property_Lists(
     const int **pRequired,
     const int **pOptional,
     const int **pProprietary)
 {
-    if (pRequired)
-        *pRequired = Properties_Required;
-    if (pOptional)
-        *pOptional = Properties_Optional;
-    if (pProprietary)
-        *pProprietary = Properties_Proprietary;
-
-    return;
+    object_property_lists(&Multistate_Value_Class, pRequired, pOptional, pProprietary);
 }
 
 void Multistate_Value_Init(
     void)
 {
     unsigned int i;
-    unsigned j;
-    /* initialize all the analog output priority arrays to NULL */
-    for (i = 0; i < Multistate_Value_Count(); i++)
+    /* counted once, validateDescrObjects() checked the delimiter */
+    NUM_MULTISTATE_VALUES = 0;
+    while (MSV_Descr[NUM_MULTISTATE_VALUES].Object_Instance <= BACNET_MAX_INSTANCE)
+        NUM_MULTISTATE_VALUES++;
+    /* without memory for the index the instances are searched */
+    if (!object_index_build(&MSV_Index, NUM_MULTISTATE_VALUES,
+            NUM_MULTISTATE_VALUES, Multistate_Value_Index_To_Instance))
+        { EVRECORD2(BACNET_INIT_OBJ_INDEX_FAILED, OBJECT_MULTI_STATE_VALUE,
+            NUM_MULTISTATE_VALUES); }
+
+    /* initialize all the multistate value priority arrays to NULL */
+    for (i = 0; i < NUM_MULTISTATE_VALUES; i++)
     {
         MSV_Descr[i].Event_State = EVENT_STATE_NORMAL;
         MSV_Descr[i].Out_Of_Service = false;
         MSV_Descr[i].Reliability = RELIABILITY_NO_FAULT_DETECTED;
         MSV_Descr[i].Changed = false;
 
-        for (j = 0; j < BACNET_MAX_PRIORITY; j++)
-            MSV_Descr[i].Present_Value[j] = MSV_LEVEL_NULL;
+        /* states are numbered from 1, state 1 unless configured */
+        if (MSV_Descr[i].Relinquish_Default == 0)
+            MSV_Descr[i].Relinquish_Default = 1;
+        object_command_init(&MSV_Descr[i]);
     }
 
     return;
@@ -120,13 +299,10 @@ unsigned Multistate_Value_Instance_To_Index(
 {
     unsigned index = 0;
 
-    for (index = 0; index < NUM_MULTISTATE_VALUES; index++)
-    {
-        if (MSV_Descr[index].Object_Instance == object_instance)
-            return index;
-    }
+    if (object_index_find(&MSV_Index, object_instance, &index))
+        return index;
 
-    return index;
+    return NUM_MULTISTATE_VALUES;
 }
 
 /* we simply have 0-n object instances.  Yours might be */
@@ -143,13 +319,7 @@ uint32_t Multistate_Value_Index_To_Instance(
 unsigned Multistate_Value_Count(
     void)
 {
-    uint32_t i = 0;
-
-    while (MSV_Descr[i].Object_Instance <= BACNET_MAX_INSTANCE)
-        i++;
-
-    NUM_MULTISTATE_VALUES = i;
-    return i;
+    return NUM_MULTISTATE_VALUES;
 }
 
 bool Multistate_Value_Valid_Instance(
@@ -169,27 +339,23 @@ bool Multistate_Value_Valid_Instance(
 uint32_t Multistate_Value_Present_Value(
     uint32_t object_instance)
 {
-    uint8_t value = MSV_RELINQUISH_DEFAULT;
-    uint8_t current_value = MSV_RELINQUISH_DEFAULT;
-    unsigned i = 0;
-    uint32_t index;
-
-    index = Multistate_Value_Instance_To_Index(object_instance);
+    MULTISTATE_VALUE_DESCR *object = Multistate_Value_Object(object_instance);
 
-    if (index < NUM_MULTISTATE_VALUES)
+    if (object)
     {
-        for (i = 0; i < BACNET_MAX_PRIORITY; i++)
-        {
-            current_value = MSV_Descr[index].Present_Value[i];
-            if (current_value != MSV_LEVEL_NULL)
-            {
-                value = MSV_Descr[index].Present_Value[i];
-                break;
-            }
-        }
+        return object->Effective_Value;
     }
 
-    return value;
+    return 0;
+}
+
+/* a change of the present value is reported by COV */
+static void Multistate_Value_Changed(
+    MULTISTATE_VALUE_DESCR *object)
+{
+    object->Changed = true;
+    handler_cov_object_changed(OBJECT_MULTI_STATE_VALUE,
+        object->Object_Instance);
 }
 
 bool Multistate_Value_Present_Value_Set(
@@ -197,27 +363,31 @@ bool Multistate_Value_Present_Value_Set(
     uint32_t value,
     unsigned priority)
 {
-    bool status = false;
-    uint8_t current_value = MSV_RELINQUISH_DEFAULT;
-    unsigned index = 0; /* offset from instance lookup */
-
-    index = Multistate_Value_Instance_To_Index(object_instance);
+    MULTISTATE_VALUE_DESCR *object = Multistate_Value_Object(object_instance);
 
-    if (index < NUM_MULTISTATE_VALUES)
+    /* states are numbered 1 to Number_Of_States */
+    if (object && (value > 0) && (value <= object->Number_Of_States))
     {
-        if ((value <= MSV_Descr[index].Number_Of_States) && (priority <= BACNET_MAX_PRIORITY))
-        {
-            current_value = Multistate_Value_Present_Value(object_instance);
+        return object_command_set(object, priority, (uint8_t)value,
+                                  Multistate_Value_Changed);
+    }
 
-            if (current_value != (uint8_t)value)
-                MSV_Descr[index].Changed = true;
+    return false;
+}
 
-            MSV_Descr[index].Present_Value[priority - 1] = (uint8_t)value;
-            status = true;
-        }
+bool Multistate_Value_Present_Value_Relinquish(
+    uint32_t object_instance,
+    unsigned priority)
+{
+    MULTISTATE_VALUE_DESCR *object = Multistate_Value_Object(object_instance);
+
+    if (object)
+    {
+        return object_command_relinquish(object, priority,
+                                         Multistate_Value_Changed);
     }
 
-    return status;
+    return false;
 }
 
 bool Multistate_Value_Out_Of_Service(
@@ -311,50 +481,12 @@ bool Multistate_Value_Encode_Value_List(
     uint32_t object_instance,
     BACNET_PROPERTY_VALUE *value_list)
 {
-    bool status = false;
-
-    if (value_list)
+    if (!object_encode_value_list(&Multistate_Value_Class, object_instance, value_list))
     {
-        value_list->propertyIdentifier = PROP_PRESENT_VALUE;
-        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-        value_list->value.context_specific = false;
-        value_list->value.tag = BACNET_APPLICATION_TAG_UNSIGNED_INT;
-        value_list->value.next = NULL;
-        value_list->value.type.Unsigned_Int =
-            Multistate_Value_Present_Value(object_instance);
-        value_list->priority = BACNET_NO_PRIORITY;
-        value_list = value_list->next;
-    }
-    if (value_list)
-    {
-        value_list->propertyIdentifier = PROP_STATUS_FLAGS;
-        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
-        value_list->value.context_specific = false;
-        value_list->value.tag = BACNET_APPLICATION_TAG_BIT_STRING;
-        value_list->value.next = NULL;
-        bitstring_init(&value_list->value.type.Bit_String);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-                          STATUS_FLAG_IN_ALARM, false);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-                          STATUS_FLAG_FAULT, false);
-        bitstring_set_bit(&value_list->value.type.Bit_String,
-                          STATUS_FLAG_OVERRIDDEN, false);
-        if (Multistate_Value_Out_Of_Service(object_instance))
-        {
-            bitstring_set_bit(&value_list->value.type.Bit_String,
-                              STATUS_FLAG_OUT_OF_SERVICE, true);
-        }
-        else
-        {
-            bitstring_set_bit(&value_list->value.type.Bit_String,
-                              STATUS_FLAG_OUT_OF_SERVICE, false);
-        }
-        value_list->priority = BACNET_NO_PRIORITY;
-        value_list->next = NULL;
+        return false;
     }
-    status = Multistate_Value_Change_Of_Value(object_instance);
 
-    return status;
+    return Multistate_Value_Change_Of_Value(object_instance);
 }
 
 bool Multistate_Value_Change_Of_Value(
@@ -387,390 +519,14 @@ void Multistate_Value_Change_Of_Value_Clear(
 int Multistate_Value_Read_Property(
     BACNET_READ_PROPERTY_DATA *rpdata)
 {
-    int len = 0;
-    int apdu_len = 0; /* return value */
-    BACNET_BIT_STRING bit_string;
-    BACNET_CHARACTER_STRING char_string;
-    uint32_t present_value = 0;
-    unsigned object_index = 0;
-    unsigned i;
-    bool state = false;
-    uint8_t *apdu = NULL;
-
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0))
-    {
-        return 0;
-    }
-
-    object_index = Multistate_Value_Instance_To_Index(rpdata->object_instance);
-
-    if (MSV_Descr[object_index].read_callback)
-    {
-        uint8_t id = bacQueue.call(MSV_Descr[object_index].read_callback, (uint32_t)rpdata->object_property);
-
-        if (id > 0)
-        {
-            EVRECORD2(BACNET_EVQ_MSV_RDCB_CALLED, id, 0);
-        }
-        else
-        {
-            EVRECORD2(BACNET_EVQ_MSV_RDCB_FAILED, id, 0);
-        }
-    }
-
-    apdu = rpdata->application_data;
-    switch (rpdata->object_property)
-    {
-    case PROP_OBJECT_IDENTIFIER:
-        apdu_len =
-            encode_application_object_id(&apdu[0],
-                                         OBJECT_MULTI_STATE_VALUE, rpdata->object_instance);
-        break;
-        /* note: Name and Description don't have to be the same.
-               You could make Description writable and different */
-    case PROP_OBJECT_NAME:
-        Multistate_Value_Object_Name(rpdata->object_instance, &char_string);
-        apdu_len = encode_application_character_string(&apdu[0], &char_string);
-        break;
-    case PROP_DESCRIPTION:
-        Multistate_Value_Object_Description(rpdata->object_instance,
-                                            &char_string);
-        apdu_len =
-            encode_application_character_string(&apdu[0], &char_string);
-        break;
-    case PROP_OBJECT_TYPE:
-        apdu_len =
-            encode_application_enumerated(&apdu[0],
-                                          OBJECT_MULTI_STATE_VALUE);
-        break;
-    case PROP_PRESENT_VALUE:
-        present_value =
-            Multistate_Value_Present_Value(rpdata->object_instance);
-        apdu_len = encode_application_unsigned(&apdu[0], present_value);
-        break;
-    case PROP_STATUS_FLAGS:
-        /* note: see the details in the standard on how to use these */
-        bitstring_init(&bit_string);
-        bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM, false);
-        bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
-        bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
-        if (Multistate_Value_Out_Of_Service(rpdata->object_instance))
-        {
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE,
-                              true);
-        }
-        else
-        {
-            bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE,
-                              false);
-        }
-        apdu_len = encode_application_bitstring(&apdu[0], &bit_string);
-        break;
-    case PROP_EVENT_STATE:
-        /* note: see the details in the standard on how to use this */
-        apdu_len =
-            encode_application_enumerated(&apdu[0], EVENT_STATE_NORMAL);
-        break;
-    case PROP_OUT_OF_SERVICE:
-        state = Multistate_Value_Out_Of_Service(rpdata->object_instance);
-        apdu_len = encode_application_boolean(&apdu[0], state);
-        break;
-    case PROP_NUMBER_OF_STATES:
-        object_index = Multistate_Value_Instance_To_Index(rpdata->object_instance);
-        apdu_len =
-            encode_application_unsigned(&apdu[apdu_len],
-                                        MSV_Descr[object_index].Number_Of_States);
-        break;
-    case PROP_PRIORITY_ARRAY:
-        /* Array element zero is the number of elements in the array */
-        if (rpdata->array_index == 0)
-            apdu_len =
-                encode_application_unsigned(&apdu[0], BACNET_MAX_PRIORITY);
-        /* if no index was specified, then try to encode the entire list */
-        /* into one packet. */
-        else if (rpdata->array_index == BACNET_ARRAY_ALL)
-        {
-            object_index = Multistate_Value_Instance_To_Index(rpdata->object_instance);
-
-            for (i = 0; i < BACNET_MAX_PRIORITY; i++)
-            {
-                /* FIXME: check if we have room before adding it to APDU */
-                present_value = (BACNET_BINARY_PV)MSV_Descr[object_index].Present_Value[i];
-                if (present_value == BINARY_NULL)
-                {
-                    len = encode_application_null(&apdu[apdu_len]);
-                }
-                else
-                {
-                    len =
-                        encode_application_unsigned(&apdu[apdu_len],
-                                                    present_value);
-                }
-                /* add it if we have room */
-                if ((apdu_len + len) < MAX_APDU)
-                    apdu_len += len;
-                else
-                {
-                    rpdata->error_class = ERROR_CLASS_SERVICES;
-                    rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                    apdu_len = BACNET_STATUS_ERROR;
-                    break;
-                }
-            }
-        }
-        else
-        {
-            object_index = Multistate_Value_Instance_To_Index(rpdata->object_instance);
-
-            if (rpdata->array_index <= BACNET_MAX_PRIORITY)
-            {
-                present_value = MSV_Descr[object_index].Present_Value[rpdata->array_index - 1];
-                if (present_value == MSV_LEVEL_NULL)
-                {
-                    apdu_len = encode_application_null(&apdu[apdu_len]);
-                }
-                else
-                {
-                    apdu_len =
-                        encode_application_unsigned(&apdu[apdu_len],
-                                                    present_value);
-                }
-            }
-            else
-            {
-                rpdata->error_class = ERROR_CLASS_PROPERTY;
-                rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                apdu_len = BACNET_STATUS_ERROR;
-            }
-        }
-        break;
-    case PROP_RELINQUISH_DEFAULT:
-        present_value = MSV_RELINQUISH_DEFAULT;
-        apdu_len = encode_application_unsigned(&apdu[0], present_value);
-        break;
-
-    case PROP_STATE_TEXT:
-        if (rpdata->array_index == 0)
-        {
-            /* Array element zero is the number of elements in the array */
-            apdu_len = encode_application_unsigned(&apdu[0], MSV_Descr[object_index].Number_Of_States);
-        }
-        else if (rpdata->array_index == BACNET_ARRAY_ALL)
-        {
-            /* if no index was specified, then try to encode the entire list */
-            /* into one packet. */
-            object_index = Multistate_Value_Instance_To_Index(rpdata->object_instance);
-
-            for (i = 1; i <= MSV_Descr[object_index].Number_Of_States; i++)
-            {
-                Multistate_Value_State_Text(rpdata->object_instance, i, &char_string);
-
-                /* FIXME: this might go beyond MAX_APDU length! */
-                len = encode_application_character_string(&apdu[apdu_len], &char_string);
-
-                /* add it if we have room */
-                if ((apdu_len + len) < MAX_APDU)
-                {
-                    apdu_len += len;
-                }
-                else
-                {
-                    rpdata->error_class = ERROR_CLASS_SERVICES;
-                    rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
-                    apdu_len = BACNET_STATUS_ERROR;
-                    break;
-                }
-            }
-        }
-        else
-        {
-            object_index = Multistate_Value_Instance_To_Index(rpdata->object_instance);
-
-            if (rpdata->array_index <= MSV_Descr[object_index].Number_Of_States)
-            {
-                Multistate_Value_State_Text(rpdata->object_instance, rpdata->array_index, &char_string);
-                apdu_len = encode_application_character_string(&apdu[0], &char_string);
-            }
-            else
-            {
-                rpdata->error_class = ERROR_CLASS_PROPERTY;
-                rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
-                apdu_len = BACNET_STATUS_ERROR;
-            }
-        }
-        break;
-
-    default:
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-        apdu_len = BACNET_STATUS_ERROR;
-        break;
-    }
-    /*  only array properties can have array options */
-    if ((apdu_len >= 0) && (rpdata->object_property != PROP_STATE_TEXT) &&
-        (rpdata->object_property != PROP_PRIORITY_ARRAY) &&
-        (rpdata->array_index != BACNET_ARRAY_ALL))
-    {
-        rpdata->error_class = ERROR_CLASS_PROPERTY;
-        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        apdu_len = BACNET_STATUS_ERROR;
-    }
-
-    return apdu_len;
+    return object_read_property(&Multistate_Value_Class, rpdata);
 }
 
 /* returns true if successful */
 bool Multistate_Value_Write_Property(
     BACNET_WRITE_PROPERTY_DATA *wp_data)
 {
-    bool status = false; /* return value */
-    unsigned int object_index = 0;
-    unsigned int priority = 0;
-    uint32_t level = 0;
-    int len = 0;
-    BACNET_APPLICATION_DATA_VALUE value;
-
-    /* decode the some of the request */
-    len =
-        bacapp_decode_application_data(wp_data->application_data,
-                                       wp_data->application_data_len, &value);
-    /* FIXME: len < application_data_len: more data? */
-    if (len < 0)
-    {
-        /* error while decoding - a value larger than we can handle */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-        return false;
-    }
-    if ((wp_data->object_property != PROP_STATE_TEXT) &&
-        (wp_data->object_property != PROP_PRIORITY_ARRAY) &&
-        (wp_data->array_index != BACNET_ARRAY_ALL))
-    {
-        /*  only array properties can have array options */
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
-        return false;
-    }
-
-    object_index = Multistate_Value_Instance_To_Index(wp_data->object_instance);
-
-    switch (wp_data->object_property)
-    {
-    case PROP_PRESENT_VALUE:
-        priority = wp_data->priority;
-        status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_UNSIGNED_INT, &wp_data->error_class, &wp_data->error_code);
-        if (status)
-        {
-            if (MSV_Descr[object_index].PV_WriteProtected)
-            {
-              wp_data->error_class = ERROR_CLASS_PROPERTY;
-              wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-            }
-            else
-            {
-              /* Command priority 6 is reserved for use by Minimum On/Off
-               * algorithm and may not be used for other purposes in any
-               * object. */
-              if (priority && (priority <= BACNET_MAX_PRIORITY) &&
-                  (priority != 6 /* reserved */) &&
-                  (value.type.Unsigned_Int > 0) &&
-                  (value.type.Unsigned_Int <= MSV_Descr[object_index].Number_Of_States))
-              {
-                  level = value.type.Unsigned_Int;
-                  status = Multistate_Value_Present_Value_Set(wp_data->object_instance, (uint8_t)level, priority);
-              }
-              else if (priority == 6)
-              {
-                  status = false;
-                  /* Command priority 6 is reserved for use by Minimum On/Off
-                   * algorithm and may not be used for other purposes in any
-                   * object. */
-                  wp_data->error_class = ERROR_CLASS_PROPERTY;
-                  wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-              }
-              else
-              {
-                  status = false;
-                  wp_data->error_class = ERROR_CLASS_PROPERTY;
-                  wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
-              }
-            }
-        }
-        else
-        {
-            status = WPValidateArgType(&value, BACNET_APPLICATION_TAG_NULL, &wp_data->error_class, &wp_data->error_code);
-            if (status)
-            {
-
-                if (priority && (priority <= BACNET_MAX_PRIORITY) && (priority != 6 /* reserved */))
-                {
-                    status = Multistate_Value_Present_Value_Set(wp_data->object_instance, MSV_LEVEL_NULL, priority);
-                    /* Note: you could set the physical output here to the next
-                           highest priority, or to the relinquish default if no
-                           priorities are set.
-                           However, if Out of Service is TRUE, then don't set the
-                           physical output.  This comment may apply to the
-                           main loop (i.e. check out of service before changing output) */
-                }
-                else if (priority == 6)
-                {
-                    status = false;
-                    wp_data->error_class = ERROR_CLASS_PROPERTY;
-                    wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-                }
-            }
-            else
-            {
-                status = false;
-                wp_data->error_class = ERROR_CLASS_PROPERTY;
-                wp_data->error_code = ERROR_CODE_INVALID_DATA_TYPE;
-            }
-        }
-        break;
-    case PROP_OUT_OF_SERVICE:
-        status =
-            WPValidateArgType(&value, BACNET_APPLICATION_TAG_BOOLEAN,
-                              &wp_data->error_class, &wp_data->error_code);
-        if (status)
-        {
-            Multistate_Value_Out_Of_Service_Set(wp_data->object_instance, value.type.Boolean);
-        }
-        break;
-    case PROP_OBJECT_IDENTIFIER:
-    case PROP_OBJECT_NAME:
-    case PROP_OBJECT_TYPE:
-    case PROP_STATUS_FLAGS:
-    case PROP_EVENT_STATE:
-    case PROP_NUMBER_OF_STATES:
-    case PROP_DESCRIPTION:
-    case PROP_PRIORITY_ARRAY:
-    case PROP_RELINQUISH_DEFAULT:
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
-        break;
-    default:
-        wp_data->error_class = ERROR_CLASS_PROPERTY;
-        wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
-        break;
-    }
-
-    if (MSV_Descr[object_index].write_callback)
-    {
-        BACNET_APPLICATION_DATA_VALUE value;
-				len = bacapp_decode_application_data(wp_data->application_data,
-																						 wp_data->application_data_len,
-																						 &value);
-      
-        uint8_t id = bacQueue.call(MSV_Descr[object_index].write_callback, (uint32_t)wp_data->object_property, (uint8_t) value.type.Unsigned_Int);
-
-        if (id > 0)
-        { EVRECORD2(BACNET_EVQ_MSV_WRCB_CALLED, id, 0); }
-        else
-        { EVRECORD2(BACNET_EVQ_MSV_WRCB_FAILED, id, 0); }
-    }
-
-    return status;
+    return object_write_property(&Multistate_Value_Class, wp_data);
 }
 
 #ifdef TEST
@@ -49,6 +49,10 @@ typedef struct multistate_value_descr {
       msv_callback_wr write_callback;
       unsigned Event_State:3;
       uint8_t Present_Value[16];
+      /* see objcommand.h */
+      uint16_t Priority_Active;
+      uint8_t Relinquish_Default;
+      uint8_t Effective_Value;
       BACNET_RELIABILITY Reliability;
       bool Out_Of_Service;
       bool Changed;
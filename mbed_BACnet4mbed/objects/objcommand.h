@@ -0,0 +1,167 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJCOMMAND_H
+#define OBJCOMMAND_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "bacdef.h"
+
+/** @file objcommand.h  Priority arrays of commandable objects */
+
+/* A commandable object (AO, AV, BO, BV, MSV) has these descriptor fields,
+   the functions of this file work on every descriptor having them:
+     Present_Value[BACNET_MAX_PRIORITY]  the value of each priority slot
+     Priority_Active    bit (16 - priority) is set if the slot holds a
+                        value, so the highest set bit is priority 1
+     Relinquish_Default the value while no slot holds one
+     Effective_Value    the value of the most important active slot, or
+                        Relinquish_Default; kept up to date by
+                        object_command_set() and _relinquish()
+   A slot is NULL only if its bit is clear, so any value can be written,
+   0 included. Reading the present value is a field access, and finding
+   the slot in charge after a write is one count leading zeros. */
+
+/* the Priority_Active bit of a priority 1..16 */
+#define OBJ_COMMAND_BIT(priority) \
+    ((uint16_t) (0x8000U >> ((priority) - 1)))
+
+/* the most important priority of a Priority_Active mask, 0 if none */
+inline unsigned object_command_priority_of(
+    uint16_t active)
+{
+    if (!active)
+        return 0;
+#if defined(__CC_ARM)
+    return __clz(active) - 15;
+#elif defined(__GNUC__)
+    return (unsigned) __builtin_clz((unsigned) active) - 15;
+#else
+    {
+        unsigned priority = 1;
+
+        while (!(active & 0x8000U)) {
+            active <<= 1;
+            priority++;
+        }
+        return priority;
+    }
+#endif
+}
+
+/* the priority in charge of the present value, 0 if relinquished */
+template <typename DESCR>
+unsigned object_command_priority(
+    const DESCR * object)
+{
+    return object_command_priority_of(object->Priority_Active);
+}
+
+/* true if the slot of a priority 1..16 holds a value, false if NULL */
+template <typename DESCR>
+bool object_command_active(
+    const DESCR * object,
+    unsigned priority)
+{
+    return (object->Priority_Active & OBJ_COMMAND_BIT(priority)) != 0;
+}
+
+/* sets Effective_Value from the active slots and returns true if it
+   changed */
+template <typename DESCR>
+bool object_command_resolve(
+    DESCR * object)
+{
+    unsigned priority = object_command_priority(object);
+    bool changed = false;
+
+    if (priority) {
+        changed = (object->Effective_Value !=
+            object->Present_Value[priority - 1]);
+        object->Effective_Value = object->Present_Value[priority - 1];
+    } else {
+        changed = (object->Effective_Value != object->Relinquish_Default);
+        object->Effective_Value = object->Relinquish_Default;
+    }
+
+    return changed;
+}
+
+/* all slots NULL, the present value is Relinquish_Default */
+template <typename DESCR>
+void object_command_init(
+    DESCR * object)
+{
+    unsigned i;
+
+    object->Priority_Active = 0;
+    for (i = 0; i < BACNET_MAX_PRIORITY; i++) {
+        object->Present_Value[i] = object->Relinquish_Default;
+    }
+    object->Effective_Value = object->Relinquish_Default;
+}
+
+/* Writes the slot of a priority 1..16.
+   The optional hook is called if the present value changed by it.
+   Returns false if the priority is out of range. */
+template <typename DESCR, typename VALUE>
+bool object_command_set(
+    DESCR * object,
+    unsigned priority,
+    VALUE value,
+    void (*changed) (DESCR * object) = NULL)
+{
+    if ((priority == 0) || (priority > BACNET_MAX_PRIORITY))
+        return false;
+    object->Present_Value[priority - 1] = value;
+    object->Priority_Active |= OBJ_COMMAND_BIT(priority);
+    if (object_command_resolve(object) && changed)
+        changed(object);
+
+    return true;
+}
+
+/* Sets the slot of a priority 1..16 to NULL, the next active slot or
+   Relinquish_Default takes over. The optional hook is called if the
+   present value changed by it, e.g. to drive an output to the value
+   now in charge. Returns false if the priority is out of range. */
+template <typename DESCR>
+bool object_command_relinquish(
+    DESCR * object,
+    unsigned priority,
+    void (*changed) (DESCR * object) = NULL)
+{
+    if ((priority == 0) || (priority > BACNET_MAX_PRIORITY))
+        return false;
+    object->Priority_Active &= (uint16_t) ~OBJ_COMMAND_BIT(priority);
+    if (object_command_resolve(object) && changed)
+        changed(object);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,840 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#ifndef OBJENGINE_H
+#define OBJENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "bacdef.h"
+#include "bacdcode.h"
+#include "bacenum.h"
+#include "bacapp.h"
+#include "rp.h"
+#include "wp.h"
+#include "handlers.h"
+#include "device_obj.h"
+
+/** @file objengine.h  Property table driven object types */
+
+/* An object type declares its properties once, as a static const table
+   of BACnet_Object_Property entries: the property identifier, the flags
+   below and the accessor functions. ReadProperty, WriteProperty, the
+   ReadPropertyMultiple property lists and the COV value list of the
+   type are all generated from that table by the functions of this file.
+   The descriptor of an object (e.g. ANALOG_INPUT_DESCR) is the template
+   argument, so the accessors get the object without a lookup of their
+   own. Accessors that use a field name (Out_Of_Service, Units, ...)
+   work for every descriptor having that field. */
+
+/* BACnet_Object_Property.Flags */
+/* the list of the property in Property_Lists() */
+#define OBJ_PROP_REQUIRED       0x00
+#define OBJ_PROP_OPTIONAL       0x01
+#define OBJ_PROP_PROPRIETARY    0x02
+#define OBJ_PROP_LIST           0x03
+/* the property is an array, the accessors handle the array index */
+#define OBJ_PROP_ARRAY          0x04
+/* the property is part of the COV notifications, in table order */
+#define OBJ_PROP_COV            0x08
+
+/* number of entries of a property table */
+#define OBJ_PROPERTY_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+/* room for one encoded COV value (Present_Value, Status_Flags) */
+#ifndef OBJ_COV_VALUE_MAX
+#define OBJ_COV_VALUE_MAX 32
+#endif
+
+template <typename DESCR>
+struct BACnet_Object_Property {
+    BACNET_PROPERTY_ID Property;
+    uint8_t Flags;
+    /* encodes the value into rpdata->application_data and returns the
+       length, or BACNET_STATUS_ERROR with the error set in rpdata */
+    int (*Read) (
+        DESCR * object,
+        BACNET_READ_PROPERTY_DATA * rpdata);
+    /* NULL if the property is read only, else returns true if written
+       or false with the error set in wp_data */
+    bool (*Write) (
+        DESCR * object,
+        BACNET_WRITE_PROPERTY_DATA * wp_data,
+        BACNET_APPLICATION_DATA_VALUE * value);
+};
+
+template <typename DESCR>
+struct BACnet_Object_Class {
+    BACNET_OBJECT_TYPE Object_Type;
+    const BACnet_Object_Property<DESCR> *Properties;
+    unsigned Property_Count;
+    /* Property_Count + 3 entries, for the -1 terminated lists returned
+       by object_property_lists() */
+    int *Property_List;
+    /* Property_Count + 1 entries, the table indexes sorted by property
+       identifier for object_property_find(), built on the first call */
+    uint8_t *Property_Order;
+    /* the descriptor of an instance, NULL if there is none */
+    DESCR *(*Object) (
+        uint32_t object_instance);
+    /* optional, called before a property of the object is read */
+    void (*Read_Notify) (
+        DESCR * object,
+        BACNET_PROPERTY_ID object_property);
+    /* optional, called after a property of the object was written */
+    void (*Write_Notify) (
+        DESCR * object,
+        BACNET_PROPERTY_ID object_property,
+        BACNET_APPLICATION_DATA_VALUE * value);
+};
+
+/* Binary search of the property in Property_Order. The order is sorted
+   by insertion on the first call; the last entry is set to 1 then. */
+template <typename DESCR>
+const BACnet_Object_Property<DESCR> *object_property_find(
+    const BACnet_Object_Class<DESCR> *object_class,
+    BACNET_PROPERTY_ID object_property)
+{
+    const BACnet_Object_Property<DESCR> *properties =
+        object_class->Properties;
+    uint8_t *order = object_class->Property_Order;
+    unsigned count = object_class->Property_Count;
+    unsigned low = 0, high = count, middle, i, j;
+    uint8_t index;
+
+    if (!order[count]) {
+        for (i = 0; i < count; i++) {
+            index = (uint8_t) i;
+            for (j = i; (j > 0) &&
+                (properties[order[j - 1]].Property >
+                    properties[index].Property); j--)
+                order[j] = order[j - 1];
+            order[j] = index;
+        }
+        order[count] = 1;
+    }
+    while (low < high) {
+        middle = (low + high) / 2;
+        if (properties[order[middle]].Property < object_property)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if ((low < count) &&
+        (properties[order[low]].Property == object_property))
+        return &properties[order[low]];
+
+    return NULL;
+}
+
+/* The required, optional and proprietary lists for ReadPropertyMultiple,
+   in table order. Built into Property_List on the first call; the last
+   entry is the -1 terminating the proprietary list once built. */
+template <typename DESCR>
+void object_property_lists(
+    const BACnet_Object_Class<DESCR> *object_class,
+    const int **pRequired,
+    const int **pOptional,
+    const int **pProprietary)
+{
+    int *list = object_class->Property_List;
+    unsigned count = object_class->Property_Count;
+    unsigned start[OBJ_PROP_LIST];
+    unsigned i, n = 0;
+    uint8_t which;
+
+    if (list[count + 2] != -1) {
+        for (which = OBJ_PROP_REQUIRED; which <= OBJ_PROP_PROPRIETARY;
+            which++) {
+            start[which] = n;
+            for (i = 0; i < count; i++) {
+                if ((object_class->Properties[i].Flags & OBJ_PROP_LIST) ==
+                    which)
+                    list[n++] = object_class->Properties[i].Property;
+            }
+            list[n++] = -1;
+        }
+    } else {
+        start[OBJ_PROP_REQUIRED] = 0;
+        for (n = 0; list[n] != -1; n++);
+        start[OBJ_PROP_OPTIONAL] = ++n;
+        for (; list[n] != -1; n++);
+        start[OBJ_PROP_PROPRIETARY] = ++n;
+    }
+    if (pRequired)
+        *pRequired = &list[start[OBJ_PROP_REQUIRED]];
+    if (pOptional)
+        *pOptional = &list[start[OBJ_PROP_OPTIONAL]];
+    if (pProprietary)
+        *pProprietary = &list[start[OBJ_PROP_PROPRIETARY]];
+}
+
+/* return apdu length, or BACNET_STATUS_ERROR on error */
+template <typename DESCR>
+int object_read_property(
+    const BACnet_Object_Class<DESCR> *object_class,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    const BACnet_Object_Property<DESCR> *property;
+    DESCR *object;
+
+    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
+        (rpdata->application_data_len == 0)) {
+        return 0;
+    }
+    object = object_class->Object(rpdata->object_instance);
+    if (!object) {
+        rpdata->error_class = ERROR_CLASS_OBJECT;
+        rpdata->error_code = ERROR_CODE_UNKNOWN_OBJECT;
+        return BACNET_STATUS_ERROR;
+    }
+    if (object_class->Read_Notify)
+        object_class->Read_Notify(object, rpdata->object_property);
+
+    property = object_property_find(object_class, rpdata->object_property);
+    if (!property || !property->Read) {
+        rpdata->error_class = ERROR_CLASS_PROPERTY;
+        rpdata->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+        return BACNET_STATUS_ERROR;
+    }
+    /*  only array properties can have array options */
+    if (!(property->Flags & OBJ_PROP_ARRAY) &&
+        (rpdata->array_index != BACNET_ARRAY_ALL)) {
+        rpdata->error_class = ERROR_CLASS_PROPERTY;
+        rpdata->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
+        return BACNET_STATUS_ERROR;
+    }
+
+    return property->Read(object, rpdata);
+}
+
+/* returns true if successful */
+template <typename DESCR>
+bool object_write_property(
+    const BACnet_Object_Class<DESCR> *object_class,
+    BACNET_WRITE_PROPERTY_DATA * wp_data)
+{
+    const BACnet_Object_Property<DESCR> *property;
+    BACNET_APPLICATION_DATA_VALUE value;
+    DESCR *object;
+    int len = 0;
+
+    object = object_class->Object(wp_data->object_instance);
+    if (!object) {
+        wp_data->error_class = ERROR_CLASS_OBJECT;
+        wp_data->error_code = ERROR_CODE_UNKNOWN_OBJECT;
+        return false;
+    }
+    /* decode the some of the request */
+    len =
+        bacapp_decode_application_data(wp_data->application_data,
+        wp_data->application_data_len, &value);
+    /* FIXME: len < application_data_len: more data? */
+    if (len < 0) {
+        /* error while decoding - a value larger than we can handle */
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
+        return false;
+    }
+    property = object_property_find(object_class, wp_data->object_property);
+    if (!property) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_UNKNOWN_PROPERTY;
+        return false;
+    }
+    /*  only array properties can have array options */
+    if (!(property->Flags & OBJ_PROP_ARRAY) &&
+        (wp_data->array_index != BACNET_ARRAY_ALL)) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY;
+        return false;
+    }
+    if (!property->Write) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+    if (!property->Write(object, wp_data, &value))
+        return false;
+    if (object_class->Write_Notify)
+        object_class->Write_Notify(object, wp_data->object_property, &value);
+
+    return true;
+}
+
+/* Fills the value list with the OBJ_PROP_COV properties, read through
+   their accessors. The list is cut after the last one filled in.
+   Returns false if there is no such object. */
+template <typename DESCR>
+bool object_encode_value_list(
+    const BACnet_Object_Class<DESCR> *object_class,
+    uint32_t object_instance,
+    BACNET_PROPERTY_VALUE * value_list)
+{
+    const BACnet_Object_Property<DESCR> *property;
+    BACNET_READ_PROPERTY_DATA rpdata;
+    BACNET_PROPERTY_VALUE *last = NULL;
+    uint8_t apdu[OBJ_COV_VALUE_MAX];
+    DESCR *object;
+    unsigned i;
+    int len = 0;
+
+    object = object_class->Object(object_instance);
+    if (!object)
+        return false;
+    rpdata.object_type = object_class->Object_Type;
+    rpdata.object_instance = object_instance;
+    rpdata.array_index = BACNET_ARRAY_ALL;
+    for (i = 0; (i < object_class->Property_Count) && value_list; i++) {
+        property = &object_class->Properties[i];
+        if (!(property->Flags & OBJ_PROP_COV))
+            continue;
+        rpdata.object_property = property->Property;
+        rpdata.application_data = apdu;
+        rpdata.application_data_len = sizeof(apdu);
+        len = property->Read(object, &rpdata);
+        if (len <= 0)
+            continue;
+        value_list->propertyIdentifier = property->Property;
+        value_list->propertyArrayIndex = BACNET_ARRAY_ALL;
+        bacapp_decode_application_data(apdu, (unsigned) len,
+            &value_list->value);
+        value_list->priority = BACNET_NO_PRIORITY;
+        last = value_list;
+        value_list = value_list->next;
+    }
+    if (last)
+        last->next = NULL;
+
+    return true;
+}
+
+/* Reads an array property: the number of elements for index 0, else
+   one element or, for BACNET_ARRAY_ALL, all of them. encode_element
+   encodes element 0..count-1 (array index 1..count) to apdu and returns
+   its length. */
+template <typename DESCR>
+int object_read_array(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata,
+    unsigned count,
+    int (*encode_element) (DESCR * object,
+        unsigned element,
+        uint8_t * apdu))
+{
+    uint8_t *apdu = rpdata->application_data;
+    int apdu_len = 0;
+    int len = 0;
+    unsigned i;
+
+    /* Array element zero is the number of elements in the array */
+    if (rpdata->array_index == 0)
+        return encode_application_unsigned(&apdu[0], count);
+    if (rpdata->array_index != BACNET_ARRAY_ALL) {
+        if (rpdata->array_index > count) {
+            rpdata->error_class = ERROR_CLASS_PROPERTY;
+            rpdata->error_code = ERROR_CODE_INVALID_ARRAY_INDEX;
+            return BACNET_STATUS_ERROR;
+        }
+        return encode_element(object, rpdata->array_index - 1, &apdu[0]);
+    }
+    /* if no index was specified, then try to encode the entire list */
+    /* into one packet. */
+    for (i = 0; i < count; i++) {
+        /* FIXME: check if we have room before adding it to APDU */
+        len = encode_element(object, i, &apdu[apdu_len]);
+        /* add it if we have room */
+        if ((apdu_len + len) < MAX_APDU) {
+            apdu_len += len;
+        } else {
+            rpdata->error_class = ERROR_CLASS_SERVICES;
+            rpdata->error_code = ERROR_CODE_NO_SPACE_FOR_OBJECT;
+            return BACNET_STATUS_ERROR;
+        }
+    }
+
+    return apdu_len;
+}
+
+/* Command priority 6 is reserved for use by Minimum On/Off algorithm and
+   may not be used for other purposes in any object. Returns true if
+   wp_data->priority may command a Present_Value. */
+inline bool object_write_priority_valid(
+    BACNET_WRITE_PROPERTY_DATA * wp_data)
+{
+    if (wp_data->priority == 6) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_WRITE_ACCESS_DENIED;
+        return false;
+    }
+    if ((wp_data->priority == 0) ||
+        (wp_data->priority > BACNET_MAX_PRIORITY)) {
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
+        return false;
+    }
+
+    return true;
+}
+
+inline bool object_write_value_out_of_range(
+    BACNET_WRITE_PROPERTY_DATA * wp_data)
+{
+    wp_data->error_class = ERROR_CLASS_PROPERTY;
+    wp_data->error_code = ERROR_CODE_VALUE_OUT_OF_RANGE;
+
+    return false;
+}
+
+/* Writes a new Object_Name into a name buffer of size bytes, e.g. of an
+   object created at runtime. The name must be unique in the device. */
+inline bool object_write_name(
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value,
+    char *name,
+    size_t size)
+{
+    int object_type = 0;
+    uint32_t object_instance = 0;
+
+    if (!WPValidateString(value, (int) (size - 1), false,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    if (Device_Valid_Object_Name(&value->type.Character_String,
+            &object_type, &object_instance)) {
+        if ((object_type == (int) wp_data->object_type) &&
+            (object_instance == wp_data->object_instance))
+            return true;
+        wp_data->error_class = ERROR_CLASS_PROPERTY;
+        wp_data->error_code = ERROR_CODE_DUPLICATE_NAME;
+        return false;
+    }
+    Device_Object_Name_Index_Remove(wp_data->object_type,
+        wp_data->object_instance);
+    characterstring_ansi_copy(name, size, &value->type.Character_String);
+    Device_Object_Name_Index_Add(wp_data->object_type,
+        wp_data->object_instance);
+    Device_Object_Changed(OBJECT_CHANGE_RENAMED, wp_data->object_type,
+        wp_data->object_instance);
+
+    return true;
+}
+
+/* accessors shared by the object types */
+
+template <typename DESCR>
+int object_read_object_identifier(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    (void) object;
+    return encode_application_object_id(&rpdata->application_data[0],
+        rpdata->object_type, rpdata->object_instance);
+}
+
+template <typename DESCR>
+int object_read_object_type(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    (void) object;
+    return encode_application_enumerated(&rpdata->application_data[0],
+        rpdata->object_type);
+}
+
+/* a char * field, e.g. the name or description, copied straight into
+   the apdu */
+template <typename DESCR, char *DESCR::*FIELD>
+int object_read_string(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_ansi_string(&rpdata->application_data[0],
+        object->*FIELD);
+}
+
+inline int object_encode_status_flags(
+    uint8_t * apdu,
+    unsigned event_state,
+    bool out_of_service)
+{
+    BACNET_BIT_STRING bit_string;
+
+    /* note: see the details in the standard on how to use these */
+    bitstring_init(&bit_string);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_IN_ALARM,
+        (event_state != EVENT_STATE_NORMAL) ? true : false);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_FAULT, false);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_OVERRIDDEN, false);
+    bitstring_set_bit(&bit_string, STATUS_FLAG_OUT_OF_SERVICE,
+        out_of_service);
+    return encode_application_bitstring(&apdu[0], &bit_string);
+}
+
+template <typename DESCR>
+int object_read_status_flags(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return object_encode_status_flags(&rpdata->application_data[0],
+        object->Event_State, object->Out_Of_Service);
+}
+
+template <typename DESCR>
+int object_read_event_state(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Event_State);
+}
+
+template <typename DESCR>
+int object_read_reliability(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Reliability);
+}
+
+template <typename DESCR>
+int object_read_out_of_service(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_boolean(&rpdata->application_data[0],
+        object->Out_Of_Service);
+}
+
+template <typename DESCR>
+bool object_write_out_of_service(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_BOOLEAN,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object->Out_Of_Service = value->type.Boolean;
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_units(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Units);
+}
+
+template <typename DESCR>
+bool object_write_units(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_ENUMERATED,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object->Units = value->type.Enumerated;
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_polarity(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Polarity);
+}
+
+template <typename DESCR>
+bool object_write_polarity(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_ENUMERATED,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    if (value->type.Enumerated >= MAX_POLARITY)
+        return object_write_value_out_of_range(wp_data);
+    object->Polarity = (BACNET_POLARITY) value->type.Enumerated;
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_cov_increment(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        object->COV_Increment);
+}
+
+template <typename DESCR>
+bool object_write_cov_increment(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_REAL,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    if (value->type.Real < 0.0f)
+        return object_write_value_out_of_range(wp_data);
+    object->COV_Increment = value->type.Real;
+
+    return true;
+}
+
+#if defined(INTRINSIC_REPORTING)
+/* the intrinsic reporting properties of analog objects */
+
+template <typename DESCR>
+int object_read_time_delay(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_unsigned(&rpdata->application_data[0],
+        object->Time_Delay);
+}
+
+template <typename DESCR>
+bool object_write_time_delay(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object->Time_Delay = value->type.Unsigned_Int;
+    object->Remaining_Time_Delay = object->Time_Delay;
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_notification_class(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_unsigned(&rpdata->application_data[0],
+        object->Notification_Class);
+}
+
+template <typename DESCR>
+bool object_write_notification_class(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_UNSIGNED_INT,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object->Notification_Class = value->type.Unsigned_Int;
+
+    return true;
+}
+
+/* a float field, e.g. High_Limit */
+template <typename DESCR, float DESCR::*FIELD>
+int object_read_real(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_real(&rpdata->application_data[0],
+        object->*FIELD);
+}
+
+template <typename DESCR, float DESCR::*FIELD>
+bool object_write_real(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_REAL,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    object->*FIELD = value->type.Real;
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_limit_enable(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    BACNET_BIT_STRING bit_string;
+
+    bitstring_init(&bit_string);
+    bitstring_set_bit(&bit_string, 0,
+        (object->Limit_Enable & EVENT_LOW_LIMIT_ENABLE) ? true : false);
+    bitstring_set_bit(&bit_string, 1,
+        (object->Limit_Enable & EVENT_HIGH_LIMIT_ENABLE) ? true : false);
+    return encode_application_bitstring(&rpdata->application_data[0],
+        &bit_string);
+}
+
+template <typename DESCR>
+bool object_write_limit_enable(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_BIT_STRING,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    if (value->type.Bit_String.bits_used != 2)
+        return object_write_value_out_of_range(wp_data);
+    object->Limit_Enable = value->type.Bit_String.value[0];
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_event_enable(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    BACNET_BIT_STRING bit_string;
+
+    bitstring_init(&bit_string);
+    bitstring_set_bit(&bit_string, TRANSITION_TO_OFFNORMAL,
+        (object->Event_Enable & EVENT_ENABLE_TO_OFFNORMAL) ? true : false);
+    bitstring_set_bit(&bit_string, TRANSITION_TO_FAULT,
+        (object->Event_Enable & EVENT_ENABLE_TO_FAULT) ? true : false);
+    bitstring_set_bit(&bit_string, TRANSITION_TO_NORMAL,
+        (object->Event_Enable & EVENT_ENABLE_TO_NORMAL) ? true : false);
+    return encode_application_bitstring(&rpdata->application_data[0],
+        &bit_string);
+}
+
+template <typename DESCR>
+bool object_write_event_enable(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_BIT_STRING,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    if (value->type.Bit_String.bits_used != 3)
+        return object_write_value_out_of_range(wp_data);
+    object->Event_Enable = value->type.Bit_String.value[0];
+
+    return true;
+}
+
+template <typename DESCR>
+int object_read_acked_transitions(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    BACNET_BIT_STRING bit_string;
+
+    bitstring_init(&bit_string);
+    bitstring_set_bit(&bit_string, TRANSITION_TO_OFFNORMAL,
+        object->Acked_Transitions[TRANSITION_TO_OFFNORMAL].bIsAcked);
+    bitstring_set_bit(&bit_string, TRANSITION_TO_FAULT,
+        object->Acked_Transitions[TRANSITION_TO_FAULT].bIsAcked);
+    bitstring_set_bit(&bit_string, TRANSITION_TO_NORMAL,
+        object->Acked_Transitions[TRANSITION_TO_NORMAL].bIsAcked);
+    return encode_application_bitstring(&rpdata->application_data[0],
+        &bit_string);
+}
+
+template <typename DESCR>
+int object_read_notify_type(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return encode_application_enumerated(&rpdata->application_data[0],
+        object->Notify_Type ? NOTIFY_EVENT : NOTIFY_ALARM);
+}
+
+template <typename DESCR>
+bool object_write_notify_type(
+    DESCR * object,
+    BACNET_WRITE_PROPERTY_DATA * wp_data,
+    BACNET_APPLICATION_DATA_VALUE * value)
+{
+    if (!WPValidateArgType(value, BACNET_APPLICATION_TAG_ENUMERATED,
+            &wp_data->error_class, &wp_data->error_code))
+        return false;
+    switch ((BACNET_NOTIFY_TYPE) value->type.Enumerated) {
+        case NOTIFY_EVENT:
+            object->Notify_Type = 1;
+            break;
+        case NOTIFY_ALARM:
+            object->Notify_Type = 0;
+            break;
+        default:
+            return object_write_value_out_of_range(wp_data);
+    }
+
+    return true;
+}
+
+template <typename DESCR>
+int object_encode_event_time_stamp(
+    DESCR * object,
+    unsigned element,
+    uint8_t * apdu)
+{
+    int len = 0;
+
+    len = encode_opening_tag(&apdu[0], TIME_STAMP_DATETIME);
+    len +=
+        encode_application_date(&apdu[len],
+        &object->Event_Time_Stamps[element].date);
+    len +=
+        encode_application_time(&apdu[len],
+        &object->Event_Time_Stamps[element].time);
+    len += encode_closing_tag(&apdu[len], TIME_STAMP_DATETIME);
+
+    return len;
+}
+
+template <typename DESCR>
+int object_read_event_time_stamps(
+    DESCR * object,
+    BACNET_READ_PROPERTY_DATA * rpdata)
+{
+    return object_read_array(object, rpdata, MAX_BACNET_EVENT_TRANSITION,
+        object_encode_event_time_stamp<DESCR>);
+}
+#endif /* INTRINSIC_REPORTING */
+
+#endif
@@ -42,6 +42,10 @@
 #include "tsm.h"
 #include "dcc.h"
 #include "iam.h"
+#include "npdu.h"
+#include "datalink.h"
+#include "bacaddr.h"
+#include "peercap.h"
 
 #include "EvRec_BACnet4mbed.h"
 
@@ -376,6 +380,158 @@ void apdu_retries_set(
 }
 
 
+#if (MAX_APDU_RESPONSE_CACHE)
+/* A client retransmits a confirmed request when our reply got lost.
+   The reply is kept for a while, keyed by the source address, the
+   invoke ID and the service choice of the request, so that the
+   retransmission is answered without executing the service twice. */
+typedef struct apdu_response_cache_entry {
+    /* remaining time to live in milliseconds, 0 = unused */
+    uint16_t ttl;
+    BACNET_ADDRESS src;
+    uint8_t invoke_id;
+    uint8_t service_choice;
+    /* signature of the request, guards against reused invoke IDs */
+    uint16_t request_len;
+    uint32_t request_hash;
+    BACNET_NPDU_DATA npdu_data;
+    uint16_t pdu_len;
+    uint8_t pdu[APDU_RESPONSE_CACHE_PDU_SIZE];
+} APDU_RESPONSE_CACHE_ENTRY;
+
+static APDU_RESPONSE_CACHE_ENTRY Response_Cache[MAX_APDU_RESPONSE_CACHE];
+
+/* the confirmed request that is being handled right now */
+static struct {
+    bool valid;
+    BACNET_ADDRESS src;
+    uint8_t invoke_id;
+    uint8_t service_choice;
+    uint16_t request_len;
+    uint32_t request_hash;
+} Response_Pending;
+
+/* FNV-1a */
+static uint32_t apdu_request_hash(
+    uint8_t * request,
+    uint16_t request_len)
+{
+    uint32_t hash = 2166136261UL;
+    uint16_t i = 0;
+
+    for (i = 0; i < request_len; i++) {
+        hash ^= request[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+/* returns MAX_APDU_RESPONSE_CACHE if the request has not been answered */
+static unsigned apdu_response_cache_find(
+    BACNET_ADDRESS * src,
+    uint8_t invoke_id,
+    uint8_t service_choice,
+    uint16_t request_len,
+    uint32_t request_hash)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < MAX_APDU_RESPONSE_CACHE; i++) {
+        if (Response_Cache[i].ttl &&
+            (Response_Cache[i].invoke_id == invoke_id) &&
+            (Response_Cache[i].service_choice == service_choice) &&
+            (Response_Cache[i].request_len == request_len) &&
+            (Response_Cache[i].request_hash == request_hash) &&
+            bacnet_address_same(&Response_Cache[i].src, src)) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/** Keep the reply to the confirmed request currently being handled.
+ *  Called by the confirmed service handlers after sending the reply.
+ * @param dest [in] The address the reply was sent to.
+ * @param npdu_data [in] The network layer info of the reply.
+ * @param pdu [in] The encoded NPDU and APDU of the reply.
+ * @param pdu_len [in] The length of the reply.
+ */
+void apdu_response_cache_store(
+    BACNET_ADDRESS * dest,
+    BACNET_NPDU_DATA * npdu_data,
+    uint8_t * pdu,
+    uint16_t pdu_len)
+{
+    unsigned i = 0;
+    unsigned index = 0;
+    uint16_t j = 0;
+
+    if (!Response_Pending.valid ||
+        !bacnet_address_same(&Response_Pending.src, dest)) {
+        return;
+    }
+    Response_Pending.valid = false;
+    if (pdu_len > APDU_RESPONSE_CACHE_PDU_SIZE) {
+        return;
+    }
+    /* replace the entry closest to expiring */
+    for (i = 1; i < MAX_APDU_RESPONSE_CACHE; i++) {
+        if (Response_Cache[i].ttl < Response_Cache[index].ttl) {
+            index = i;
+        }
+    }
+    bacnet_address_copy(&Response_Cache[index].src, dest);
+    Response_Cache[index].invoke_id = Response_Pending.invoke_id;
+    Response_Cache[index].service_choice = Response_Pending.service_choice;
+    Response_Cache[index].request_len = Response_Pending.request_len;
+    Response_Cache[index].request_hash = Response_Pending.request_hash;
+    npdu_copy_data(&Response_Cache[index].npdu_data, npdu_data);
+    for (j = 0; j < pdu_len; j++) {
+        Response_Cache[index].pdu[j] = pdu[j];
+    }
+    Response_Cache[index].pdu_len = pdu_len;
+    /* a retransmission of the client arrives within its APDU timeout,
+       so an older entry could only answer a new request that reuses
+       the invoke ID, with a stale reply */
+    Response_Cache[index].ttl = apdu_timeout();
+}
+
+/* called once a millisecond or slower */
+void apdu_response_cache_timer_milliseconds(
+    uint16_t milliseconds)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < MAX_APDU_RESPONSE_CACHE; i++) {
+        if (Response_Cache[i].ttl > milliseconds) {
+            Response_Cache[i].ttl -= milliseconds;
+        } else {
+            Response_Cache[i].ttl = 0;
+        }
+    }
+}
+#else
+void apdu_response_cache_store(
+    BACNET_ADDRESS * dest,
+    BACNET_NPDU_DATA * npdu_data,
+    uint8_t * pdu,
+    uint16_t pdu_len)
+{
+    (void) dest;
+    (void) npdu_data;
+    (void) pdu;
+    (void) pdu_len;
+}
+
+void apdu_response_cache_timer_milliseconds(
+    uint16_t milliseconds)
+{
+    (void) milliseconds;
+}
+#endif
+
 /* When network communications are completely disabled,
    only DeviceCommunicationControl and ReinitializeDevice APDUs
    shall be processed and no messages shall be initiated.
@@ -458,6 +614,14 @@ void apdu_handler(
     uint32_t error_class = 0;
     uint8_t reason = 0;
     bool server = false;
+#if (MAX_APDU_RESPONSE_CACHE)
+    uint32_t request_hash = 0;
+    unsigned index = 0;
+#endif
+    uint32_t device_id = 0;
+    unsigned max_apdu = 0;
+    int segmentation = 0;
+    uint16_t vendor_id = 0;
 
     if (apdu) {
         /* PDU Type */
@@ -467,12 +631,34 @@ void apdu_handler(
                 (void)apdu_decode_confirmed_service_request(&apdu[0],
                     apdu_len, &service_data, &service_choice, &service_request,
                     &service_request_len);
+                /* remember what the peer accepts in replies */
+                peercap_update_from_request(src, &service_data);
                 if (apdu_confirmed_dcc_disabled(service_choice)) {
                     /* When network communications are completely disabled,
                        only DeviceCommunicationControl and ReinitializeDevice APDUs
                        shall be processed and no messages shall be initiated. */
                     break;
                 }
+#if (MAX_APDU_RESPONSE_CACHE)
+                request_hash =
+                    apdu_request_hash(service_request, service_request_len);
+                index =
+                    apdu_response_cache_find(src, service_data.invoke_id,
+                    service_choice, service_request_len, request_hash);
+                if (index < MAX_APDU_RESPONSE_CACHE) {
+                    /* retransmitted request - resend the reply we gave */
+                    datalink_send_pdu(src, &Response_Cache[index].npdu_data,
+                        &Response_Cache[index].pdu[0],
+                        Response_Cache[index].pdu_len);
+                    break;
+                }
+                bacnet_address_copy(&Response_Pending.src, src);
+                Response_Pending.invoke_id = service_data.invoke_id;
+                Response_Pending.service_choice = service_choice;
+                Response_Pending.request_len = service_request_len;
+                Response_Pending.request_hash = request_hash;
+                Response_Pending.valid = true;
+#endif
                 if ((service_choice < MAX_BACNET_CONFIRMED_SERVICE) &&
                     (Confirmed_Function[service_choice]))
                     Confirmed_Function[service_choice] (service_request,
@@ -480,12 +666,21 @@ void apdu_handler(
                 else if (Unrecognized_Service_Handler)
                     Unrecognized_Service_Handler(service_request,
                         service_request_len, src, &service_data);
+#if (MAX_APDU_RESPONSE_CACHE)
+                Response_Pending.valid = false;
+#endif
                 break;
             case PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST:
 							EVRECORD2(BACNET_PDU_TYPE_CONFIRMED, PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST, 0);
                 service_choice = apdu[1];
                 service_request = &apdu[2];
                 service_request_len = apdu_len - 2;
+                if ((service_choice == SERVICE_UNCONFIRMED_I_AM) &&
+                    (iam_decode_service_request(service_request, &device_id,
+                            &max_apdu, &segmentation, &vendor_id) > 0)) {
+                    peercap_update_from_i_am(device_id, max_apdu,
+                        segmentation, src);
+                }
                 if (apdu_unconfirmed_dcc_disabled(service_choice)) {
                     /* When network communications are disabled,
                        only DeviceCommunicationControl and ReinitializeDevice APDUs
@@ -625,6 +820,10 @@ void apdu_handler(
                             (BACNET_ERROR_CLASS) error_class,
                             (BACNET_ERROR_CODE) error_code);
                 }
+                if (error_class == ERROR_CLASS_RESOURCES) {
+                    /* the peer is busy - send it fewer requests at once */
+                    tsm_invoke_id_busy(invoke_id, src);
+                }
                 tsm_free_invoke_id(invoke_id);
                 break;
             case PDU_TYPE_REJECT:
@@ -642,6 +841,15 @@ void apdu_handler(
                 reason = apdu[2];
                 if (Abort_Function)
                     Abort_Function(src, invoke_id, reason, server);
+                if (server &&
+                    ((reason == ABORT_REASON_BUFFER_OVERFLOW) ||
+                        (reason ==
+                            ABORT_REASON_PREEMPTED_BY_HIGHER_PRIORITY_TASK))) {
+                    /* the peer is busy with our request - send it fewer
+                       requests at once; an abort from a client is about
+                       a transaction of its own */
+                    tsm_invoke_id_busy(invoke_id, src);
+                }
                 tsm_free_invoke_id(invoke_id);
                 break;
             default:
@@ -1046,6 +1046,41 @@ int encode_application_character_string(
     return len;
 }
 
+/* An ANSI X3.4 application tagged character string straight from a
+   C string, without going through a BACNET_CHARACTER_STRING: that one
+   is cleared in full (MAX_CHARACTER_STRING_BYTES) by each init, which
+   made every read of a name or description that expensive.
+   Like characterstring_init_ansi(), a string longer than a
+   BACNET_CHARACTER_STRING can hold is encoded as empty string.
+   returns the number of apdu bytes consumed, 0 if it does not fit */
+int encode_application_ansi_string(
+    uint8_t * apdu,
+    const char *value)
+{
+    int len = 0;
+    size_t length = 0;
+
+    if (value) {
+        length = strlen(value);
+        if (length > (MAX_CHARACTER_STRING_BYTES - 1)) {
+            length = 0;
+        }
+    }
+    len =
+        encode_tag(&apdu[0], BACNET_APPLICATION_TAG_CHARACTER_STRING, false,
+        (uint32_t) (length + 1));
+    if ((len + length + 1) < MAX_APDU) {
+        len +=
+            (int) encode_bacnet_character_string_safe(&apdu[len],
+            MAX_APDU - len, CHARACTER_ANSI_X34, (char *) value,
+            (uint32_t) length);
+    } else {
+        len = 0;
+    }
+
+    return len;
+}
+
 int encode_context_character_string(
     uint8_t * apdu,
     uint8_t tag_number,
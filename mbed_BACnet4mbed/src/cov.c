@@ -32,6 +32,7 @@
  -------------------------------------------
 ####COPYRIGHTEND####*/
 #include <stdint.h>
+#include <string.h>
 #include "bacenum.h"
 #include "bacdcode.h"
 #include "bacdef.h"
@@ -46,84 +47,118 @@ COV Subscribe Property
 COV Notification
 Unconfirmed COV Notification
 */
-static int notify_encode_apdu(
+/* the fields before the list of values, they differ by subscriber */
+static int notify_encode_header(
     uint8_t * apdu,
     BACNET_COV_DATA * data)
 {
     int len = 0;        /* length of each encoding */
     int apdu_len = 0;   /* total length of the apdu, return value */
-    BACNET_PROPERTY_VALUE *value = NULL;        /* value in list */
+
+    /* tag 0 - subscriberProcessIdentifier */
+    len =
+        encode_context_unsigned(&apdu[apdu_len], 0,
+        data->subscriberProcessIdentifier);
+    apdu_len += len;
+    /* tag 1 - initiatingDeviceIdentifier */
+    len =
+        encode_context_object_id(&apdu[apdu_len], 1, OBJECT_DEVICE,
+        data->initiatingDeviceIdentifier);
+    apdu_len += len;
+    /* tag 2 - monitoredObjectIdentifier */
+    len =
+        encode_context_object_id(&apdu[apdu_len], 2,
+        (int) data->monitoredObjectIdentifier.type,
+        data->monitoredObjectIdentifier.instance);
+    apdu_len += len;
+    /* tag 3 - timeRemaining */
+    len = encode_context_unsigned(&apdu[apdu_len], 3, data->timeRemaining);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+/** Encode the list of values of a COV notification, tag 4.
+ * The encoding is the same for every subscriber of the object, so it
+ * can be encoded once and passed to ucov_notify_encode_apdu_values()
+ * or ccov_notify_encode_apdu_values() for each of them.
+ * @param apdu [out] The buffer for the encoding.
+ * @param value [in] The first value of the list.
+ * @return The length of the encoding.
+ */
+int cov_notify_encode_values(
+    uint8_t * apdu,
+    BACNET_PROPERTY_VALUE * value)
+{
+    int len = 0;        /* length of each encoding */
+    int apdu_len = 0;   /* total length of the apdu, return value */
 	BACNET_APPLICATION_DATA_VALUE *app_data = NULL;
 
-    if (apdu) {
-        /* tag 0 - subscriberProcessIdentifier */
-        len =
-            encode_context_unsigned(&apdu[apdu_len], 0,
-            data->subscriberProcessIdentifier);
-        apdu_len += len;
-        /* tag 1 - initiatingDeviceIdentifier */
-        len =
-            encode_context_object_id(&apdu[apdu_len], 1, OBJECT_DEVICE,
-            data->initiatingDeviceIdentifier);
-        apdu_len += len;
-        /* tag 2 - monitoredObjectIdentifier */
+    if (!apdu) {
+        return 0;
+    }
+    /* tag 4 - listOfValues */
+    len = encode_opening_tag(&apdu[apdu_len], 4);
+    apdu_len += len;
+    /* the first value includes a pointer to the next value, etc */
+    /* FIXME: for small implementations, we might try a partial
+       approach like the rpm.c where the values are encoded with
+       a separate function */
+    while (value != NULL) {
+        /* tag 0 - propertyIdentifier */
         len =
-            encode_context_object_id(&apdu[apdu_len], 2,
-            (int) data->monitoredObjectIdentifier.type,
-            data->monitoredObjectIdentifier.instance);
-        apdu_len += len;
-        /* tag 3 - timeRemaining */
-        len = encode_context_unsigned(&apdu[apdu_len], 3, data->timeRemaining);
-        apdu_len += len;
-        /* tag 4 - listOfValues */
-        len = encode_opening_tag(&apdu[apdu_len], 4);
+            encode_context_enumerated(&apdu[apdu_len], 0,
+            value->propertyIdentifier);
         apdu_len += len;
-        /* the first value includes a pointer to the next value, etc */
-        /* FIXME: for small implementations, we might try a partial
-           approach like the rpm.c where the values are encoded with
-           a separate function */
-        value = data->listOfValues;
-        while (value != NULL) {
-            /* tag 0 - propertyIdentifier */
+        /* tag 1 - propertyArrayIndex OPTIONAL */
+        if (value->propertyArrayIndex != BACNET_ARRAY_ALL) {
             len =
-                encode_context_enumerated(&apdu[apdu_len], 0,
-                value->propertyIdentifier);
+                encode_context_unsigned(&apdu[apdu_len], 1,
+                value->propertyArrayIndex);
             apdu_len += len;
-            /* tag 1 - propertyArrayIndex OPTIONAL */
-            if (value->propertyArrayIndex != BACNET_ARRAY_ALL) {
-                len =
-                    encode_context_unsigned(&apdu[apdu_len], 1,
-                    value->propertyArrayIndex);
-                apdu_len += len;
-            }
-            /* tag 2 - value */
-            /* abstract syntax gets enclosed in a context tag */
-            len = encode_opening_tag(&apdu[apdu_len], 2);
+        }
+        /* tag 2 - value */
+        /* abstract syntax gets enclosed in a context tag */
+        len = encode_opening_tag(&apdu[apdu_len], 2);
+        apdu_len += len;
+        app_data = &value->value;
+		while (app_data != NULL)
+		{
+            len =
+            bacapp_encode_application_data(&apdu[apdu_len], app_data);
             apdu_len += len;
-            app_data = &value->value;
-			while (app_data != NULL)
-			{
-                len =
-                bacapp_encode_application_data(&apdu[apdu_len], app_data);
-                apdu_len += len;
-				app_data = app_data->next;
-            }
+			app_data = app_data->next;
+        }
 
-            len = encode_closing_tag(&apdu[apdu_len], 2);
+        len = encode_closing_tag(&apdu[apdu_len], 2);
+        apdu_len += len;
+        /* tag 3 - priority OPTIONAL */
+        if (value->priority != BACNET_NO_PRIORITY) {
+            len =
+                encode_context_unsigned(&apdu[apdu_len], 3,
+                value->priority);
             apdu_len += len;
-            /* tag 3 - priority OPTIONAL */
-            if (value->priority != BACNET_NO_PRIORITY) {
-                len =
-                    encode_context_unsigned(&apdu[apdu_len], 3,
-                    value->priority);
-                apdu_len += len;
-            }
-            /* is there another one to encode? */
-            /* FIXME: check to see if there is room in the APDU */
-            value = value->next;
         }
-        len = encode_closing_tag(&apdu[apdu_len], 4);
-        apdu_len += len;
+        /* is there another one to encode? */
+        /* FIXME: check to see if there is room in the APDU */
+        value = value->next;
+    }
+    len = encode_closing_tag(&apdu[apdu_len], 4);
+    apdu_len += len;
+
+    return apdu_len;
+}
+
+static int notify_encode_apdu(
+    uint8_t * apdu,
+    BACNET_COV_DATA * data)
+{
+    int apdu_len = 0;   /* total length of the apdu, return value */
+
+    if (apdu) {
+        apdu_len = notify_encode_header(&apdu[0], data);
+        apdu_len +=
+            cov_notify_encode_values(&apdu[apdu_len], data->listOfValues);
     }
 
     return apdu_len;
@@ -168,6 +203,66 @@ int ucov_notify_encode_apdu(
     return apdu_len;
 }
 
+/** Encode a confirmed COV notification around a list of values encoded
+ * by cov_notify_encode_values(); data->listOfValues is not used.
+ * @param apdu [out] The buffer for the encoding.
+ * @param invoke_id [in] The invoke id of the request.
+ * @param data [in] The fields of the notification for one subscriber.
+ * @param values [in] The encoded list of values.
+ * @param values_len [in] The length of the encoded list of values.
+ * @return The length of the encoding.
+ */
+int ccov_notify_encode_apdu_values(
+    uint8_t * apdu,
+    uint8_t invoke_id,
+    BACNET_COV_DATA * data,
+    uint8_t * values,
+    unsigned values_len)
+{
+    int apdu_len = 0;   /* total length of the apdu, return value */
+
+    if (apdu && data && values) {
+        apdu[0] = PDU_TYPE_CONFIRMED_SERVICE_REQUEST;
+        apdu[1] = encode_max_segs_max_apdu(0, MAX_APDU);
+        apdu[2] = invoke_id;
+        apdu[3] = SERVICE_CONFIRMED_COV_NOTIFICATION;
+        apdu_len = 4;
+        apdu_len += notify_encode_header(&apdu[apdu_len], data);
+        memcpy(&apdu[apdu_len], values, values_len);
+        apdu_len += (int) values_len;
+    }
+
+    return apdu_len;
+}
+
+/** Encode an unconfirmed COV notification around a list of values
+ * encoded by cov_notify_encode_values(); data->listOfValues is not used.
+ * @param apdu [out] The buffer for the encoding.
+ * @param data [in] The fields of the notification for one subscriber.
+ * @param values [in] The encoded list of values.
+ * @param values_len [in] The length of the encoded list of values.
+ * @return The length of the encoding.
+ */
+int ucov_notify_encode_apdu_values(
+    uint8_t * apdu,
+    BACNET_COV_DATA * data,
+    uint8_t * values,
+    unsigned values_len)
+{
+    int apdu_len = 0;   /* total length of the apdu, return value */
+
+    if (apdu && data && values) {
+        apdu[0] = PDU_TYPE_UNCONFIRMED_SERVICE_REQUEST;
+        apdu[1] = SERVICE_UNCONFIRMED_COV_NOTIFICATION; /* service choice */
+        apdu_len = 2;
+        apdu_len += notify_encode_header(&apdu[apdu_len], data);
+        memcpy(&apdu[apdu_len], values, values_len);
+        apdu_len += (int) values_len;
+    }
+
+    return apdu_len;
+}
+
 /* decode the service request only */
 /* COV and Unconfirmed COV are the same */
 int cov_notify_decode_service_request(
@@ -0,0 +1,147 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "covstore.h"
+#if defined(KVSTORE_ENABLED) && KVSTORE_ENABLED
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+#else
+#include <stdio.h>
+#endif
+
+/** @file covstore.c  Non volatile record of the COV subscriptions */
+
+#if defined(KVSTORE_ENABLED) && KVSTORE_ENABLED
+
+/** Replace the stored record.
+ * @param data [in] The record.
+ * @param size [in] The size of the record, 0 removes it.
+ * @return true if the record is stored.
+ */
+bool cov_store_save(
+    const void *data,
+    size_t size)
+{
+    if (!size) {
+        (void) kv_remove(COV_STORE_KEY);
+        return true;
+    }
+
+    return kv_set(COV_STORE_KEY, data, size, 0) == MBED_SUCCESS;
+}
+
+/** Get the size of the stored record.
+ * @return The size, 0 if there is none.
+ */
+size_t cov_store_size(
+    void)
+{
+    kv_info_t info;
+
+    if (kv_get_info(COV_STORE_KEY, &info) != MBED_SUCCESS) {
+        return 0;
+    }
+
+    return info.size;
+}
+
+/** Read the stored record.
+ * @param data [out] The buffer for the record.
+ * @param size [in] The size of the record, see cov_store_size().
+ * @return true if the whole record was read.
+ */
+bool cov_store_load(
+    void *data,
+    size_t size)
+{
+    size_t actual_size = 0;
+
+    if (kv_get(COV_STORE_KEY, data, size, &actual_size) != MBED_SUCCESS) {
+        return false;
+    }
+
+    return actual_size == size;
+}
+
+#else
+
+bool cov_store_save(
+    const void *data,
+    size_t size)
+{
+    FILE *file = NULL;
+    bool status = false;
+
+    if (!size) {
+        (void) remove(COV_STORE_FILE);
+        return true;
+    }
+    file = fopen(COV_STORE_FILE, "wb");
+    if (file) {
+        status = (fwrite(data, 1, size, file) == size);
+        status = (fclose(file) == 0) && status;
+    }
+
+    return status;
+}
+
+size_t cov_store_size(
+    void)
+{
+    FILE *file = NULL;
+    long size = 0;
+
+    file = fopen(COV_STORE_FILE, "rb");
+    if (!file) {
+        return 0;
+    }
+    if (fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    fclose(file);
+
+    return (size > 0) ? (size_t) size : 0;
+}
+
+bool cov_store_load(
+    void *data,
+    size_t size)
+{
+    FILE *file = NULL;
+    bool status = false;
+
+    file = fopen(COV_STORE_FILE, "rb");
+    if (file) {
+        status = (fread(data, 1, size, file) == size);
+        fclose(file);
+    }
+
+    return status;
+}
+
+#endif
@@ -0,0 +1,216 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdint.h>
+#include "bacenum.h"
+#include "bacdcode.h"
+#include "bacdef.h"
+#include "bacapp.h"
+#include "create_object.h"
+
+/** @file create_object.c  Encode/Decode CreateObject APDUs */
+
+/* decode the service request only */
+int create_object_decode_service_request(
+    uint8_t * apdu,
+    unsigned apdu_len,
+    BACNET_CREATE_OBJECT_DATA * data)
+{
+    int len = 0;
+    uint8_t tag_number = 0;
+    uint32_t len_value_type = 0;
+    uint32_t enum_value = 0;
+    uint16_t type = 0;
+
+    if (!apdu || !apdu_len || !data) {
+        return -1;
+    }
+    data->object_instance = CREATE_OBJECT_ANY_INSTANCE;
+    data->initial_values = NULL;
+    data->initial_values_len = 0;
+    data->first_failed_element = 0;
+    /* Tag 0: objectSpecifier */
+    if (!decode_is_opening_tag_number(&apdu[len], 0))
+        return -1;
+    len++;
+    len +=
+        decode_tag_number_and_value(&apdu[len], &tag_number, &len_value_type);
+    if (tag_number == 0) {
+        /* objectType, the device chooses the instance */
+        len += decode_enumerated(&apdu[len], len_value_type, &enum_value);
+        data->object_type = (BACNET_OBJECT_TYPE) enum_value;
+    } else if (tag_number == 1) {
+        /* objectIdentifier */
+        len += decode_object_id(&apdu[len], &type, &data->object_instance);
+        data->object_type = (BACNET_OBJECT_TYPE) type;
+    } else {
+        return -1;
+    }
+    if ((unsigned) len >= apdu_len)
+        return -1;
+    if (!decode_is_closing_tag_number(&apdu[len], 0))
+        return -1;
+    len++;
+    /* Tag 1: listOfInitialValues - optional, the last element */
+    if ((unsigned) len < apdu_len) {
+        if (!decode_is_opening_tag_number(&apdu[len], 1))
+            return -1;
+        len++;
+        if (((unsigned) len >= apdu_len) ||
+            !decode_is_closing_tag_number(&apdu[apdu_len - 1], 1))
+            return -1;
+        data->initial_values = &apdu[len];
+        data->initial_values_len = apdu_len - len - 1;
+        len = apdu_len;
+    }
+
+    return len;
+}
+
+/* decode one BACnetPropertyValue, returns its length or -1 on error */
+int create_object_decode_initial_value(
+    uint8_t * apdu,
+    unsigned apdu_len,
+    BACNET_WRITE_PROPERTY_DATA * wp_data)
+{
+    int len = 0;
+    int tag_len = 0;
+    int data_len = 0;
+    uint8_t tag_number = 0;
+    uint32_t len_value_type = 0;
+    uint32_t property = 0;
+    uint32_t unsigned_value = 0;
+    int i = 0;
+
+    if (!apdu || !apdu_len || !wp_data) {
+        return -1;
+    }
+    /* Tag 0: propertyIdentifier */
+    if (!decode_is_context_tag(&apdu[len], 0))
+        return -1;
+    len +=
+        decode_tag_number_and_value(&apdu[len], &tag_number, &len_value_type);
+    len += decode_enumerated(&apdu[len], len_value_type, &property);
+    wp_data->object_property = (BACNET_PROPERTY_ID) property;
+    /* Tag 1: propertyArrayIndex - optional */
+    wp_data->array_index = BACNET_ARRAY_ALL;
+    if ((unsigned) len >= apdu_len)
+        return -1;
+    if (decode_is_context_tag(&apdu[len], 1) &&
+        !decode_is_closing_tag(&apdu[len])) {
+        len +=
+            decode_tag_number_and_value(&apdu[len], &tag_number,
+            &len_value_type);
+        len += decode_unsigned(&apdu[len], len_value_type, &unsigned_value);
+        wp_data->array_index = unsigned_value;
+    }
+    /* Tag 2: value */
+    if (((unsigned) len >= apdu_len) ||
+        !decode_is_opening_tag_number(&apdu[len], 2))
+        return -1;
+    data_len =
+        bacapp_data_len(&apdu[len], apdu_len - len,
+        (BACNET_PROPERTY_ID) property);
+    if ((data_len < 0) || (data_len > MAX_APDU))
+        return -1;
+    /* a tag number of 2 is not extended so only one octet */
+    len++;
+    for (i = 0; i < data_len; i++) {
+        wp_data->application_data[i] = apdu[len + i];
+    }
+    wp_data->application_data_len = data_len;
+    len += data_len;
+    if (((unsigned) len >= apdu_len) ||
+        !decode_is_closing_tag_number(&apdu[len], 2))
+        return -1;
+    len++;
+    /* Tag 3: priority - optional */
+    wp_data->priority = BACNET_MAX_PRIORITY;
+    if (((unsigned) len < apdu_len) && decode_is_context_tag(&apdu[len], 3)
+        && !decode_is_closing_tag(&apdu[len])) {
+        tag_len =
+            decode_tag_number_and_value(&apdu[len], &tag_number,
+            &len_value_type);
+        len += tag_len;
+        len += decode_unsigned(&apdu[len], len_value_type, &unsigned_value);
+        if ((unsigned_value < BACNET_MIN_PRIORITY) ||
+            (unsigned_value > BACNET_MAX_PRIORITY))
+            return -1;
+        wp_data->priority = (uint8_t) unsigned_value;
+    }
+
+    return len;
+}
+
+/* CreateObject-ACK: the BACnetObjectIdentifier of the new object */
+int create_object_ack_encode_apdu(
+    uint8_t * apdu,
+    uint8_t invoke_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance)
+{
+    int apdu_len = 0;   /* total length of the apdu, return value */
+
+    if (apdu) {
+        apdu[0] = PDU_TYPE_COMPLEX_ACK;
+        apdu[1] = invoke_id;
+        apdu[2] = SERVICE_CONFIRMED_CREATE_OBJECT;
+        apdu_len = 3;
+        apdu_len +=
+            encode_application_object_id(&apdu[apdu_len], object_type,
+            object_instance);
+    }
+
+    return apdu_len;
+}
+
+/* CreateObject-Error: the error and the first failed initial value */
+int create_object_error_encode_apdu(
+    uint8_t * apdu,
+    uint8_t invoke_id,
+    BACNET_ERROR_CLASS error_class,
+    BACNET_ERROR_CODE error_code,
+    uint32_t first_failed_element)
+{
+    int apdu_len = 0;   /* total length of the apdu, return value */
+
+    if (apdu) {
+        apdu[0] = PDU_TYPE_ERROR;
+        apdu[1] = invoke_id;
+        apdu[2] = SERVICE_CONFIRMED_CREATE_OBJECT;
+        apdu_len = 3;
+        /* errorType */
+        apdu_len += encode_opening_tag(&apdu[apdu_len], 0);
+        apdu_len +=
+            encode_application_enumerated(&apdu[apdu_len], error_class);
+        apdu_len += encode_application_enumerated(&apdu[apdu_len], error_code);
+        apdu_len += encode_closing_tag(&apdu[apdu_len], 0);
+        /* firstFailedElementNumber */
+        apdu_len +=
+            encode_context_unsigned(&apdu[apdu_len], 1, first_failed_element);
+    }
+
+    return apdu_len;
+}
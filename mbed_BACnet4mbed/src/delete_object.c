@@ -0,0 +1,60 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdint.h>
+#include "bacenum.h"
+#include "bacdcode.h"
+#include "bacdef.h"
+#include "delete_object.h"
+
+/** @file delete_object.c  Encode/Decode DeleteObject APDUs */
+
+/* decode the service request only */
+int delete_object_decode_service_request(
+    uint8_t * apdu,
+    unsigned apdu_len,
+    BACNET_DELETE_OBJECT_DATA * data)
+{
+    int len = 0;
+    uint8_t tag_number = 0;
+    uint32_t len_value_type = 0;
+    uint16_t type = 0;
+
+    if (!apdu || !apdu_len || !data) {
+        return -1;
+    }
+    /* objectIdentifier, application tagged */
+    len =
+        decode_tag_number_and_value(&apdu[0], &tag_number, &len_value_type);
+    if (IS_CONTEXT_SPECIFIC(apdu[0]) ||
+        (tag_number != BACNET_APPLICATION_TAG_OBJECT_ID))
+        return -1;
+    len += decode_object_id(&apdu[len], &type, &data->object_instance);
+    data->object_type = (BACNET_OBJECT_TYPE) type;
+    if ((unsigned) len != apdu_len)
+        return -1;
+
+    return len;
+}
@@ -0,0 +1,397 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "config_bacnet.h"
+#include "bacdef.h"
+#include "objindex.h"
+
+/** @file objindex.c  Instance number to descriptor index lookup */
+
+/* The object modules keep their objects in a descriptor array. Looking
+   up an instance used to be a scan of that array on every property
+   access; the index makes it a single hash probe in the common case. */
+
+static uint32_t object_index_hash(
+    OBJECT_INDEX * object_index,
+    uint32_t instance)
+{
+    if (object_index->dense) {
+        return (instance - object_index->base) & object_index->mask;
+    }
+
+    return (uint32_t) (instance * 2654435761UL) >> object_index->shift;
+}
+
+/* the index of an instance when there are no slots,
+   returns object_index->count if not found */
+static unsigned object_index_scan(
+    OBJECT_INDEX * object_index,
+    uint32_t instance)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < object_index->count; i++) {
+        if (object_index->index_to_instance(i) == instance) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/** Release the slots of an index, all lookups miss afterwards.
+ * @param object_index [in] The index to clear.
+ */
+void object_index_clear(
+    OBJECT_INDEX * object_index)
+{
+    if (object_index) {
+        free(object_index->slots);
+        object_index->slots = NULL;
+        object_index->index_to_instance = NULL;
+        object_index->mask = 0;
+        object_index->base = 0;
+        object_index->shift = 0;
+        object_index->count = 0;
+        object_index->dense = false;
+    }
+}
+
+/** Build the index of the instances of an object type.
+ *  The table gets at least twice as many slots as the capacity, so the
+ *  probe sequences stay short. The hash is chosen from the instances
+ *  present: a compact range uses the instance offset directly.
+ * @param object_index [in] The index to build.
+ * @param capacity [in] The max number of instances that will be added.
+ * @param count [in] Number of instances present, at index 0 to count-1.
+ * @param index_to_instance [in] Returns the instance of an index.
+ * @return true if every instance is indexed, false if an instance is
+ *         used twice (the first one is indexed then), or if out of memory;
+ *         the index scans the descriptors then, which is slower but
+ *         finds every instance.
+ */
+bool object_index_build(
+    OBJECT_INDEX * object_index,
+    unsigned capacity,
+    unsigned count,
+    object_index_instance_function index_to_instance)
+{
+    uint32_t slots = 4;
+    uint8_t bits = 2;
+    uint32_t instance = 0;
+    uint32_t lowest = BACNET_MAX_INSTANCE;
+    uint32_t highest = 0;
+    unsigned i = 0;
+    bool status = true;
+
+    if (!object_index || !index_to_instance) {
+        return false;
+    }
+    object_index_clear(object_index);
+    if (count > UINT16_MAX) {
+        return false;
+    }
+    object_index->index_to_instance = index_to_instance;
+    if (capacity < count) {
+        capacity = count;
+    }
+    if (capacity > UINT16_MAX) {
+        capacity = UINT16_MAX;
+    }
+    while (slots < (2 * capacity)) {
+        slots <<= 1;
+        bits++;
+    }
+    object_index->slots =
+        (OBJECT_INDEX_SLOT *) malloc(slots * sizeof(OBJECT_INDEX_SLOT));
+    if (!object_index->slots) {
+        object_index->count = (uint16_t) count;
+        return false;
+    }
+    for (i = 0; i < slots; i++) {
+        object_index->slots[i].instance = OBJECT_INDEX_EMPTY;
+        object_index->slots[i].index = 0;
+    }
+    object_index->mask = slots - 1;
+    object_index->shift = 32 - bits;
+    for (i = 0; i < count; i++) {
+        instance = index_to_instance(i);
+        if (instance < lowest) {
+            lowest = instance;
+        }
+        if (instance > highest) {
+            highest = instance;
+        }
+    }
+    if (count && ((highest - lowest) < slots)) {
+        object_index->dense = true;
+        object_index->base = lowest;
+    }
+    for (i = 0; i < count; i++) {
+        if (!object_index_add(object_index, index_to_instance(i), i)) {
+            status = false;
+        }
+    }
+
+    return status;
+}
+
+/** Add an instance to the index.
+ * @param object_index [in] The index to add to.
+ * @param instance [in] The object instance.
+ * @param index [in] The index of its descriptor.
+ * @return true if added, false if the instance is already indexed
+ *         or the index is full.
+ */
+bool object_index_add(
+    OBJECT_INDEX * object_index,
+    uint32_t instance,
+    unsigned index)
+{
+    uint32_t slot = 0;
+
+    if (!object_index || (instance > BACNET_MAX_INSTANCE)) {
+        return false;
+    }
+    if (!object_index->slots) {
+        /* the descriptor may already be in place, so a duplicate is not
+           detected: the object modules check the instance beforehand */
+        if (!object_index->index_to_instance ||
+            (object_index->count == UINT16_MAX)) {
+            return false;
+        }
+        object_index->count++;
+        return true;
+    }
+    if (object_index->count >= ((object_index->mask + 1) / 2)) {
+        return false;
+    }
+    slot = object_index_hash(object_index, instance);
+    while (object_index->slots[slot].instance != OBJECT_INDEX_EMPTY) {
+        if (object_index->slots[slot].instance == instance) {
+            return false;
+        }
+        slot = (slot + 1) & object_index->mask;
+    }
+    object_index->slots[slot].instance = instance;
+    object_index->slots[slot].index = (uint16_t) index;
+    object_index->count++;
+
+    return true;
+}
+
+/** Remove an instance from the index.
+ *  The entries behind it in the probe sequence are moved up, so no
+ *  deleted markers are needed and lookups stay as short as after a build.
+ * @param object_index [in] The index to remove from.
+ * @param instance [in] The object instance.
+ * @return true if removed, false if the instance was not indexed.
+ */
+bool object_index_remove(
+    OBJECT_INDEX * object_index,
+    uint32_t instance)
+{
+    uint32_t hole = 0;
+    uint32_t slot = 0;
+    uint32_t home = 0;
+
+    if (!object_index) {
+        return false;
+    }
+    if (!object_index->slots) {
+        if (!object_index->index_to_instance ||
+            (object_index_scan(object_index,
+                    instance) == object_index->count)) {
+            return false;
+        }
+        object_index->count--;
+        return true;
+    }
+    hole = object_index_hash(object_index, instance);
+    while (object_index->slots[hole].instance != instance) {
+        if (object_index->slots[hole].instance == OBJECT_INDEX_EMPTY) {
+            return false;
+        }
+        hole = (hole + 1) & object_index->mask;
+    }
+    slot = hole;
+    for (;;) {
+        slot = (slot + 1) & object_index->mask;
+        if (object_index->slots[slot].instance == OBJECT_INDEX_EMPTY) {
+            break;
+        }
+        home =
+            object_index_hash(object_index,
+            object_index->slots[slot].instance);
+        /* move the entry into the hole unless its home slot lies
+           cyclically after the hole, up to the entry itself */
+        if (((slot - home) & object_index->mask) >=
+            ((slot - hole) & object_index->mask)) {
+            object_index->slots[hole] = object_index->slots[slot];
+            hole = slot;
+        }
+    }
+    object_index->slots[hole].instance = OBJECT_INDEX_EMPTY;
+    object_index->count--;
+
+    return true;
+}
+
+/** Look up the descriptor index of an instance.
+ * @param object_index [in] The index to search.
+ * @param instance [in] The object instance.
+ * @param index [out] The index of its descriptor.
+ * @return true if found.
+ */
+bool object_index_find(
+    OBJECT_INDEX * object_index,
+    uint32_t instance,
+    unsigned *index)
+{
+    uint32_t slot = 0;
+    unsigned i = 0;
+
+    if (!object_index) {
+        return false;
+    }
+    if (!object_index->slots) {
+        if (!object_index->index_to_instance) {
+            return false;
+        }
+        i = object_index_scan(object_index, instance);
+        if (i == object_index->count) {
+            return false;
+        }
+        if (index) {
+            *index = i;
+        }
+        return true;
+    }
+    slot = object_index_hash(object_index, instance);
+    while (object_index->slots[slot].instance != OBJECT_INDEX_EMPTY) {
+        if (object_index->slots[slot].instance == instance) {
+            if (index) {
+                *index = object_index->slots[slot].index;
+            }
+            return true;
+        }
+        slot = (slot + 1) & object_index->mask;
+    }
+
+    return false;
+}
+
+#ifdef TEST
+#include <assert.h>
+#include "ctest.h"
+
+static uint32_t Test_Instances[] = { 0 };
+
+static uint32_t testIndexToInstance(
+    unsigned index)
+{
+    return Test_Instances[index];
+}
+
+void testObjectIndexRemove(
+    Test * pTest)
+{
+    OBJECT_INDEX object_index = { 0 };
+    unsigned index = 0;
+    bool status = false;
+
+    /* 16 slots, dense from instance 0: the hash is instance & 15 */
+    status = object_index_build(&object_index, 8, 1, testIndexToInstance);
+    ct_test(pTest, status);
+    ct_test(pTest, object_index.dense);
+    ct_test(pTest, object_index.mask == 15);
+    /* 31 and 47 collide with 15 and wrap around to slot 1 and 2,
+       1 is pushed from its home slot to slot 3 */
+    ct_test(pTest, object_index_add(&object_index, 15, 1));
+    ct_test(pTest, object_index_add(&object_index, 31, 2));
+    ct_test(pTest, object_index_add(&object_index, 47, 3));
+    ct_test(pTest, object_index_add(&object_index, 1, 4));
+    ct_test(pTest, !object_index_add(&object_index, 31, 5));
+    ct_test(pTest, object_index.slots[1].instance == 31);
+    ct_test(pTest, object_index.slots[2].instance == 47);
+    ct_test(pTest, object_index.slots[3].instance == 1);
+    ct_test(pTest, object_index.count == 5);
+
+    /* every entry behind the hole moves up, 0 stays in its home slot */
+    ct_test(pTest, object_index_remove(&object_index, 15));
+    ct_test(pTest, !object_index_remove(&object_index, 15));
+    ct_test(pTest, object_index.count == 4);
+    ct_test(pTest, object_index.slots[0].instance == 0);
+    ct_test(pTest, object_index.slots[15].instance == 31);
+    ct_test(pTest, object_index.slots[1].instance == 47);
+    ct_test(pTest, object_index.slots[2].instance == 1);
+    ct_test(pTest, object_index.slots[3].instance == OBJECT_INDEX_EMPTY);
+    ct_test(pTest, !object_index_find(&object_index, 15, &index));
+    ct_test(pTest, object_index_find(&object_index, 0, &index));
+    ct_test(pTest, index == 0);
+    ct_test(pTest, object_index_find(&object_index, 31, &index));
+    ct_test(pTest, index == 2);
+    ct_test(pTest, object_index_find(&object_index, 47, &index));
+    ct_test(pTest, index == 3);
+    ct_test(pTest, object_index_find(&object_index, 1, &index));
+    ct_test(pTest, index == 4);
+
+    /* the moved entries are still found once the chain shrinks */
+    ct_test(pTest, object_index_remove(&object_index, 31));
+    ct_test(pTest, object_index_remove(&object_index, 0));
+    ct_test(pTest, object_index_find(&object_index, 47, &index));
+    ct_test(pTest, index == 3);
+    ct_test(pTest, object_index_find(&object_index, 1, &index));
+    ct_test(pTest, index == 4);
+    ct_test(pTest, object_index.count == 2);
+
+    object_index_clear(&object_index);
+    ct_test(pTest, !object_index_find(&object_index, 1, &index));
+}
+
+#ifdef TEST_OBJINDEX
+int main(
+    void)
+{
+    Test *pTest;
+    bool rc;
+
+    pTest = ct_create("BACnet Object Index", NULL);
+    /* individual tests */
+    rc = ct_addTestFunction(pTest, testObjectIndexRemove);
+    assert(rc);
+
+    ct_setStream(pTest, stdout);
+    ct_run(pTest);
+    (void) ct_report(pTest);
+    ct_destroy(pTest);
+
+    return 0;
+}
+#endif /* TEST_OBJINDEX */
+#endif /* TEST */
@@ -0,0 +1,183 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "objjournal.h"
+
+/** @file objjournal.c  Journal of the object list and name changes */
+
+/** Empty a journal.
+ * @param journal [in] The journal to initialize.
+ * @param revision [in] The current Database_Revision.
+ */
+void object_journal_init(
+    OBJECT_JOURNAL * journal,
+    uint32_t revision)
+{
+    if (journal) {
+        journal->first = 0;
+        journal->count = 0;
+        journal->base = revision;
+    }
+}
+
+/** Record a change, the oldest entry is dropped if the journal is full.
+ * @param journal [in] The journal.
+ * @param revision [in] The Database_Revision after the change.
+ * @param change [in] What happened to the object.
+ * @param object_type [in] The object type.
+ * @param object_instance [in] The object instance.
+ */
+void object_journal_add(
+    OBJECT_JOURNAL * journal,
+    uint32_t revision,
+    OBJECT_CHANGE change,
+    int object_type,
+    uint32_t object_instance)
+{
+    OBJECT_JOURNAL_ENTRY *entry = NULL;
+
+    if (!journal) {
+        return;
+    }
+    if (journal->count == MAX_OBJECT_JOURNAL_ENTRIES) {
+        journal->base = journal->entries[journal->first].revision;
+        journal->first = (journal->first + 1) % MAX_OBJECT_JOURNAL_ENTRIES;
+        journal->count--;
+    }
+    entry =
+        &journal->entries[(journal->first +
+            journal->count) % MAX_OBJECT_JOURNAL_ENTRIES];
+    entry->revision = revision;
+    entry->instance = object_instance;
+    entry->type = (uint16_t) object_type;
+    entry->change = (uint8_t) change;
+    journal->count++;
+}
+
+unsigned object_journal_count(
+    const OBJECT_JOURNAL * journal)
+{
+    return journal ? journal->count : 0;
+}
+
+uint32_t object_journal_base(
+    const OBJECT_JOURNAL * journal)
+{
+    return journal ? journal->base : 0;
+}
+
+/** Get an entry of the journal.
+ * @param journal [in] The journal.
+ * @param index [in] 0 for the oldest entry, up to count - 1.
+ * @param entry [out] The entry.
+ * @return true if there is an entry at the index.
+ */
+bool object_journal_entry(
+    const OBJECT_JOURNAL * journal,
+    unsigned index,
+    OBJECT_JOURNAL_ENTRY * entry)
+{
+    if (!journal || !entry || (index >= journal->count)) {
+        return false;
+    }
+    *entry =
+        journal->entries[(journal->first + index) %
+        MAX_OBJECT_JOURNAL_ENTRIES];
+
+    return true;
+}
+
+#ifdef TEST
+#include <assert.h>
+#include "bacenum.h"
+#include "ctest.h"
+
+void testObjectJournalWrap(
+    Test * pTest)
+{
+    OBJECT_JOURNAL journal;
+    OBJECT_JOURNAL_ENTRY entry;
+    unsigned i = 0;
+
+    object_journal_init(&journal, 10);
+    ct_test(pTest, object_journal_count(&journal) == 0);
+    ct_test(pTest, object_journal_base(&journal) == 10);
+    ct_test(pTest, !object_journal_entry(&journal, 0, &entry));
+
+    /* fill the ring, the base stays at the initial revision */
+    for (i = 1; i <= MAX_OBJECT_JOURNAL_ENTRIES; i++) {
+        object_journal_add(&journal, 10 + i, OBJECT_CHANGE_ADDED,
+            OBJECT_ANALOG_VALUE, i);
+    }
+    ct_test(pTest, object_journal_count(&journal) ==
+        MAX_OBJECT_JOURNAL_ENTRIES);
+    ct_test(pTest, object_journal_base(&journal) == 10);
+
+    /* three more drop the three oldest, the base moves to the
+       revision of the last dropped entry */
+    for (i = 1; i <= 3; i++) {
+        object_journal_add(&journal, 10 + MAX_OBJECT_JOURNAL_ENTRIES + i,
+            OBJECT_CHANGE_REMOVED, OBJECT_BINARY_VALUE, i);
+    }
+    ct_test(pTest, object_journal_count(&journal) ==
+        MAX_OBJECT_JOURNAL_ENTRIES);
+    ct_test(pTest, object_journal_base(&journal) == 13);
+    for (i = 0; i < MAX_OBJECT_JOURNAL_ENTRIES; i++) {
+        ct_test(pTest, object_journal_entry(&journal, i, &entry));
+        ct_test(pTest, entry.revision == (14 + i));
+    }
+    ct_test(pTest, object_journal_entry(&journal,
+            MAX_OBJECT_JOURNAL_ENTRIES - 1, &entry));
+    ct_test(pTest, entry.change == OBJECT_CHANGE_REMOVED);
+    ct_test(pTest, entry.type == OBJECT_BINARY_VALUE);
+    ct_test(pTest, entry.instance == 3);
+    ct_test(pTest, !object_journal_entry(&journal,
+            MAX_OBJECT_JOURNAL_ENTRIES, &entry));
+}
+
+#ifdef TEST_OBJJOURNAL
+int main(
+    void)
+{
+    Test *pTest;
+    bool rc;
+
+    pTest = ct_create("BACnet Object Journal", NULL);
+    /* individual tests */
+    rc = ct_addTestFunction(pTest, testObjectJournalWrap);
+    assert(rc);
+
+    ct_setStream(pTest, stdout);
+    ct_run(pTest);
+    (void) ct_report(pTest);
+    ct_destroy(pTest);
+
+    return 0;
+}
+#endif /* TEST_OBJJOURNAL */
+#endif /* TEST */
@@ -0,0 +1,236 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "config_bacnet.h"
+#include "bacdef.h"
+#include "objname.h"
+
+/** @file objname.c  Object name to object identifier lookup */
+
+/* Resolving a name used to read and compare the name of every object in
+   the device, for each Who-Has by name and each Object_Name write. The
+   index turns it into one probe and, in the common case, one compare. */
+
+/** FNV-1a hash of the octets of a name.
+ * @param name [in] The name, need not be nul terminated.
+ * @param length [in] Number of octets of the name.
+ * @return The hash of the name.
+ */
+uint32_t object_name_hash(
+    const char *name,
+    size_t length)
+{
+    uint32_t hash = 2166136261UL;
+    size_t i = 0;
+
+    for (i = 0; i < length; i++) {
+        hash ^= (uint8_t) name[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+
+/** Release the slots of an index, all lookups miss afterwards.
+ * @param name_index [in] The index to clear.
+ */
+void object_name_index_clear(
+    OBJECT_NAME_INDEX * name_index)
+{
+    if (name_index) {
+        free(name_index->slots);
+        name_index->slots = NULL;
+        name_index->mask = 0;
+        name_index->count = 0;
+        name_index->incomplete = false;
+    }
+}
+
+/** Allocate an empty index.
+ *  The table gets at least twice as many slots as the capacity, so the
+ *  probe sequences stay short.
+ * @param name_index [in] The index to initialize.
+ * @param capacity [in] The max number of names that will be added.
+ * @return true if the slots could be allocated.
+ */
+bool object_name_index_init(
+    OBJECT_NAME_INDEX * name_index,
+    unsigned capacity)
+{
+    uint32_t slots = 4;
+    unsigned i = 0;
+
+    if (!name_index) {
+        return false;
+    }
+    object_name_index_clear(name_index);
+    if (capacity > UINT16_MAX) {
+        name_index->incomplete = true;
+        return false;
+    }
+    while (slots < (2 * capacity)) {
+        slots <<= 1;
+    }
+    name_index->slots =
+        (OBJECT_NAME_SLOT *) malloc(slots * sizeof(OBJECT_NAME_SLOT));
+    if (!name_index->slots) {
+        name_index->incomplete = true;
+        return false;
+    }
+    for (i = 0; i < slots; i++) {
+        name_index->slots[i].type = OBJECT_NAME_INDEX_EMPTY;
+    }
+    name_index->mask = slots - 1;
+
+    return true;
+}
+
+/** Add the name of an object to the index.
+ * @param name_index [in] The index to add to.
+ * @param hash [in] object_name_hash() of the name.
+ * @param object_type [in] The object type.
+ * @param object_instance [in] The object instance.
+ * @return true if added, false if the index is full; it is marked
+ *         incomplete then.
+ */
+bool object_name_index_add(
+    OBJECT_NAME_INDEX * name_index,
+    uint32_t hash,
+    int object_type,
+    uint32_t object_instance)
+{
+    uint32_t slot = 0;
+
+    if (!name_index) {
+        return false;
+    }
+    if (!name_index->slots ||
+        (name_index->count >= ((name_index->mask + 1) / 2))) {
+        name_index->incomplete = true;
+        return false;
+    }
+    slot = hash & name_index->mask;
+    while (name_index->slots[slot].type != OBJECT_NAME_INDEX_EMPTY) {
+        slot = (slot + 1) & name_index->mask;
+    }
+    name_index->slots[slot].hash = hash;
+    name_index->slots[slot].type = (uint16_t) object_type;
+    name_index->slots[slot].instance = object_instance;
+    name_index->count++;
+
+    return true;
+}
+
+/** Remove the name of an object from the index.
+ *  The entries behind it in the probe sequence are moved up, so no
+ *  deleted markers are needed.
+ * @param name_index [in] The index to remove from.
+ * @param hash [in] object_name_hash() of the name it was added with.
+ * @param object_type [in] The object type.
+ * @param object_instance [in] The object instance.
+ * @return true if removed, false if the object was not indexed.
+ */
+bool object_name_index_remove(
+    OBJECT_NAME_INDEX * name_index,
+    uint32_t hash,
+    int object_type,
+    uint32_t object_instance)
+{
+    uint32_t hole = 0;
+    uint32_t slot = 0;
+    uint32_t home = 0;
+
+    if (!name_index || !name_index->slots) {
+        return false;
+    }
+    hole = hash & name_index->mask;
+    while ((name_index->slots[hole].type != (uint16_t) object_type) ||
+        (name_index->slots[hole].instance != object_instance)) {
+        if (name_index->slots[hole].type == OBJECT_NAME_INDEX_EMPTY) {
+            return false;
+        }
+        hole = (hole + 1) & name_index->mask;
+    }
+    slot = hole;
+    for (;;) {
+        slot = (slot + 1) & name_index->mask;
+        if (name_index->slots[slot].type == OBJECT_NAME_INDEX_EMPTY) {
+            break;
+        }
+        home = name_index->slots[slot].hash & name_index->mask;
+        /* move the entry into the hole unless its home slot lies
+           cyclically after the hole, up to the entry itself */
+        if (((slot - home) & name_index->mask) >=
+            ((slot - hole) & name_index->mask)) {
+            name_index->slots[hole] = name_index->slots[slot];
+            hole = slot;
+        }
+    }
+    name_index->slots[hole].type = OBJECT_NAME_INDEX_EMPTY;
+    name_index->count--;
+
+    return true;
+}
+
+/** Iterate the objects whose name has a hash.
+ * @param name_index [in] The index to search.
+ * @param hash [in] object_name_hash() of the name looked for.
+ * @param cursor [in,out] 0 on the first call, then passed back unchanged.
+ * @param object_type [out] The type of the candidate.
+ * @param object_instance [out] The instance of the candidate.
+ * @return true if there is a candidate, false when done.
+ */
+bool object_name_index_next(
+    OBJECT_NAME_INDEX * name_index,
+    uint32_t hash,
+    unsigned *cursor,
+    int *object_type,
+    uint32_t * object_instance)
+{
+    uint32_t slot = 0;
+
+    if (!name_index || !name_index->slots || !cursor) {
+        return false;
+    }
+    /* the cursor counts the slots probed so far */
+    while (*cursor <= name_index->mask) {
+        slot = (hash + *cursor) & name_index->mask;
+        (*cursor)++;
+        if (name_index->slots[slot].type == OBJECT_NAME_INDEX_EMPTY) {
+            *cursor = name_index->mask + 1;
+            break;
+        }
+        if (name_index->slots[slot].hash == hash) {
+            *object_type = name_index->slots[slot].type;
+            *object_instance = name_index->slots[slot].instance;
+            return true;
+        }
+    }
+
+    return false;
+}
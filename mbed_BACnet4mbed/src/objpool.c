@@ -0,0 +1,248 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "objpool.h"
+
+/** @file objpool.c  Fixed size pools of object descriptors */
+
+/** Initialize a pool, all blocks are free afterwards.
+ * @param pool [in] The pool to initialize.
+ * @param storage [in] blocks * block_size bytes, suitably aligned,
+ *                e.g. an array of the descriptor type.
+ * @param block_size [in] Size of one block.
+ * @param order [in] Array of blocks entries for the list of blocks.
+ * @param blocks [in] Number of blocks.
+ */
+void object_pool_init(
+    OBJECT_POOL * pool,
+    void *storage,
+    size_t block_size,
+    uint16_t * order,
+    unsigned blocks)
+{
+    unsigned i = 0;
+
+    if (!pool) {
+        return;
+    }
+    pool->storage = (uint8_t *) storage;
+    pool->block_size = block_size;
+    pool->order = order;
+    pool->blocks = (uint16_t) blocks;
+    pool->used = 0;
+    for (i = 0; i < blocks; i++) {
+        pool->order[i] = (uint16_t) i;
+    }
+}
+
+/** Take a free block, it becomes the last used one.
+ * @param pool [in] The pool to allocate from.
+ * @return The zero filled block, or NULL if all blocks are used.
+ */
+void *object_pool_alloc(
+    OBJECT_POOL * pool)
+{
+    uint8_t *block = NULL;
+
+    if (!pool || !pool->storage || (pool->used >= pool->blocks)) {
+        return NULL;
+    }
+    block = &pool->storage[pool->order[pool->used] * pool->block_size];
+    pool->used++;
+    memset(block, 0, pool->block_size);
+
+    return block;
+}
+
+/** Return a block to the pool.
+ *  The last used block takes over its position in the list.
+ * @param pool [in] The pool the block was allocated from.
+ * @param block [in] The block to free.
+ * @return true if freed, false if the block is not a used block of the pool.
+ */
+bool object_pool_free(
+    OBJECT_POOL * pool,
+    void *block)
+{
+    unsigned position = 0;
+    uint16_t number = 0;
+
+    position = object_pool_position(pool, block);
+    if (position >= object_pool_count(pool)) {
+        return false;
+    }
+    pool->used--;
+    number = pool->order[position];
+    pool->order[position] = pool->order[pool->used];
+    pool->order[pool->used] = number;
+
+    return true;
+}
+
+/** Check whether a block lies in the storage of a pool.
+ * @param pool [in] The pool.
+ * @param block [in] The block, e.g. a descriptor.
+ * @return true if the block is part of the pool, used or not.
+ */
+bool object_pool_owns(
+    OBJECT_POOL * pool,
+    const void *block)
+{
+    const uint8_t *address = (const uint8_t *) block;
+
+    if (!pool || !pool->storage || !address) {
+        return false;
+    }
+
+    return (address >= pool->storage) &&
+        (address < &pool->storage[pool->blocks * pool->block_size]) &&
+        (((size_t) (address - pool->storage) % pool->block_size) == 0);
+}
+
+/** Position of a used block in the list of used blocks.
+ * @param pool [in] The pool.
+ * @param block [in] The block.
+ * @return The position, or object_pool_count() if the block is not used.
+ */
+unsigned object_pool_position(
+    OBJECT_POOL * pool,
+    const void *block)
+{
+    uint16_t number = 0;
+    unsigned i = 0;
+
+    if (!object_pool_owns(pool, block)) {
+        return object_pool_count(pool);
+    }
+    number =
+        (uint16_t) (((const uint8_t *) block -
+            pool->storage) / pool->block_size);
+    for (i = 0; i < pool->used; i++) {
+        if (pool->order[i] == number) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/** The used block at a position of the list.
+ * @param pool [in] The pool.
+ * @param position [in] 0 to object_pool_count()-1.
+ * @return The block, or NULL if the position is not used.
+ */
+void *object_pool_at(
+    OBJECT_POOL * pool,
+    unsigned position)
+{
+    if (!pool || (position >= pool->used)) {
+        return NULL;
+    }
+
+    return &pool->storage[pool->order[position] * pool->block_size];
+}
+
+/** Number of used blocks.
+ * @param pool [in] The pool.
+ * @return The number of used blocks.
+ */
+unsigned object_pool_count(
+    OBJECT_POOL * pool)
+{
+    if (!pool) {
+        return 0;
+    }
+
+    return pool->used;
+}
+
+#ifdef TEST
+#include <assert.h>
+#include "ctest.h"
+
+void testObjectPool(
+    Test * pTest)
+{
+    OBJECT_POOL pool;
+    uint32_t storage[4];
+    uint16_t order[4];
+    void *block[4];
+    unsigned i = 0;
+
+    object_pool_init(&pool, storage, sizeof(storage[0]), order, 4);
+    ct_test(pTest, object_pool_count(&pool) == 0);
+    for (i = 0; i < 4; i++) {
+        block[i] = object_pool_alloc(&pool);
+        ct_test(pTest, block[i] == &storage[i]);
+        ct_test(pTest, object_pool_position(&pool, block[i]) == i);
+    }
+    ct_test(pTest, object_pool_alloc(&pool) == NULL);
+
+    /* the last used block takes over the position of the freed one,
+       no block is moved */
+    ct_test(pTest, object_pool_free(&pool, block[1]));
+    ct_test(pTest, !object_pool_free(&pool, block[1]));
+    ct_test(pTest, object_pool_count(&pool) == 3);
+    ct_test(pTest, object_pool_at(&pool, 0) == block[0]);
+    ct_test(pTest, object_pool_at(&pool, 1) == block[3]);
+    ct_test(pTest, object_pool_at(&pool, 2) == block[2]);
+    ct_test(pTest, object_pool_at(&pool, 3) == NULL);
+    ct_test(pTest, object_pool_position(&pool, block[3]) == 1);
+    ct_test(pTest, object_pool_position(&pool, block[1]) == 3);
+    ct_test(pTest, object_pool_owns(&pool, block[1]));
+    ct_test(pTest, !object_pool_owns(&pool, (uint8_t *) block[1] + 1));
+    ct_test(pTest, !object_pool_owns(&pool, &storage[4]));
+
+    /* the freed block is handed out again, at the end of the list */
+    storage[1] = 0xFFFFFFFFUL;
+    ct_test(pTest, object_pool_alloc(&pool) == block[1]);
+    ct_test(pTest, storage[1] == 0);
+    ct_test(pTest, object_pool_position(&pool, block[1]) == 3);
+}
+
+#ifdef TEST_OBJPOOL
+int main(
+    void)
+{
+    Test *pTest;
+    bool rc;
+
+    pTest = ct_create("BACnet Object Pool", NULL);
+    /* individual tests */
+    rc = ct_addTestFunction(pTest, testObjectPool);
+    assert(rc);
+
+    ct_setStream(pTest, stdout);
+    ct_run(pTest);
+    (void) ct_report(pTest);
+    ct_destroy(pTest);
+
+    return 0;
+}
+#endif /* TEST_OBJPOOL */
+#endif /* TEST */
@@ -0,0 +1,306 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "objstate.h"
+#include "mbed_critical.h"
+
+/** @file objstate.c  Runtime state of objects, stored by column */
+
+#define OBJECT_STATE_WORDS(count) (((count) + 31) / 32)
+
+static bool object_state_bit(
+    const uint32_t * bits,
+    unsigned position)
+{
+    return (bits[position / 32] & (1UL << (position % 32))) != 0;
+}
+
+/* the flags of 32 objects share a word, and are set from the
+   application thread as well as from the BACnet task */
+static void object_state_bit_set(
+    uint32_t * bits,
+    unsigned position,
+    bool value)
+{
+    core_util_critical_section_enter();
+    if (value) {
+        bits[position / 32] |= (1UL << (position % 32));
+    } else {
+        bits[position / 32] &= ~(1UL << (position % 32));
+    }
+    core_util_critical_section_exit();
+}
+
+/** Release the columns of a state store.
+ * @param state [in] The store to clear.
+ */
+void object_state_clear(
+    OBJECT_STATE * state)
+{
+    if (state) {
+        free(state->Present_Value);
+        state->Present_Value = NULL;
+        state->Prior_Value = NULL;
+        state->Changed = NULL;
+        state->Out_Of_Service = NULL;
+        state->capacity = 0;
+    }
+}
+
+/** Allocate the columns of a state store, all values zero.
+ *  The columns share one allocation.
+ * @param state [in] The store to initialize.
+ * @param capacity [in] The max number of objects of the type.
+ * @return true if the columns could be allocated.
+ */
+bool object_state_init(
+    OBJECT_STATE * state,
+    unsigned capacity)
+{
+    unsigned words = OBJECT_STATE_WORDS(capacity);
+    uint8_t *block = NULL;
+
+    if (!state) {
+        return false;
+    }
+    object_state_clear(state);
+    if (!capacity) {
+        return true;
+    }
+    block = (uint8_t *) calloc(1,
+        (2 * capacity * sizeof(float)) + (2 * words * sizeof(uint32_t)));
+    if (!block) {
+        return false;
+    }
+    state->Present_Value = (float *) block;
+    state->Prior_Value = &state->Present_Value[capacity];
+    state->Changed = (uint32_t *) & state->Prior_Value[capacity];
+    state->Out_Of_Service = &state->Changed[words];
+    state->capacity = capacity;
+
+    return true;
+}
+
+/** Set the state of an object to zero, e.g. for a new object.
+ * @param state [in] The store.
+ * @param position [in] The position of the object.
+ */
+void object_state_reset(
+    OBJECT_STATE * state,
+    unsigned position)
+{
+    if (state && (position < state->capacity)) {
+        state->Present_Value[position] = 0.0f;
+        state->Prior_Value[position] = 0.0f;
+        object_state_bit_set(state->Changed, position, false);
+        object_state_bit_set(state->Out_Of_Service, position, false);
+    }
+}
+
+/** Copy the state of an object to another position, for an object
+ *  that takes over the position of a deleted one.
+ * @param state [in] The store.
+ * @param from [in] The old position of the object.
+ * @param to [in] The new position of the object.
+ */
+void object_state_move(
+    OBJECT_STATE * state,
+    unsigned from,
+    unsigned to)
+{
+    if (state && (from < state->capacity) && (to < state->capacity)) {
+        state->Present_Value[to] = state->Present_Value[from];
+        state->Prior_Value[to] = state->Prior_Value[from];
+        object_state_bit_set(state->Changed, to,
+            object_state_bit(state->Changed, from));
+        object_state_bit_set(state->Out_Of_Service, to,
+            object_state_bit(state->Out_Of_Service, from));
+    }
+}
+
+void object_state_changed_set(
+    OBJECT_STATE * state,
+    unsigned position,
+    bool value)
+{
+    if (state && (position < state->capacity)) {
+        object_state_bit_set(state->Changed, position, value);
+    }
+}
+
+void object_state_out_of_service_set(
+    OBJECT_STATE * state,
+    unsigned position,
+    bool value)
+{
+    if (state && (position < state->capacity)) {
+        object_state_bit_set(state->Out_Of_Service, position, value);
+    }
+}
+
+#ifdef TEST
+#include <assert.h>
+#include "ctest.h"
+
+void testObjectState(
+    Test * pTest)
+{
+    OBJECT_STATE state = { 0 };
+    unsigned i = 0;
+
+    /* 40 objects take two words per bit column */
+    ct_test(pTest, object_state_init(&state, 40));
+    ct_test(pTest, state.capacity == 40);
+    for (i = 0; i < 40; i++) {
+        ct_test(pTest, !object_state_changed(&state, i));
+        ct_test(pTest, !object_state_out_of_service(&state, i));
+    }
+    object_state_changed_set(&state, 33, true);
+    object_state_out_of_service_set(&state, 31, true);
+    ct_test(pTest, state.Changed[0] == 0);
+    ct_test(pTest, state.Changed[1] == (1UL << 1));
+    ct_test(pTest, state.Out_Of_Service[0] == (1UL << 31));
+    ct_test(pTest, state.Out_Of_Service[1] == 0);
+    ct_test(pTest, object_state_changed(&state, 33));
+    ct_test(pTest, !object_state_changed(&state, 32));
+    ct_test(pTest, !object_state_changed(&state, 40));
+    object_state_changed_set(&state, 40, true);
+    ct_test(pTest, state.Changed[1] == (1UL << 1));
+
+    /* the object at 33 takes over position 2 */
+    state.Present_Value[33] = 21.5f;
+    object_state_move(&state, 33, 2);
+    ct_test(pTest, state.Present_Value[2] == 21.5f);
+    ct_test(pTest, object_state_changed(&state, 2));
+    ct_test(pTest, !object_state_out_of_service(&state, 2));
+    object_state_reset(&state, 33);
+    ct_test(pTest, !object_state_changed(&state, 33));
+    ct_test(pTest, state.Present_Value[33] == 0.0f);
+    ct_test(pTest, object_state_out_of_service(&state, 31));
+
+    object_state_clear(&state);
+    ct_test(pTest, state.capacity == 0);
+    ct_test(pTest, !object_state_changed(&state, 2));
+}
+
+#ifdef TEST_OBJSTATE
+#include <stdio.h>
+#include <time.h>
+
+/* a descriptor the way ANALOG_INPUT_DESCR was before the split: the
+   configuration with the runtime state in between */
+typedef struct object_state_bench_descr {
+    uint32_t object_instance;
+    char *object_name;
+    char *Object_Description;
+    void *read_callback;
+    void *write_callback;
+    float COV_Increment;
+    unsigned Reliability;
+    float Present_Value;
+    float Prior_Value;
+    bool Changed;
+    bool Out_Of_Service;
+} OBJECT_STATE_BENCH_DESCR;
+
+#define OBJECT_STATE_BENCH_POINTS 65536
+#define OBJECT_STATE_BENCH_SWEEPS 200
+
+/* time a COV sweep over many points, one in 97 changed, with the
+   change flags in the descriptors and in the bit column */
+static void object_state_benchmark(
+    void)
+{
+    static OBJECT_STATE_BENCH_DESCR descr[OBJECT_STATE_BENCH_POINTS];
+    OBJECT_STATE state = { 0 };
+    volatile float sum = 0.0f;
+    clock_t start = 0;
+    double descr_ns = 0.0;
+    double state_ns = 0.0;
+    unsigned sweep = 0;
+    unsigned i = 0;
+
+    if (!object_state_init(&state, OBJECT_STATE_BENCH_POINTS)) {
+        return;
+    }
+    for (i = 0; i < OBJECT_STATE_BENCH_POINTS; i += 97) {
+        descr[i].Changed = true;
+        descr[i].Present_Value = 1.0f;
+        object_state_changed_set(&state, i, true);
+        state.Present_Value[i] = 1.0f;
+    }
+    start = clock();
+    for (sweep = 0; sweep < OBJECT_STATE_BENCH_SWEEPS; sweep++) {
+        for (i = 0; i < OBJECT_STATE_BENCH_POINTS; i++) {
+            if (descr[i].Changed) {
+                sum += descr[i].Present_Value;
+            }
+        }
+    }
+    descr_ns =
+        (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC /
+        ((double) OBJECT_STATE_BENCH_SWEEPS * OBJECT_STATE_BENCH_POINTS);
+    start = clock();
+    for (sweep = 0; sweep < OBJECT_STATE_BENCH_SWEEPS; sweep++) {
+        for (i = 0; i < OBJECT_STATE_BENCH_POINTS; i++) {
+            if (object_state_changed(&state, i)) {
+                sum += state.Present_Value[i];
+            }
+        }
+    }
+    state_ns =
+        (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC /
+        ((double) OBJECT_STATE_BENCH_SWEEPS * OBJECT_STATE_BENCH_POINTS);
+    printf("COV sweep over %u points: %.2f ns per point with %u byte "
+        "descriptors, %.2f ns per point with the bit column\n",
+        OBJECT_STATE_BENCH_POINTS, descr_ns,
+        (unsigned) sizeof(OBJECT_STATE_BENCH_DESCR), state_ns);
+    object_state_clear(&state);
+}
+
+int main(
+    void)
+{
+    Test *pTest;
+    bool rc;
+
+    pTest = ct_create("BACnet Object State", NULL);
+    /* individual tests */
+    rc = ct_addTestFunction(pTest, testObjectState);
+    assert(rc);
+
+    ct_setStream(pTest, stdout);
+    ct_run(pTest);
+    (void) ct_report(pTest);
+    ct_destroy(pTest);
+    object_state_benchmark();
+
+    return 0;
+}
+#endif /* TEST_OBJSTATE */
+#endif /* TEST */
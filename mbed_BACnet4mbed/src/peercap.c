@@ -0,0 +1,386 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "config_bacnet.h"
+#include "bacdef.h"
+#include "bacenum.h"
+#include "bacaddr.h"
+#include "apdu.h"
+#include "peercap.h"
+
+/** @file peercap.c  APDU capabilities of the peers we talk to */
+
+/* The max APDU length and segmentation support of a peer are learned
+   from the header of its confirmed requests and from its I-Am, so that
+   replies and requests can be sized to what the peer accepts. */
+static BACNET_PEER_CAPABILITY Peer_Capability[MAX_PEER_CAPABILITIES];
+/* usage stamp of each entry, 0 = unused, the oldest one gets replaced */
+static uint32_t Peer_Stamp[MAX_PEER_CAPABILITIES];
+static uint32_t Peer_Stamp_Counter;
+/* the entry holds a device we wait to hear an I-Am from, no address yet */
+static bool Peer_Bind_Request[MAX_PEER_CAPABILITIES];
+
+/* marks the entry as the most recently used one */
+static void peercap_touch(
+    unsigned index)
+{
+    Peer_Stamp[index] = ++Peer_Stamp_Counter;
+}
+
+/* returns MAX_PEER_CAPABILITIES if not found */
+static unsigned peercap_find_index(
+    BACNET_ADDRESS * dest)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < MAX_PEER_CAPABILITIES; i++) {
+        if (Peer_Stamp[i] && !Peer_Bind_Request[i] &&
+            bacnet_address_same(&Peer_Capability[i].address, dest)) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/* returns MAX_PEER_CAPABILITIES if not found */
+static unsigned peercap_find_device_index(
+    uint32_t device_id)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < MAX_PEER_CAPABILITIES; i++) {
+        if (Peer_Stamp[i] && (Peer_Capability[i].device_id == device_id)) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/* replaces the least recently used entry */
+static unsigned peercap_new_index(
+    void)
+{
+    unsigned i = 0;
+    unsigned index = 0;
+
+    for (i = 1; i < MAX_PEER_CAPABILITIES; i++) {
+        if (Peer_Stamp[i] < Peer_Stamp[index]) {
+            index = i;
+        }
+    }
+    Peer_Capability[index].device_id = BACNET_MAX_INSTANCE + 1;
+    Peer_Capability[index].max_apdu = MAX_APDU;
+    Peer_Capability[index].segmentation = SEGMENTATION_NONE;
+    Peer_Capability[index].max_segments = 0;
+    Peer_Bind_Request[index] = false;
+
+    return index;
+}
+
+/* find the entry of the peer, or replace the least recently used one */
+static BACNET_PEER_CAPABILITY *peercap_add(
+    BACNET_ADDRESS * dest)
+{
+    unsigned index = 0;
+
+    index = peercap_find_index(dest);
+    if (index == MAX_PEER_CAPABILITIES) {
+        index = peercap_new_index();
+        bacnet_address_copy(&Peer_Capability[index].address, dest);
+    }
+    peercap_touch(index);
+
+    return &Peer_Capability[index];
+}
+
+/** Learn the capabilities of a peer from the header of its confirmed
+ *  request: the max APDU it accepts in the reply, and whether it accepts
+ *  a segmented reply.
+ * @param src [in] The address of the peer.
+ * @param service_data [in] The decoded header of the request.
+ */
+void peercap_update_from_request(
+    BACNET_ADDRESS * src,
+    BACNET_CONFIRMED_SERVICE_DATA * service_data)
+{
+    BACNET_PEER_CAPABILITY *peer = NULL;
+
+    if (!src || !service_data || (service_data->max_resp <= 0)) {
+        return;
+    }
+    peer = peercap_add(src);
+    peer->max_apdu = (uint16_t) service_data->max_resp;
+    if (service_data->segmented_response_accepted) {
+        if (peer->segmentation == SEGMENTATION_NONE) {
+            peer->segmentation = SEGMENTATION_RECEIVE;
+        } else if (peer->segmentation == SEGMENTATION_TRANSMIT) {
+            peer->segmentation = SEGMENTATION_BOTH;
+        }
+        peer->max_segments = (uint8_t) service_data->max_segs;
+    }
+}
+
+/** Learn the capabilities of a peer from its I-Am.
+ *  Only peers that are already known, or whose device we asked for
+ *  with peercap_bind_request(), are kept; the I-Am broadcasts of all
+ *  other devices on the network would just push them out.
+ *  A device that shows up at another address is moved there.
+ * @param device_id [in] The device instance of the peer.
+ * @param max_apdu [in] Max APDU length accepted by the peer.
+ * @param segmentation [in] BACNET_SEGMENTATION supported by the peer.
+ * @param src [in] The address of the peer.
+ */
+void peercap_update_from_i_am(
+    uint32_t device_id,
+    unsigned max_apdu,
+    int segmentation,
+    BACNET_ADDRESS * src)
+{
+    BACNET_PEER_CAPABILITY *peer = NULL;
+    unsigned index = 0;
+    unsigned address_index = 0;
+
+    if (!src || (max_apdu == 0)) {
+        return;
+    }
+    index = peercap_find_device_index(device_id);
+    address_index = peercap_find_index(src);
+    if (index == MAX_PEER_CAPABILITIES) {
+        if (address_index == MAX_PEER_CAPABILITIES) {
+            return;
+        }
+        index = address_index;
+    } else if ((address_index != MAX_PEER_CAPABILITIES) &&
+        (address_index != index)) {
+        /* the address was learned from a request before the I-Am */
+        Peer_Stamp[address_index] = 0;
+    }
+    peer = &Peer_Capability[index];
+    bacnet_address_copy(&peer->address, src);
+    Peer_Bind_Request[index] = false;
+    peer->device_id = device_id;
+    peer->max_apdu = (max_apdu > UINT16_MAX) ? UINT16_MAX : (uint16_t) max_apdu;
+    peer->segmentation = (uint8_t) segmentation;
+}
+
+/** Get the capabilities of a peer by its device instance, or remember
+ *  that we wait for an I-Am of the device if it is not known yet.
+ *  The caller sends the Who-Is.
+ * @param device_id [in] The device instance of the peer.
+ * @param capability [out] The capabilities, if known.
+ * @return True if the device is bound to an address.
+ */
+bool peercap_bind_request(
+    uint32_t device_id,
+    BACNET_PEER_CAPABILITY * capability)
+{
+    unsigned index = 0;
+
+    if (device_id > BACNET_MAX_INSTANCE) {
+        return false;
+    }
+    index = peercap_find_device_index(device_id);
+    if (index == MAX_PEER_CAPABILITIES) {
+        index = peercap_new_index();
+        Peer_Capability[index].device_id = device_id;
+        Peer_Bind_Request[index] = true;
+    }
+    peercap_touch(index);
+    if (Peer_Bind_Request[index]) {
+        return false;
+    }
+    if (capability) {
+        *capability = Peer_Capability[index];
+    }
+
+    return true;
+}
+
+/** Get the capabilities of a peer.
+ * @param dest [in] The address of the peer.
+ * @param capability [out] The capabilities, if known.
+ * @return True if the peer is known.
+ */
+bool peercap_get(
+    BACNET_ADDRESS * dest,
+    BACNET_PEER_CAPABILITY * capability)
+{
+    unsigned index = 0;
+
+    if (!dest) {
+        return false;
+    }
+    index = peercap_find_index(dest);
+    if (index == MAX_PEER_CAPABILITIES) {
+        return false;
+    }
+    peercap_touch(index);
+    if (capability) {
+        *capability = Peer_Capability[index];
+    }
+
+    return true;
+}
+
+/** Get the capabilities of a peer by its device instance.
+ * @param device_id [in] The device instance of the peer.
+ * @param capability [out] The capabilities, if known.
+ * @return True if the device has announced itself with an I-Am.
+ */
+bool peercap_get_by_device(
+    uint32_t device_id,
+    BACNET_PEER_CAPABILITY * capability)
+{
+    unsigned index = 0;
+
+    index = peercap_find_device_index(device_id);
+    if ((index == MAX_PEER_CAPABILITIES) || Peer_Bind_Request[index]) {
+        return false;
+    }
+    peercap_touch(index);
+    if (capability) {
+        *capability = Peer_Capability[index];
+    }
+
+    return true;
+}
+
+/** Get the max APDU length to encode for a peer.
+ * @param dest [in] The address of the peer.
+ * @return The max APDU the peer accepts, limited to our MAX_APDU.
+ *         MAX_APDU for peers we know nothing about.
+ */
+uint16_t peercap_max_apdu(
+    BACNET_ADDRESS * dest)
+{
+    unsigned index = 0;
+    uint16_t max_apdu = MAX_APDU;
+
+    if (dest) {
+        index = peercap_find_index(dest);
+        if (index < MAX_PEER_CAPABILITIES) {
+            peercap_touch(index);
+            if (Peer_Capability[index].max_apdu < max_apdu) {
+                max_apdu = Peer_Capability[index].max_apdu;
+            }
+        }
+    }
+
+    return max_apdu;
+}
+
+#ifdef TEST
+#include <assert.h>
+#include <string.h>
+#include "ctest.h"
+
+static void testPeerAddress(
+    BACNET_ADDRESS * address,
+    uint8_t mac)
+{
+    memset(address, 0, sizeof(BACNET_ADDRESS));
+    address->mac_len = 1;
+    address->mac[0] = mac;
+}
+
+void testPeerCapability(
+    Test * pTest)
+{
+    BACNET_CONFIRMED_SERVICE_DATA service_data;
+    BACNET_PEER_CAPABILITY capability;
+    BACNET_ADDRESS address;
+    unsigned i = 0;
+
+    memset(&service_data, 0, sizeof(service_data));
+    service_data.max_resp = 206;
+
+    /* an I-Am nobody asked for is not kept */
+    testPeerAddress(&address, 1);
+    peercap_update_from_i_am(100, 480, SEGMENTATION_NONE, &address);
+    ct_test(pTest, !peercap_get(&address, NULL));
+    ct_test(pTest, !peercap_bind_request(100, &capability));
+    peercap_update_from_i_am(100, 480, SEGMENTATION_NONE, &address);
+    ct_test(pTest, peercap_bind_request(100, &capability));
+    ct_test(pTest, capability.address.mac[0] == 1);
+    ct_test(pTest, capability.max_apdu == 480);
+
+    /* the device moves to the address of its latest I-Am */
+    testPeerAddress(&address, 2);
+    peercap_update_from_i_am(100, 1476, SEGMENTATION_BOTH, &address);
+    ct_test(pTest, peercap_get_by_device(100, &capability));
+    ct_test(pTest, capability.address.mac[0] == 2);
+    ct_test(pTest, capability.max_apdu == 1476);
+    testPeerAddress(&address, 1);
+    ct_test(pTest, !peercap_get(&address, NULL));
+
+    /* a peer of a request that announces itself later gets its id */
+    testPeerAddress(&address, 3);
+    peercap_update_from_request(&address, &service_data);
+    ct_test(pTest, peercap_max_apdu(&address) == 206);
+    peercap_update_from_i_am(200, 480, SEGMENTATION_NONE, &address);
+    ct_test(pTest, peercap_get_by_device(200, &capability));
+    ct_test(pTest, capability.max_apdu == 480);
+
+    /* a device that is looked up keeps its entry while other peers
+       push out the least recently used ones */
+    for (i = 0; i < (2 * MAX_PEER_CAPABILITIES); i++) {
+        testPeerAddress(&address, (uint8_t) (10 + i));
+        peercap_update_from_request(&address, &service_data);
+        ct_test(pTest, peercap_get_by_device(100, NULL));
+    }
+    ct_test(pTest, peercap_get_by_device(100, NULL));
+    ct_test(pTest, !peercap_get_by_device(200, NULL));
+    testPeerAddress(&address, 10);
+    ct_test(pTest, !peercap_get(&address, NULL));
+    testPeerAddress(&address,
+        (uint8_t) (10 + (2 * MAX_PEER_CAPABILITIES) - 1));
+    ct_test(pTest, peercap_get(&address, NULL));
+}
+
+#ifdef TEST_PEERCAP
+int main(
+    void)
+{
+    Test *pTest;
+    bool rc;
+
+    pTest = ct_create("BACnet Peer Capabilities", NULL);
+    /* individual tests */
+    rc = ct_addTestFunction(pTest, testPeerCapability);
+    assert(rc);
+
+    ct_setStream(pTest, stdout);
+    ct_run(pTest);
+    (void) ct_report(pTest);
+    ct_destroy(pTest);
+
+    return 0;
+}
+#endif /* TEST_PEERCAP */
+#endif /* TEST */
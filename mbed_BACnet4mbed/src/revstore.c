@@ -0,0 +1,100 @@
+/**************************************************************************
+*
+* Copyright (C) 2026 BACnet4MbedOS contributors
+*
+* Permission is hereby granted, free of charge, to any person obtaining
+* a copy of this software and associated documentation files (the
+* "Software"), to deal in the Software without restriction, including
+* without limitation the rights to use, copy, modify, merge, publish,
+* distribute, sublicense, and/or sell copies of the Software, and to
+* permit persons to whom the Software is furnished to do so, subject to
+* the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+*********************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "revstore.h"
+#if defined(KVSTORE_ENABLED) && KVSTORE_ENABLED
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+#else
+#include <stdio.h>
+#endif
+
+/** @file revstore.c  Non volatile record of the Database_Revision */
+
+#if defined(KVSTORE_ENABLED) && KVSTORE_ENABLED
+
+/** Replace the stored revision.
+ * @param revision [in] The revision.
+ * @return true if the revision is stored.
+ */
+bool revision_store_save(
+    uint32_t revision)
+{
+    return kv_set(REVISION_STORE_KEY, &revision, sizeof(revision),
+        0) == MBED_SUCCESS;
+}
+
+/** Read the stored revision.
+ * @param revision [out] The revision.
+ * @return true if a revision was stored.
+ */
+bool revision_store_load(
+    uint32_t * revision)
+{
+    size_t actual_size = 0;
+
+    if (kv_get(REVISION_STORE_KEY, revision, sizeof(*revision),
+            &actual_size) != MBED_SUCCESS) {
+        return false;
+    }
+
+    return actual_size == sizeof(*revision);
+}
+
+#else
+
+bool revision_store_save(
+    uint32_t revision)
+{
+    FILE *file = NULL;
+    bool status = false;
+
+    file = fopen(REVISION_STORE_FILE, "wb");
+    if (file) {
+        status = (fwrite(&revision, sizeof(revision), 1, file) == 1);
+        status = (fclose(file) == 0) && status;
+    }
+
+    return status;
+}
+
+bool revision_store_load(
+    uint32_t * revision)
+{
+    FILE *file = NULL;
+    bool status = false;
+
+    file = fopen(REVISION_STORE_FILE, "rb");
+    if (file) {
+        status = (fread(revision, sizeof(*revision), 1, file) == 1);
+        fclose(file);
+    }
+
+    return status;
+}
+
+#endif
@@ -64,6 +64,268 @@ static BACNET_TSM_DATA TSM_List[MAX_TSM_TRANSACTIONS];
 /* invoke ID for incrementing between subsequent calls. */
 static uint8_t Current_Invoke_ID = 1;
 
+/* round trip time estimates of the peers, see tsm_peer_find() */
+static BACNET_TSM_PEER_DATA TSM_Peer_List[MAX_TSM_PEERS];
+/* usage stamp of each peer, the oldest one gets replaced */
+static uint32_t TSM_Peer_Stamp[MAX_TSM_PEERS];
+static uint32_t TSM_Peer_Stamp_Counter;
+
+/** Find the round trip time entry of a peer, optionally creating it.
+ *  When the table is full the least recently used peer is replaced.
+ * @param dest [in] The address of the peer.
+ * @param create [in] Add the peer if it is not found.
+ * @return The peer entry, or NULL if not found and not created.
+ */
+static BACNET_TSM_PEER_DATA *tsm_peer_find(
+    BACNET_ADDRESS * dest,
+    bool create)
+{
+    unsigned i = 0;
+    unsigned oldest = 0;
+
+    if (!dest) {
+        return NULL;
+    }
+    for (i = 0; i < MAX_TSM_PEERS; i++) {
+        if (TSM_Peer_Stamp[i] &&
+            bacnet_address_same(&TSM_Peer_List[i].address, dest)) {
+            TSM_Peer_Stamp[i] = ++TSM_Peer_Stamp_Counter;
+            return &TSM_Peer_List[i];
+        }
+        if (TSM_Peer_Stamp[i] < TSM_Peer_Stamp[oldest]) {
+            oldest = i;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    bacnet_address_copy(&TSM_Peer_List[oldest].address, dest);
+    TSM_Peer_List[oldest].srtt = 0;
+    TSM_Peer_List[oldest].rttvar = 0;
+    TSM_Peer_List[oldest].rto = apdu_timeout();
+    TSM_Peer_List[oldest].samples = 0;
+    TSM_Peer_List[oldest].timeouts = 0;
+    TSM_Peer_List[oldest].failures = 0;
+    TSM_Peer_List[oldest].window = TSM_PEER_WINDOW;
+    TSM_Peer_List[oldest].window_max = TSM_PEER_WINDOW;
+    TSM_Peer_Stamp[oldest] = ++TSM_Peer_Stamp_Counter;
+
+    return &TSM_Peer_List[oldest];
+}
+
+/* feed a measured round trip time into the estimator of the peer */
+static void tsm_peer_rtt_sample(
+    BACNET_TSM_PEER_DATA * peer,
+    uint16_t rtt)
+{
+    uint32_t delta = 0;
+    uint32_t rto = 0;
+
+    if (peer->samples == 0) {
+        peer->srtt = rtt;
+        peer->rttvar = rtt / 2;
+    } else {
+        delta = (peer->srtt > rtt) ? peer->srtt - rtt : rtt - peer->srtt;
+        /* RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R| */
+        peer->rttvar = (uint16_t) ((3UL * peer->rttvar + delta) / 4);
+        /* SRTT = 7/8 SRTT + 1/8 R */
+        peer->srtt = (uint16_t) ((7UL * peer->srtt + rtt) / 8);
+    }
+    if (peer->samples < UINT16_MAX) {
+        peer->samples++;
+    }
+    rto = peer->srtt + 4UL * peer->rttvar;
+    if (rto < TSM_RTO_MIN) {
+        rto = TSM_RTO_MIN;
+    } else if (rto > TSM_RTO_MAX) {
+        rto = TSM_RTO_MAX;
+    }
+    peer->rto = (uint16_t) rto;
+    peer->failures = 0;
+}
+
+/* the peer is congested - halve the number of requests in flight */
+static void tsm_peer_window_shrink(
+    BACNET_TSM_PEER_DATA * peer)
+{
+    peer->window /= 2;
+    if (peer->window == 0) {
+        peer->window = 1;
+    }
+}
+
+/* a request was acknowledged - allow one more request in flight */
+static void tsm_peer_window_grow(
+    BACNET_TSM_PEER_DATA * peer)
+{
+    if (peer->window < peer->window_max) {
+        peer->window++;
+    }
+}
+
+/* the time the fixed APDU timeout gives a transaction, in milliseconds */
+static uint32_t tsm_transaction_limit(
+    void)
+{
+    return (uint32_t) apdu_timeout() * (apdu_retries() + 1UL);
+}
+
+/* double the timeout of the transaction (Karn's backoff), returns 0
+   if the transaction has used up its time */
+static uint16_t tsm_backoff(
+    BACNET_TSM_DATA * transaction,
+    BACNET_TSM_PEER_DATA * peer)
+{
+    uint32_t timeout = 2UL * transaction->RequestTimeout;
+    uint32_t limit = tsm_transaction_limit();
+
+    if (timeout > TSM_RTO_MAX) {
+        timeout = TSM_RTO_MAX;
+    }
+    if (transaction->ElapsedTime >= limit) {
+        timeout = 0;
+    } else if (timeout > (limit - transaction->ElapsedTime)) {
+        timeout = limit - transaction->ElapsedTime;
+    }
+    transaction->RequestTimeout = (uint16_t) timeout;
+    if (peer->timeouts < UINT16_MAX) {
+        peer->timeouts++;
+    }
+
+    return transaction->RequestTimeout;
+}
+
+/** Get the retransmission timeout to use for a peer.
+ * @param dest [in] The address of the peer.
+ * @return The timeout in milliseconds, apdu_timeout() for unknown peers.
+ */
+uint16_t tsm_peer_timeout(
+    BACNET_ADDRESS * dest)
+{
+    BACNET_TSM_PEER_DATA *peer = tsm_peer_find(dest, false);
+
+    if (peer) {
+        return peer->rto;
+    }
+
+    return apdu_timeout();
+}
+
+/** Get the number of retries to use for a peer.
+ *  Each consecutive transaction that failed to confirm costs one retry,
+ *  so that a dead device does not hold up the TSM for long.
+ * @param dest [in] The address of the peer.
+ * @return The number of retries, apdu_retries() for unknown peers.
+ */
+uint8_t tsm_peer_retries(
+    BACNET_ADDRESS * dest)
+{
+    BACNET_TSM_PEER_DATA *peer = tsm_peer_find(dest, false);
+    uint8_t retries = apdu_retries();
+
+    if (peer) {
+        if (peer->failures < retries) {
+            retries -= peer->failures;
+        } else {
+            retries = 0;
+        }
+    }
+
+    return retries;
+}
+
+/** Check if another confirmed request may be sent to a peer, so that
+ *  requests to one device can be pipelined without flooding it.
+ * @param dest [in] The address of the peer.
+ * @return True if fewer requests than the window of the peer are in flight.
+ */
+bool tsm_window_available(
+    BACNET_ADDRESS * dest)
+{
+    BACNET_TSM_PEER_DATA *peer = tsm_peer_find(dest, false);
+    unsigned window = TSM_PEER_WINDOW;
+    unsigned count = 0;
+    unsigned i = 0;
+
+    if (!dest) {
+        return false;
+    }
+    if (peer) {
+        window = peer->window;
+    }
+    for (i = 0; i < MAX_TSM_TRANSACTIONS; i++) {
+        if (TSM_List[i].InvokeID &&
+            (TSM_List[i].state == TSM_STATE_AWAIT_CONFIRMATION) &&
+            bacnet_address_same(&TSM_List[i].dest, dest)) {
+            count++;
+        }
+    }
+
+    return (count < window);
+}
+
+/** Configure the number of confirmed requests in flight to a peer.
+ * @param dest [in] The address of the peer.
+ * @param window [in] 1..255 requests, TSM_PEER_WINDOW by default.
+ */
+void tsm_peer_window_set(
+    BACNET_ADDRESS * dest,
+    uint8_t window)
+{
+    BACNET_TSM_PEER_DATA *peer = tsm_peer_find(dest, true);
+
+    if (peer && window) {
+        peer->window_max = window;
+        if (peer->window > window) {
+            peer->window = window;
+        }
+    }
+}
+
+/** Get the number of peers with a round trip time estimate.
+ * @return The number of valid entries in the peer table.
+ */
+unsigned tsm_peer_count(
+    void)
+{
+    unsigned i = 0;
+    unsigned count = 0;
+
+    for (i = 0; i < MAX_TSM_PEERS; i++) {
+        if (TSM_Peer_Stamp[i]) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/** Get a copy of the round trip time estimate of a peer.
+ * @param index [in] 0..tsm_peer_count()-1
+ * @param peer [out] The peer data.
+ * @return True if the index was valid.
+ */
+bool tsm_peer_data(
+    unsigned index,
+    BACNET_TSM_PEER_DATA * peer)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < MAX_TSM_PEERS; i++) {
+        if (TSM_Peer_Stamp[i]) {
+            if (index == 0) {
+                if (peer) {
+                    *peer = TSM_Peer_List[i];
+                }
+                return true;
+            }
+            index--;
+        }
+    }
+
+    return false;
+}
+
 /* returns MAX_TSM_TRANSACTIONS if not found */
 static uint8_t tsm_find_invokeID_index(
     uint8_t invokeID)
@@ -196,6 +458,8 @@ void tsm_set_confirmed_unsegmented_transaction(
 {
     uint16_t j = 0;
     uint8_t index;
+    BACNET_TSM_PEER_DATA *peer;
+    uint32_t timeout = 0;
 
     if (invokeID) {
         index = tsm_find_invokeID_index(invokeID);
@@ -204,7 +468,14 @@ void tsm_set_confirmed_unsegmented_transaction(
             TSM_List[index].state = TSM_STATE_AWAIT_CONFIRMATION;
             TSM_List[index].RetryCount = 0;
             /* start the timer */
-            TSM_List[index].RequestTimer = apdu_timeout();
+            peer = tsm_peer_find(dest, true);
+            timeout = peer->rto;
+            if (timeout > tsm_transaction_limit()) {
+                timeout = tsm_transaction_limit();
+            }
+            TSM_List[index].RequestTimeout = (uint16_t) timeout;
+            TSM_List[index].RequestTimer = (uint16_t) timeout;
+            TSM_List[index].ElapsedTime = 0;
             /* copy the data */
             for (j = 0; j < apdu_len; j++) {
                 TSM_List[index].apdu[j] = apdu[j];
@@ -256,6 +527,8 @@ void tsm_timer_milliseconds(
     uint16_t milliseconds)
 {
     unsigned i = 0;     /* counter */
+    BACNET_TSM_PEER_DATA *peer;
+    uint16_t timeout = 0;
 
     for (i = 0; i < MAX_TSM_TRANSACTIONS; i++) {
         if (TSM_List[i].state == TSM_STATE_AWAIT_CONFIRMATION) {
@@ -263,10 +536,16 @@ void tsm_timer_milliseconds(
                 TSM_List[i].RequestTimer -= milliseconds;
             else
                 TSM_List[i].RequestTimer = 0;
+            TSM_List[i].ElapsedTime += milliseconds;
             /* AWAIT_CONFIRMATION */
             if (TSM_List[i].RequestTimer == 0) {
-                if (TSM_List[i].RetryCount < apdu_retries()) {
-                    TSM_List[i].RequestTimer = apdu_timeout();
+                peer = tsm_peer_find(&TSM_List[i].dest, true);
+                timeout = tsm_backoff(&TSM_List[i], peer);
+                tsm_peer_window_shrink(peer);
+                if (timeout &&
+                    (TSM_List[i].RetryCount <
+                        tsm_peer_retries(&TSM_List[i].dest))) {
+                    TSM_List[i].RequestTimer = timeout;
                     TSM_List[i].RetryCount++;
                     datalink_send_pdu(&TSM_List[i].dest,
                         &TSM_List[i].npdu_data, &TSM_List[i].apdu[0],
@@ -276,6 +555,9 @@ void tsm_timer_milliseconds(
                        and this indicates a failed message:
                        IDLE and a valid invoke id */
                     TSM_List[i].state = TSM_STATE_IDLE;
+                    if (peer->failures < UINT8_MAX) {
+                        peer->failures++;
+                    }
                 }
             }
         }
@@ -287,14 +569,53 @@ void tsm_free_invoke_id(
     uint8_t invokeID)
 {
     uint8_t index;
+    BACNET_TSM_PEER_DATA *peer;
 
     index = tsm_find_invokeID_index(invokeID);
     if (index < MAX_TSM_TRANSACTIONS) {
+        if (TSM_List[index].state == TSM_STATE_AWAIT_CONFIRMATION) {
+            peer = tsm_peer_find(&TSM_List[index].dest, true);
+            /* only sample requests that were not retransmitted (Karn) */
+            if (TSM_List[index].RetryCount == 0) {
+                tsm_peer_rtt_sample(peer,
+                    (TSM_List[index].ElapsedTime > UINT16_MAX) ? UINT16_MAX :
+                    (uint16_t) TSM_List[index].ElapsedTime);
+            } else {
+                peer->failures = 0;
+            }
+            tsm_peer_window_grow(peer);
+        }
         TSM_List[index].state = TSM_STATE_IDLE;
         TSM_List[index].InvokeID = 0;
     }
 }
 
+/** The peer answered busy to the request with this invoke ID.
+ *  Shrinks the window of the peer; call it before tsm_free_invoke_id().
+ *  Nothing happens unless the answer comes from the peer the request
+ *  was sent to, since the invoke ID of a request of the peer itself may
+ *  match one of ours.
+ * @param invokeID [in] The invokeID of the request.
+ * @param src [in] The address the answer came from.
+ */
+void tsm_invoke_id_busy(
+    uint8_t invokeID,
+    BACNET_ADDRESS * src)
+{
+    uint8_t index;
+    BACNET_TSM_PEER_DATA *peer;
+
+    index = tsm_find_invokeID_index(invokeID);
+    if ((index < MAX_TSM_TRANSACTIONS) && src &&
+        (TSM_List[index].state == TSM_STATE_AWAIT_CONFIRMATION) &&
+        bacnet_address_same(&TSM_List[index].dest, src)) {
+        peer = tsm_peer_find(&TSM_List[index].dest, true);
+        tsm_peer_window_shrink(peer);
+        /* done with it - tsm_free_invoke_id() must not grow the window */
+        TSM_List[index].state = TSM_STATE_IDLE;
+    }
+}
+
 /** Check if the invoke ID has been made free by the Transaction State Machine.
  * @param invokeID [in] The invokeID to be checked, normally of last message sent.
  * @return True if it is free (done with), False if still pending in the TSM.
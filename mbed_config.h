@@ -22,6 +22,7 @@
 #define __MBED_CONFIG_DATA__
 
 // Configuration parameters
+#define APDU_RESPONSE_CACHE_PDU_SIZE                                          64                                                                                               // set by library:BACnet4mbed
 #define BACAPP_BIT_STRING                                                                                                                                                      // set by library:BACnet4mbed
 #define BACAPP_BOOLEAN                                                                                                                                                         // set by library:BACnet4mbed
 #define BACAPP_CHARACTER_STRING                                                                                                                                                // set by library:BACnet4mbed
@@ -41,10 +42,28 @@
 #define BACNET_VENDOR_IDENTIFIER                                              260                                                                                              // set by library:BACnet4mbed
 #define BACNET_VENDOR_NAME                                                    "Hochschule Wismar / CEA"                                                                        // set by library:BACnet4mbed
 #define CLOCK_SOURCE                                                          USE_PLL_HSE_EXTC|USE_PLL_HSI                                                                     // set by target:NUCLEO_F746ZG
+#define COV_CLIENT_LIFETIME                                                   300                                                                                              // set by library:BACnet4mbed
+#define COV_CLIENT_POLL_INTERVAL                                              10                                                                                               // set by library:BACnet4mbed
+#define COV_CLIENT_RETRY_INTERVAL                                             10                                                                                               // set by library:BACnet4mbed
+#define COV_MIN_INTERVAL_MS                                                   1000                                                                                             // set by library:BACnet4mbed
+#define COV_SEND_BUDGET                                                       4                                                                                                // set by library:BACnet4mbed
+#define COV_STORE_INTERVAL                                                    60                                                                                               // set by library:BACnet4mbed
+#define DATABASE_REVISION_STORE_STEP                                          16                                                                                               // set by library:BACnet4mbed
 #define KVSTORE_ENABLED                                                       1                                                                                                // set by library:kvstore
 #define LPTICKER_DELAY_TICKS                                                  4                                                                                                // set by target:NUCLEO_F746ZG
+#define MAX_APDU_RESPONSE_CACHE                                               4                                                                                                // set by library:BACnet4mbed
+#define MAX_COV_ADDRESSES                                                     32                                                                                               // set by library:BACnet4mbed
+#define MAX_COV_CHANGED_OBJECTS                                               16                                                                                               // set by library:BACnet4mbed
+#define MAX_COV_CLIENT_POINTS                                                 16                                                                                               // set by library:BACnet4mbed
+#define MAX_COV_CONFIRMED_WINDOW                                              2                                                                                                // set by library:BACnet4mbed
+#define MAX_COV_RATE_LIMITS                                                   4                                                                                                // set by library:BACnet4mbed
 #define MAX_COV_SUBCRIPTIONS                                                  32                                                                                               // set by library:BACnet4mbed
-#define MAX_TSM_TRANSACTIONS                                                  0                                                                                                // set by library:BACnet4mbed
+#define MAX_CREATED_OBJECTS                                                   4                                                                                                // set by library:BACnet4mbed
+#define MAX_OBJECT_JOURNAL_ENTRIES                                            16                                                                                               // set by library:BACnet4mbed
+#define MAX_PEER_CAPABILITIES                                                 16                                                                                               // set by library:BACnet4mbed
+#define MAX_REGISTERED_OBJECT_TYPES                                           2                                                                                                // set by library:BACnet4mbed
+#define MAX_TSM_PEERS                                                         8                                                                                                // set by library:BACnet4mbed
+#define MAX_TSM_TRANSACTIONS                                                  4                                                                                                // set by library:BACnet4mbed
 #define MBED_CONF_ATMEL_RF_ASSUME_SPACED_SPI                                  1                                                                                                // set by library:atmel-rf[STM]
 #define MBED_CONF_ATMEL_RF_FULL_SPI_SPEED                                     7500000                                                                                          // set by library:atmel-rf
 #define MBED_CONF_ATMEL_RF_FULL_SPI_SPEED_BYTE_SPACING                        250                                                                                              // set by library:atmel-rf
@@ -248,6 +267,9 @@
 #define NVSTORE_ENABLED                                                       1                                                                                                // set by library:nvstore
 #define NVSTORE_MAX_KEYS                                                      16                                                                                               // set by library:nvstore
 #define STM32_D11_SPI_ETHERNET_PIN                                            PA_7                                                                                             // set by target:NUCLEO_F746ZG
+#define TSM_PEER_WINDOW                                                       2                                                                                                // set by library:BACnet4mbed
+#define TSM_RTO_MAX                                                           6000                                                                                             // set by library:BACnet4mbed
+#define TSM_RTO_MIN                                                           250                                                                                              // set by library:BACnet4mbed
 // Macros
 #define LENGTH(a)                                                             (sizeof(a)/sizeof(a[0]))                                                                         // defined by application
 #define MBEDTLS_CIPHER_MODE_CTR                                                                                                                                                // defined by library:SecureStore